@@ -42,13 +42,19 @@ GRANT ROLE UTILS_ASSERT_ADMIN TO ROLE UTILS_ADMIN WITH ADMIN OPTION!
 -------------------------------------------------------------------------------
 
 CREATE VARIABLE ASSERT_FAILED_STATE CHAR(5) CONSTANT '90001'!
+CREATE VARIABLE BENCHMARK_ITERATIONS_STATE CHAR(5) CONSTANT '90018'!
 
 GRANT READ ON VARIABLE ASSERT_FAILED_STATE TO ROLE UTILS_ASSERT_USER!
+GRANT READ ON VARIABLE BENCHMARK_ITERATIONS_STATE TO ROLE UTILS_ASSERT_USER!
 GRANT ALL ON VARIABLE ASSERT_FAILED_STATE TO ROLE UTILS_ASSERT_ADMIN WITH GRANT OPTION!
+GRANT ALL ON VARIABLE BENCHMARK_ITERATIONS_STATE TO ROLE UTILS_ASSERT_ADMIN WITH GRANT OPTION!
 
 COMMENT ON VARIABLE ASSERT_FAILED_STATE
     IS 'The SQLSTATE raised by all ASSERT_* procedures and functions in the case the assertion fails'!
 
+COMMENT ON VARIABLE BENCHMARK_ITERATIONS_STATE
+    IS 'The SQLSTATE raised when BENCHMARK is called with ITERATIONS which is not a positive integer'!
+
 -- SIGNAL_STATE(STATE, MESSAGE)
 -------------------------------------------------------------------------------
 -- SIGNAL seems to be quite broken in DB2. It can't be called from a trigger
@@ -692,4 +698,280 @@ COMMENT ON SPECIFIC FUNCTION ASSERT_NOT_EQUALS4
 COMMENT ON SPECIFIC FUNCTION ASSERT_NOT_EQUALS5
     IS 'Signals ASSERT_FAILED_STATE if A equals B'!
 
+-- BENCHMARK_RESULTS
+-------------------------------------------------------------------------------
+-- The BENCHMARK_RESULTS table records the outcome of each call to BENCHMARK.
+-- NAME identifies the benchmark (so that the results of different runs, e.g.
+-- against different releases, can be compared), STARTED is when the benchmark
+-- began, and SQL is (the start of) the statement executed. ITERATIONS is the
+-- number of times it was executed, and ROW_COUNT the number of rows it
+-- returned or affected on the last iteration. ELAPSED is the total time taken
+-- in seconds, and MIN_ELAPSED and MAX_ELAPSED the times of the fastest and
+-- slowest iterations. CPU_TIME (in microseconds) and ROWS_READ are taken from
+-- MON_GET_CONNECTION, and are NULL if it is not available to the caller.
+-------------------------------------------------------------------------------
+
+CREATE TABLE BENCHMARK_RESULTS (
+    NAME        VARCHAR(128) NOT NULL,
+    STARTED     TIMESTAMP NOT NULL,
+    SQL         VARCHAR(4000) NOT NULL,
+    ITERATIONS  INTEGER NOT NULL,
+    ROW_COUNT   BIGINT DEFAULT NULL,
+    ELAPSED     DECIMAL(18, 6) NOT NULL,
+    MIN_ELAPSED DECIMAL(18, 6) NOT NULL,
+    MAX_ELAPSED DECIMAL(18, 6) NOT NULL,
+    CPU_TIME    BIGINT DEFAULT NULL,
+    ROWS_READ   BIGINT DEFAULT NULL
+)!
+
+CREATE UNIQUE INDEX BENCHMARK_RESULTS_PK
+    ON BENCHMARK_RESULTS (NAME, STARTED)!
+
+ALTER TABLE BENCHMARK_RESULTS
+    ADD CONSTRAINT PK PRIMARY KEY (NAME, STARTED)
+    ADD CONSTRAINT ITERATIONS_CK CHECK (ITERATIONS > 0)!
+
+GRANT CONTROL ON TABLE BENCHMARK_RESULTS TO ROLE UTILS_ASSERT_ADMIN WITH GRANT OPTION!
+GRANT SELECT ON TABLE BENCHMARK_RESULTS TO ROLE UTILS_ASSERT_USER!
+
+COMMENT ON TABLE BENCHMARK_RESULTS
+    IS 'Timings, row counts and CPU usage recorded by the BENCHMARK procedure'!
+
+-- X_BENCHMARK_QUERY(SQL)
+-- X_BENCHMARK_ELAPSED(START, FINISH)
+-------------------------------------------------------------------------------
+-- These functions are effectively private utility subroutines for the
+-- procedures defined below. EXECUTE IMMEDIATE cannot execute queries, so
+-- X_BENCHMARK_QUERY returns a query counting the rows of SQL if SQL is a
+-- SELECT, VALUES or WITH statement, or NULL otherwise. X_BENCHMARK_ELAPSED returns
+-- the number of seconds between START and FINISH (SECONDS can't be used here
+-- as the date and time module depends on this one).
+-------------------------------------------------------------------------------
+
+CREATE FUNCTION X_BENCHMARK_QUERY(SQL CLOB(2M))
+    RETURNS CLOB(2M)
+    SPECIFIC X_BENCHMARK_QUERY
+    LANGUAGE SQL
+    CONTAINS SQL
+    DETERMINISTIC
+    NO EXTERNAL ACTION
+BEGIN ATOMIC
+    DECLARE WORDS CLOB(2M);
+    DECLARE I INTEGER;
+    DECLARE DEPTH INTEGER;
+    DECLARE QUOTE VARCHAR(1);
+    DECLARE CH VARCHAR(1);
+    -- Tabs, newlines and carriage returns are treated as spaces so that the
+    -- statement's first keyword is found however it is laid out
+    SET WORDS = UPPER(TRANSLATE(SQL, '   ', X'090A0D'));
+    IF LEFT(LTRIM(WORDS), 6) IN ('SELECT', 'VALUES') THEN
+        RETURN 'SELECT COUNT(*) FROM (' || SQL || ') AS Q';
+    END IF;
+    -- Common table expressions can't appear in a nested table expression, so
+    -- the count is wrapped around the final fullselect instead; this is the
+    -- first SELECT or VALUES outside of any brackets or quotes
+    IF LEFT(LTRIM(WORDS), 5) = 'WITH ' THEN
+        SET I = 1;
+        SET DEPTH = 0;
+        SET QUOTE = '';
+        WHILE I <= LENGTH(WORDS) DO
+            SET CH = SUBSTR(WORDS, I, 1);
+            IF QUOTE <> '' THEN
+                IF CH = QUOTE THEN
+                    SET QUOTE = '';
+                END IF;
+            ELSEIF CH IN ('''', '"') THEN
+                SET QUOTE = CH;
+            ELSEIF CH = '(' THEN
+                SET DEPTH = DEPTH + 1;
+            ELSEIF CH = ')' THEN
+                SET DEPTH = DEPTH - 1;
+            ELSEIF DEPTH = 0
+                AND SUBSTR(WORDS, I, 6) IN ('SELECT', 'VALUES')
+                AND SUBSTR(' ' || WORDS, I, 1) IN (' ', ')')
+                AND SUBSTR(WORDS || ' ', I + 6, 1) IN (' ', '(', '*') THEN
+                RETURN LEFT(SQL, I - 1) || 'SELECT COUNT(*) FROM (' || SUBSTR(SQL, I) || ') AS Q';
+            END IF;
+            SET I = I + 1;
+        END WHILE;
+    END IF;
+    RETURN NULL;
+END!
+
+CREATE FUNCTION X_BENCHMARK_ELAPSED(START TIMESTAMP, FINISH TIMESTAMP)
+    RETURNS DECIMAL(18, 6)
+    SPECIFIC X_BENCHMARK_ELAPSED
+    LANGUAGE SQL
+    CONTAINS SQL
+    DETERMINISTIC
+    NO EXTERNAL ACTION
+RETURN
+    (DAYS(FINISH) - DAYS(START)) * 86400
+    + (MIDNIGHT_SECONDS(FINISH) - MIDNIGHT_SECONDS(START))
+    + (MICROSECOND(FINISH) - MICROSECOND(START)) / 1000000.0!
+
+-- ASSERT_RUNS_WITHIN(SQL, MAX_MS)
+-------------------------------------------------------------------------------
+-- Raises the ASSERT_FAILED_STATE if executing SQL takes longer than MAX_MS
+-- milliseconds. SQL may be any statement which can be executed by EXECUTE
+-- IMMEDIATE, or a SELECT, VALUES or WITH statement in which case all rows of
+-- the result are counted (note that the optimizer may then skip evaluation of
+-- expressions which don't affect the number of rows; place such expressions
+-- in the WHERE clause when timing them). Any error raised by SQL is raised
+-- as usual.
+-------------------------------------------------------------------------------
+
+CREATE PROCEDURE ASSERT_RUNS_WITHIN(SQL CLOB(2M), MAX_MS INTEGER)
+    SPECIFIC ASSERT_RUNS_WITHIN1
+    LANGUAGE SQL
+    MODIFIES SQL DATA
+    NOT DETERMINISTIC
+    NO EXTERNAL ACTION
+BEGIN
+    DECLARE QUERY CLOB(2M) DEFAULT NULL;
+    DECLARE N BIGINT DEFAULT 0;
+    DECLARE START TIMESTAMP DEFAULT NULL;
+    DECLARE TAKEN BIGINT DEFAULT 0;
+    DECLARE S STATEMENT;
+    DECLARE C CURSOR FOR S;
+
+    SET QUERY = X_BENCHMARK_QUERY(SQL);
+    IF QUERY IS NOT NULL THEN
+        PREPARE S FROM QUERY;
+    END IF;
+    SET START = CURRENT TIMESTAMP;
+    IF QUERY IS NOT NULL THEN
+        OPEN C;
+        FETCH C INTO N;
+        CLOSE C;
+    ELSE
+        EXECUTE IMMEDIATE SQL;
+    END IF;
+    SET TAKEN = BIGINT(X_BENCHMARK_ELAPSED(START, CURRENT TIMESTAMP) * 1000);
+    IF TAKEN > MAX_MS THEN
+        CALL SIGNAL_STATE(ASSERT_FAILED_STATE,
+            SUBSTR(SQL, 1, 20)
+                || CASE WHEN LENGTH(SQL) > 20 THEN '...' ELSE '' END
+                || ' took ' || VARCHAR(TAKEN) || 'ms, over ' || VARCHAR(MAX_MS) || 'ms');
+    END IF;
+END!
+
+GRANT EXECUTE ON SPECIFIC PROCEDURE ASSERT_RUNS_WITHIN1 TO ROLE UTILS_ASSERT_USER!
+GRANT EXECUTE ON SPECIFIC PROCEDURE ASSERT_RUNS_WITHIN1 TO ROLE UTILS_ASSERT_ADMIN WITH GRANT OPTION!
+
+COMMENT ON SPECIFIC PROCEDURE ASSERT_RUNS_WITHIN1
+    IS 'Signals ASSERT_FAILED_STATE if the execution of SQL takes longer than MAX_MS milliseconds'!
+
+-- BENCHMARK(ANAME, SQL, ITERATIONS)
+-- BENCHMARK(SQL, ITERATIONS)
+-------------------------------------------------------------------------------
+-- The BENCHMARK procedure executes SQL ITERATIONS times, and records the
+-- time taken, the number of rows returned or affected, and (where available)
+-- the CPU time consumed and rows read in BENCHMARK_RESULTS under ANAME (which
+-- defaults to the start of SQL). SQL is executed as for ASSERT_RUNS_WITHIN.
+-- The statement is prepared once, before timing begins. Note that DML is not
+-- rolled back between iterations, and that CPU_TIME and ROWS_READ are only as
+-- accurate as the connection metrics maintained by DB2.
+-------------------------------------------------------------------------------
+
+CREATE PROCEDURE BENCHMARK(ANAME VARCHAR(128), SQL CLOB(2M), ITERATIONS INTEGER)
+    SPECIFIC BENCHMARK1
+    LANGUAGE SQL
+    MODIFIES SQL DATA
+    NOT DETERMINISTIC
+    NO EXTERNAL ACTION
+BEGIN
+    DECLARE QUERY CLOB(2M) DEFAULT NULL;
+    DECLARE I INTEGER DEFAULT 0;
+    DECLARE N BIGINT DEFAULT 0;
+    DECLARE STARTED TIMESTAMP DEFAULT NULL;
+    DECLARE START TIMESTAMP DEFAULT NULL;
+    DECLARE TAKEN DECIMAL(18, 6) DEFAULT 0;
+    DECLARE TOTAL DECIMAL(18, 6) DEFAULT 0;
+    DECLARE FASTEST DECIMAL(18, 6) DEFAULT NULL;
+    DECLARE SLOWEST DECIMAL(18, 6) DEFAULT NULL;
+    DECLARE CPU_BEFORE BIGINT DEFAULT NULL;
+    DECLARE CPU_AFTER BIGINT DEFAULT NULL;
+    DECLARE READ_BEFORE BIGINT DEFAULT NULL;
+    DECLARE READ_AFTER BIGINT DEFAULT NULL;
+    DECLARE S STATEMENT;
+    DECLARE C CURSOR FOR S;
+    DECLARE MON_STMT STATEMENT;
+    DECLARE MON_CUR CURSOR FOR MON_STMT;
+
+    IF ITERATIONS IS NULL OR ITERATIONS < 1 THEN
+        CALL SIGNAL_STATE(BENCHMARK_ITERATIONS_STATE, 'ITERATIONS must be a positive integer');
+    END IF;
+
+    SET QUERY = X_BENCHMARK_QUERY(SQL);
+    IF QUERY IS NOT NULL THEN
+        PREPARE S FROM QUERY;
+    ELSE
+        PREPARE S FROM SQL;
+    END IF;
+    -- The monitor functions require privileges the caller may not hold, in
+    -- which case CPU_TIME and ROWS_READ are left NULL
+    BEGIN
+        DECLARE EXIT HANDLER FOR SQLEXCEPTION
+            SET CPU_BEFORE = NULL;
+        PREPARE MON_STMT FROM
+            'SELECT SUM(TOTAL_CPU_TIME), SUM(ROWS_READ) '
+            || 'FROM TABLE(MON_GET_CONNECTION(MON_GET_APPLICATION_HANDLE(), -2)) AS M';
+        OPEN MON_CUR;
+        FETCH MON_CUR INTO CPU_BEFORE, READ_BEFORE;
+        CLOSE MON_CUR;
+    END;
+
+    SET STARTED = CURRENT TIMESTAMP;
+    WHILE I < ITERATIONS DO
+        SET START = CURRENT TIMESTAMP;
+        IF QUERY IS NOT NULL THEN
+            OPEN C;
+            FETCH C INTO N;
+            CLOSE C;
+        ELSE
+            EXECUTE S;
+            GET DIAGNOSTICS N = ROW_COUNT;
+        END IF;
+        SET TAKEN = X_BENCHMARK_ELAPSED(START, CURRENT TIMESTAMP);
+        SET TOTAL = TOTAL + TAKEN;
+        SET FASTEST = CASE WHEN FASTEST IS NULL OR TAKEN < FASTEST THEN TAKEN ELSE FASTEST END;
+        SET SLOWEST = CASE WHEN SLOWEST IS NULL OR TAKEN > SLOWEST THEN TAKEN ELSE SLOWEST END;
+        SET I = I + 1;
+    END WHILE;
+
+    IF CPU_BEFORE IS NOT NULL THEN
+        OPEN MON_CUR;
+        FETCH MON_CUR INTO CPU_AFTER, READ_AFTER;
+        CLOSE MON_CUR;
+    END IF;
+
+    INSERT INTO BENCHMARK_RESULTS
+        (NAME, STARTED, SQL, ITERATIONS, ROW_COUNT, ELAPSED, MIN_ELAPSED, MAX_ELAPSED, CPU_TIME, ROWS_READ)
+        VALUES (
+            ANAME, STARTED, VARCHAR(SUBSTR(SQL, 1, 4000)), ITERATIONS, N, TOTAL, FASTEST, SLOWEST,
+            CPU_AFTER - CPU_BEFORE, READ_AFTER - READ_BEFORE
+        );
+END!
+
+CREATE PROCEDURE BENCHMARK(SQL CLOB(2M), ITERATIONS INTEGER)
+    SPECIFIC BENCHMARK2
+    LANGUAGE SQL
+    MODIFIES SQL DATA
+    NOT DETERMINISTIC
+    NO EXTERNAL ACTION
+BEGIN
+    CALL BENCHMARK(VARCHAR(SUBSTR(SQL, 1, 128)), SQL, ITERATIONS);
+END!
+
+GRANT EXECUTE ON SPECIFIC PROCEDURE BENCHMARK1 TO ROLE UTILS_ASSERT_USER!
+GRANT EXECUTE ON SPECIFIC PROCEDURE BENCHMARK2 TO ROLE UTILS_ASSERT_USER!
+GRANT EXECUTE ON SPECIFIC PROCEDURE BENCHMARK1 TO ROLE UTILS_ASSERT_ADMIN WITH GRANT OPTION!
+GRANT EXECUTE ON SPECIFIC PROCEDURE BENCHMARK2 TO ROLE UTILS_ASSERT_ADMIN WITH GRANT OPTION!
+
+COMMENT ON SPECIFIC PROCEDURE BENCHMARK1
+    IS 'Executes SQL ITERATIONS times, recording the time, rows and CPU it took in BENCHMARK_RESULTS'!
+COMMENT ON SPECIFIC PROCEDURE BENCHMARK2
+    IS 'Executes SQL ITERATIONS times, recording the time, rows and CPU it took in BENCHMARK_RESULTS'!
+
 -- vim: set et sw=4 sts=4:
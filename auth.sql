@@ -105,6 +105,158 @@ GRANT EXECUTE ON SPECIFIC FUNCTION AUTH_TYPE1 TO ROLE UTILS_AUTH_ADMIN WITH GRAN
 COMMENT ON SPECIFIC FUNCTION AUTH_TYPE1
     IS 'Utility routine used by other routines to determine the type of an authorization name when it isn''t explicitly given'!
 
+-- USE_AUTH_CACHE
+-------------------------------------------------------------------------------
+-- When this variable is 'Y', the AUTHS_HELD function (and hence AUTH_DIFF,
+-- COPY_AUTH, REMOVE_AUTH and MOVE_AUTH which are built upon it) reads the
+-- authorizations held by a grantee from the AUTH_CACHE table below instead of
+-- querying the system catalog. It defaults to 'N'; set it to 'Y' for the
+-- duration of a session after calling REFRESH_AUTH_CACHE.
+-------------------------------------------------------------------------------
+
+CREATE VARIABLE USE_AUTH_CACHE CHAR(1) DEFAULT 'N'!
+
+GRANT READ, WRITE ON VARIABLE USE_AUTH_CACHE TO ROLE UTILS_AUTH_USER!
+GRANT ALL ON VARIABLE USE_AUTH_CACHE TO ROLE UTILS_AUTH_ADMIN WITH GRANT OPTION!
+
+COMMENT ON VARIABLE USE_AUTH_CACHE
+    IS 'When ''Y'', AUTHS_HELD reads authorizations from AUTH_CACHE instead of the system catalog'!
+
+-- AUTH_CACHE_GRANTEES
+-- AUTH_CACHE
+-- AUTH_CACHE_ROLES
+-- EFFECTIVE_AUTHS
+-------------------------------------------------------------------------------
+-- These tables hold a persistent copy of the authorizations of every grantee
+-- in the database, maintained by the REFRESH_AUTH_CACHE procedure below.
+--
+-- AUTH_CACHE_GRANTEES has one row for each grantee which holds at least one
+-- authorization. AUTH_COUNT and SIGNATURE summarize the grantee's rows in the
+-- system catalog's authorization views (SIGNATURE is the sum of the ROW_HASH
+-- of each row), and are used by REFRESH_AUTH_CACHE to detect grantees whose
+-- authorizations have changed. STALE is used internally during a refresh, and
+-- REFRESHED is the time at which the grantee's entries were last rebuilt.
+--
+-- AUTH_CACHE contains the authorizations held directly by each grantee in the
+-- same form as the result of AUTHS_HELD, with COLUMN_AUTH and PERSONAL flags
+-- indicating whether the row would be excluded by the INCLUDE_COLUMNS or
+-- INCLUDE_PERSONAL parameters of AUTHS_HELD respectively.
+--
+-- AUTH_CACHE_ROLES is the closure of the role hierarchy: there is one row for
+-- every role held by each grantee, whether directly (a DEPTH of 1) or by way
+-- of other roles (where DEPTH is the length of the shortest chain of grants).
+--
+-- EFFECTIVE_AUTHS combines the two, listing all the authorizations held by
+-- each grantee directly (where ROLENAME is blank and DEPTH is 0) or by way of
+-- the roles they hold.
+-------------------------------------------------------------------------------
+
+CREATE TABLE AUTH_CACHE_GRANTEES (
+    GRANTEE     VARCHAR(128) NOT NULL,
+    GRANTEETYPE CHAR(1) NOT NULL,
+    AUTH_COUNT  INTEGER NOT NULL,
+    SIGNATURE   DECIMAL(31, 0) NOT NULL,
+    STALE       CHAR(1) DEFAULT 'Y' NOT NULL,
+    REFRESHED   TIMESTAMP DEFAULT NULL
+)!
+
+CREATE UNIQUE INDEX AUTH_CACHE_GRANTEES_PK
+    ON AUTH_CACHE_GRANTEES (GRANTEE, GRANTEETYPE)!
+
+ALTER TABLE AUTH_CACHE_GRANTEES
+    ADD CONSTRAINT PK PRIMARY KEY (GRANTEE, GRANTEETYPE)
+    ADD CONSTRAINT STALE_CK CHECK (STALE IN ('N', 'Y', 'R', 'D'))!
+
+CREATE TABLE AUTH_CACHE (
+    GRANTEE     VARCHAR(128) NOT NULL,
+    GRANTEETYPE CHAR(1) NOT NULL,
+    OBJECT_TYPE VARCHAR(18) NOT NULL,
+    OBJECT_ID   VARCHAR(262) NOT NULL,
+    AUTH        VARCHAR(140) NOT NULL,
+    SUFFIX      VARCHAR(20) NOT NULL,
+    LEVEL       SMALLINT NOT NULL,
+    COLUMN_AUTH CHAR(1) NOT NULL,
+    PERSONAL    CHAR(1) NOT NULL
+)!
+
+CREATE UNIQUE INDEX AUTH_CACHE_PK
+    ON AUTH_CACHE (GRANTEE, GRANTEETYPE, OBJECT_TYPE, OBJECT_ID, AUTH, SUFFIX)!
+
+CREATE INDEX AUTH_CACHE_X1
+    ON AUTH_CACHE (OBJECT_TYPE, OBJECT_ID)!
+
+ALTER TABLE AUTH_CACHE
+    ADD CONSTRAINT PK PRIMARY KEY (GRANTEE, GRANTEETYPE, OBJECT_TYPE, OBJECT_ID, AUTH, SUFFIX)
+    ADD CONSTRAINT COLUMN_AUTH_CK CHECK (COLUMN_AUTH IN ('N', 'Y'))
+    ADD CONSTRAINT PERSONAL_CK CHECK (PERSONAL IN ('N', 'Y'))!
+
+CREATE TABLE AUTH_CACHE_ROLES (
+    GRANTEE     VARCHAR(128) NOT NULL,
+    GRANTEETYPE CHAR(1) NOT NULL,
+    ROLENAME    VARCHAR(128) NOT NULL,
+    DEPTH       SMALLINT NOT NULL
+)!
+
+CREATE UNIQUE INDEX AUTH_CACHE_ROLES_PK
+    ON AUTH_CACHE_ROLES (GRANTEE, GRANTEETYPE, ROLENAME)!
+
+CREATE INDEX AUTH_CACHE_ROLES_X1
+    ON AUTH_CACHE_ROLES (ROLENAME)!
+
+ALTER TABLE AUTH_CACHE_ROLES
+    ADD CONSTRAINT PK PRIMARY KEY (GRANTEE, GRANTEETYPE, ROLENAME)!
+
+CREATE VIEW EFFECTIVE_AUTHS AS
+    SELECT
+        GRANTEE,
+        GRANTEETYPE,
+        CAST('' AS VARCHAR(128)) AS ROLENAME,
+        SMALLINT(0) AS DEPTH,
+        OBJECT_TYPE,
+        OBJECT_ID,
+        AUTH,
+        SUFFIX,
+        LEVEL,
+        COLUMN_AUTH,
+        PERSONAL
+    FROM AUTH_CACHE
+    UNION ALL
+    SELECT
+        R.GRANTEE,
+        R.GRANTEETYPE,
+        R.ROLENAME,
+        R.DEPTH,
+        C.OBJECT_TYPE,
+        C.OBJECT_ID,
+        C.AUTH,
+        C.SUFFIX,
+        C.LEVEL,
+        C.COLUMN_AUTH,
+        C.PERSONAL
+    FROM
+        AUTH_CACHE_ROLES R
+        INNER JOIN AUTH_CACHE C
+            ON C.GRANTEE = R.ROLENAME
+            AND C.GRANTEETYPE = 'R'!
+
+GRANT CONTROL ON TABLE AUTH_CACHE_GRANTEES TO ROLE UTILS_AUTH_ADMIN WITH GRANT OPTION!
+GRANT CONTROL ON TABLE AUTH_CACHE TO ROLE UTILS_AUTH_ADMIN WITH GRANT OPTION!
+GRANT CONTROL ON TABLE AUTH_CACHE_ROLES TO ROLE UTILS_AUTH_ADMIN WITH GRANT OPTION!
+GRANT CONTROL ON TABLE EFFECTIVE_AUTHS TO ROLE UTILS_AUTH_ADMIN WITH GRANT OPTION!
+GRANT SELECT ON TABLE AUTH_CACHE_GRANTEES TO ROLE UTILS_AUTH_USER!
+GRANT SELECT ON TABLE AUTH_CACHE TO ROLE UTILS_AUTH_USER!
+GRANT SELECT ON TABLE AUTH_CACHE_ROLES TO ROLE UTILS_AUTH_USER!
+GRANT SELECT ON TABLE EFFECTIVE_AUTHS TO ROLE UTILS_AUTH_USER!
+
+COMMENT ON TABLE AUTH_CACHE_GRANTEES
+    IS 'Grantees cached by REFRESH_AUTH_CACHE with a signature of their catalog authorizations'!
+COMMENT ON TABLE AUTH_CACHE
+    IS 'Authorizations held directly by each grantee, in the form returned by AUTHS_HELD'!
+COMMENT ON TABLE AUTH_CACHE_ROLES
+    IS 'Closure of the role hierarchy: every role held by each grantee, directly or indirectly'!
+COMMENT ON TABLE EFFECTIVE_AUTHS
+    IS 'All authorizations held by each grantee, directly or by way of roles held'!
+
 -- AUTHS_HELD(AUTH_NAME, AUTH_TYPE, INCLUDE_COLUMNS, INCLUDE_PERSONAL)
 -- AUTHS_HELD(AUTH_NAME, INCLUDE_COLUMNS, INCLUDE_PERSONAL)
 -- AUTHS_HELD(AUTH_NAME, INCLUDE_COLUMNS)
@@ -129,9 +281,14 @@ COMMENT ON SPECIFIC FUNCTION AUTH_TYPE1
 -- AUTH_NAME is a user, the content of the user's personal schema will be
 -- included in the result set ('Y') or not ('N'). This parameter is optional
 -- and defaults to 'N' if omitted.
+--
+-- If the USE_AUTH_CACHE variable is 'Y', the result is read from the
+-- AUTH_CACHE table (as of the last call to REFRESH_AUTH_CACHE) instead of the
+-- system catalog. X_AUTHS_HELD is effectively a private subroutine which
+-- always queries the system catalog.
 -------------------------------------------------------------------------------
 
-CREATE FUNCTION AUTHS_HELD(
+CREATE FUNCTION X_AUTHS_HELD(
     AUTH_NAME VARCHAR(128),
     AUTH_TYPE VARCHAR(1),
     INCLUDE_COLUMNS VARCHAR(1),
@@ -144,7 +301,7 @@ CREATE FUNCTION AUTHS_HELD(
         SUFFIX VARCHAR(20),
         LEVEL SMALLINT
     )
-    SPECIFIC AUTHS_HELD1
+    SPECIFIC X_AUTHS_HELD
     NOT DETERMINISTIC
     NO EXTERNAL ACTION
     READS SQL DATA
@@ -492,6 +649,47 @@ RETURN
     SELECT * FROM XSR_AUTHS       UNION
     SELECT * FROM ROUTINE_AUTHS!
 
+CREATE FUNCTION AUTHS_HELD(
+    AUTH_NAME VARCHAR(128),
+    AUTH_TYPE VARCHAR(1),
+    INCLUDE_COLUMNS VARCHAR(1),
+    INCLUDE_PERSONAL VARCHAR(1)
+)
+    RETURNS TABLE (
+        OBJECT_TYPE VARCHAR(18),
+        OBJECT_ID VARCHAR(262),
+        AUTH VARCHAR(140),
+        SUFFIX VARCHAR(20),
+        LEVEL SMALLINT
+    )
+    SPECIFIC AUTHS_HELD1
+    NOT DETERMINISTIC
+    NO EXTERNAL ACTION
+    READS SQL DATA
+    LANGUAGE SQL
+RETURN
+    SELECT
+        C.OBJECT_TYPE,
+        C.OBJECT_ID,
+        C.AUTH,
+        C.SUFFIX,
+        C.LEVEL
+    FROM AUTH_CACHE C
+    WHERE USE_AUTH_CACHE = 'Y'
+        AND C.GRANTEE = AUTH_NAME
+        AND C.GRANTEETYPE = AUTH_TYPE
+        AND (INCLUDE_COLUMNS = 'Y' OR C.COLUMN_AUTH = 'N')
+        AND (INCLUDE_PERSONAL = 'Y' OR C.PERSONAL = 'N')
+    UNION ALL
+    SELECT *
+    FROM TABLE(X_AUTHS_HELD(
+        AUTH_NAME,
+        AUTH_TYPE,
+        INCLUDE_COLUMNS,
+        INCLUDE_PERSONAL
+    )) AS T
+    WHERE USE_AUTH_CACHE <> 'Y'!
+
 CREATE FUNCTION AUTHS_HELD(
     AUTH_NAME VARCHAR(128),
     INCLUDE_COLUMNS VARCHAR(1),
@@ -1553,4 +1751,255 @@ COMMENT ON SPECIFIC PROCEDURE RESTORE_AUTHS1
 COMMENT ON SPECIFIC PROCEDURE RESTORE_AUTHS2
     IS 'Restores the authorizations of all relations in the specified schema that were previously saved with SAVE_AUTHS'!
 
+-- REFRESH_AUTH_CACHE(FULL_REFRESH)
+-- REFRESH_AUTH_CACHE()
+-------------------------------------------------------------------------------
+-- REFRESH_AUTH_CACHE brings the AUTH_CACHE_GRANTEES, AUTH_CACHE and
+-- AUTH_CACHE_ROLES tables up to date with the system catalog. Rather than
+-- rebuilding the entries of every grantee, the procedure calculates a
+-- signature of each grantee's rows in the catalog's authorization views with
+-- a single query, and rebuilds only the entries of those grantees whose
+-- signature has changed since the last refresh (and the role closure of any
+-- grantee holding a role whose authorizations have changed). Entries for
+-- grantees which no longer hold any authorizations are removed.
+--
+-- If the optional FULL_REFRESH parameter is 'Y', the cache is emptied and
+-- the entries of all grantees are rebuilt. It defaults to 'N' if omitted.
+--
+-- X_AUTH_SIGNATURES is effectively a private subroutine which returns the
+-- number of catalog authorization rows and the signature of each grantee.
+-------------------------------------------------------------------------------
+
+CREATE FUNCTION X_AUTH_SIGNATURES()
+    RETURNS TABLE (
+        GRANTEE VARCHAR(128),
+        GRANTEETYPE CHAR(1),
+        AUTH_COUNT INTEGER,
+        SIGNATURE DECIMAL(31, 0)
+    )
+    SPECIFIC X_AUTH_SIGNATURES
+    NOT DETERMINISTIC
+    NO EXTERNAL ACTION
+    READS SQL DATA
+    LANGUAGE SQL
+RETURN
+    WITH CATALOG_AUTHS(GRANTEE, GRANTEETYPE, AUTH) AS (
+        SELECT GRANTEE, GRANTEETYPE,
+            'D ' || BINDADDAUTH || CONNECTAUTH || CREATETABAUTH || DBADMAUTH ||
+            EXTERNALROUTINEAUTH || NOFENCEAUTH || IMPLSCHEMAAUTH || LOADAUTH ||
+            QUIESCECONNECTAUTH || SECURITYADMAUTH
+        FROM SYSCAT.DBAUTH UNION ALL
+        SELECT GRANTEE, GRANTEETYPE,
+            'R ' || ROLENAME || ' ' || ADMIN
+        FROM SYSCAT.ROLEAUTH UNION ALL
+        SELECT TRUSTEDID, TRUSTEDIDTYPE,
+            'S ' || SURROGATEAUTHIDTYPE || ' ' || SURROGATEAUTHID
+        FROM SYSCAT.SURROGATEAUTHIDS UNION ALL
+        SELECT GRANTEE, GRANTEETYPE,
+            'T ' || TBSPACE || ' ' || USEAUTH
+        FROM SYSCAT.TBSPACEAUTH UNION ALL
+        SELECT GRANTEE, GRANTEETYPE,
+            'W ' || WORKLOADNAME || ' ' || USAGEAUTH
+        FROM SYSCAT.WORKLOADAUTH UNION ALL
+        SELECT GRANTEE, GRANTEETYPE,
+            'L ' || CHAR(SECPOLICYID) || ' ' || CHAR(SECLABELID) || ' ' || ACCESSTYPE
+        FROM SYSCAT.SECURITYLABELACCESS UNION ALL
+        SELECT GRANTEE, GRANTEETYPE,
+            'V ' || SERVERNAME
+        FROM SYSCAT.PASSTHRUAUTH UNION ALL
+        SELECT GRANTEE, GRANTEETYPE,
+            'H ' || SCHEMANAME || ' ' || ALTERINAUTH || CREATEINAUTH || DROPINAUTH
+        FROM SYSCAT.SCHEMAAUTH UNION ALL
+        SELECT GRANTEE, GRANTEETYPE,
+            'B ' || TABSCHEMA || '.' || TABNAME || ' ' || CONTROLAUTH ||
+            ALTERAUTH || DELETEAUTH || INDEXAUTH || INSERTAUTH || REFAUTH ||
+            SELECTAUTH || UPDATEAUTH
+        FROM SYSCAT.TABAUTH UNION ALL
+        SELECT GRANTEE, GRANTEETYPE,
+            'C ' || TABSCHEMA || '.' || TABNAME || '.' || COLNAME || ' ' ||
+            PRIVTYPE || GRANTABLE
+        FROM SYSCAT.COLAUTH UNION ALL
+        SELECT GRANTEE, GRANTEETYPE,
+            'I ' || INDSCHEMA || '.' || INDNAME || ' ' || CONTROLAUTH
+        FROM SYSCAT.INDEXAUTH UNION ALL
+        SELECT GRANTEE, GRANTEETYPE,
+            'P ' || PKGSCHEMA || '.' || PKGNAME || ' ' || CONTROLAUTH ||
+            BINDAUTH || EXECUTEAUTH
+        FROM SYSCAT.PACKAGEAUTH UNION ALL
+        SELECT GRANTEE, GRANTEETYPE,
+            'A ' || VARSCHEMA || '.' || VARNAME || ' ' || READAUTH || WRITEAUTH
+        FROM SYSCAT.VARIABLEAUTH UNION ALL
+        SELECT GRANTEE, GRANTEETYPE,
+            'Q ' || SEQSCHEMA || '.' || SEQNAME || ' ' || ALTERAUTH || USAGEAUTH
+        FROM SYSCAT.SEQUENCEAUTH UNION ALL
+        SELECT GRANTEE, GRANTEETYPE,
+            'X ' || CHAR(OBJECTID) || ' ' || USAGEAUTH
+        FROM SYSCAT.XSROBJECTAUTH UNION ALL
+        SELECT GRANTEE, GRANTEETYPE,
+            'F ' || SCHEMA || '.' || COALESCE(SPECIFICNAME, '*') || ' ' ||
+            ROUTINETYPE || EXECUTEAUTH
+        FROM SYSCAT.ROUTINEAUTH
+    )
+    SELECT
+        GRANTEE,
+        GRANTEETYPE,
+        COUNT(*),
+        SUM(DECIMAL(ROW_HASH(AUTH), 19, 0))
+    FROM CATALOG_AUTHS
+    GROUP BY
+        GRANTEE,
+        GRANTEETYPE!
+
+CREATE PROCEDURE REFRESH_AUTH_CACHE(FULL_REFRESH VARCHAR(1))
+    SPECIFIC REFRESH_AUTH_CACHE1
+    MODIFIES SQL DATA
+    NOT DETERMINISTIC
+    NO EXTERNAL ACTION
+    LANGUAGE SQL
+BEGIN ATOMIC
+    IF FULL_REFRESH = 'Y' THEN
+        DELETE FROM AUTH_CACHE;
+        DELETE FROM AUTH_CACHE_ROLES;
+        DELETE FROM AUTH_CACHE_GRANTEES;
+    END IF;
+    -- Compare the signature of every grantee in the catalog with that
+    -- recorded by the last refresh. STALE is set to 'Y' for new and changed
+    -- grantees, 'N' for unchanged grantees, and remains 'D' for those which
+    -- have disappeared from the catalog
+    UPDATE AUTH_CACHE_GRANTEES SET STALE = 'D';
+    MERGE INTO AUTH_CACHE_GRANTEES G
+        USING TABLE(X_AUTH_SIGNATURES()) AS S
+        ON G.GRANTEE = S.GRANTEE
+        AND G.GRANTEETYPE = S.GRANTEETYPE
+        WHEN MATCHED AND G.AUTH_COUNT = S.AUTH_COUNT AND G.SIGNATURE = S.SIGNATURE THEN
+            UPDATE SET STALE = 'N'
+        WHEN MATCHED THEN
+            UPDATE SET
+                AUTH_COUNT = S.AUTH_COUNT,
+                SIGNATURE = S.SIGNATURE,
+                STALE = 'Y'
+        WHEN NOT MATCHED THEN
+            INSERT (GRANTEE, GRANTEETYPE, AUTH_COUNT, SIGNATURE, STALE)
+            VALUES (S.GRANTEE, S.GRANTEETYPE, S.AUTH_COUNT, S.SIGNATURE, 'Y');
+    -- The role closure of any grantee holding (directly or indirectly) a role
+    -- which has changed must be rebuilt, although their own authorizations
+    -- are unaffected; mark these with 'R'
+    UPDATE AUTH_CACHE_GRANTEES G
+        SET STALE = 'R'
+        WHERE STALE = 'N'
+        AND EXISTS (
+            SELECT 1
+            FROM
+                AUTH_CACHE_ROLES R
+                INNER JOIN AUTH_CACHE_GRANTEES C
+                    ON C.GRANTEE = R.ROLENAME
+                    AND C.GRANTEETYPE = 'R'
+            WHERE R.GRANTEE = G.GRANTEE
+                AND R.GRANTEETYPE = G.GRANTEETYPE
+                AND C.STALE IN ('Y', 'D')
+        );
+    DELETE FROM AUTH_CACHE C
+        WHERE EXISTS (
+            SELECT 1
+            FROM AUTH_CACHE_GRANTEES G
+            WHERE G.GRANTEE = C.GRANTEE
+                AND G.GRANTEETYPE = C.GRANTEETYPE
+                AND G.STALE IN ('Y', 'D')
+        );
+    DELETE FROM AUTH_CACHE_ROLES R
+        WHERE EXISTS (
+            SELECT 1
+            FROM AUTH_CACHE_GRANTEES G
+            WHERE G.GRANTEE = R.GRANTEE
+                AND G.GRANTEETYPE = R.GRANTEETYPE
+                AND G.STALE IN ('Y', 'R', 'D')
+        );
+    DELETE FROM AUTH_CACHE_GRANTEES
+        WHERE STALE = 'D';
+    INSERT INTO AUTH_CACHE (
+        GRANTEE,
+        GRANTEETYPE,
+        OBJECT_TYPE,
+        OBJECT_ID,
+        AUTH,
+        SUFFIX,
+        LEVEL,
+        COLUMN_AUTH,
+        PERSONAL
+    )
+        SELECT
+            G.GRANTEE,
+            G.GRANTEETYPE,
+            A.OBJECT_TYPE,
+            A.OBJECT_ID,
+            A.AUTH,
+            A.SUFFIX,
+            A.LEVEL,
+            CASE
+                WHEN A.OBJECT_TYPE = 'TABLE' AND LOCATE('(', A.AUTH) > 0 THEN 'Y'
+                ELSE 'N'
+            END,
+            CASE
+                WHEN G.GRANTEETYPE <> 'U' THEN 'N'
+                WHEN A.OBJECT_TYPE = 'SCHEMA'
+                    AND A.OBJECT_ID = QUOTE_IDENTIFIER(G.GRANTEE) THEN 'Y'
+                WHEN A.OBJECT_TYPE IN (
+                        'TABLE', 'INDEX', 'PACKAGE', 'VARIABLE', 'SEQUENCE',
+                        'XSROBJECT', 'FUNCTION', 'PROCEDURE',
+                        'SPECIFIC FUNCTION', 'SPECIFIC PROCEDURE')
+                    AND LOCATE(QUOTE_IDENTIFIER(G.GRANTEE) || '.', A.OBJECT_ID) = 1 THEN 'Y'
+                ELSE 'N'
+            END
+        FROM
+            AUTH_CACHE_GRANTEES G,
+            TABLE(X_AUTHS_HELD(G.GRANTEE, G.GRANTEETYPE, 'Y', 'Y')) AS A
+        WHERE G.STALE = 'Y';
+    INSERT INTO AUTH_CACHE_ROLES (GRANTEE, GRANTEETYPE, ROLENAME, DEPTH)
+        WITH CLOSURE (GRANTEE, GRANTEETYPE, ROLENAME, DEPTH) AS (
+            SELECT G.GRANTEE, G.GRANTEETYPE, A.ROLENAME, SMALLINT(1)
+            FROM
+                AUTH_CACHE_GRANTEES G
+                INNER JOIN SYSCAT.ROLEAUTH A
+                    ON A.GRANTEE = G.GRANTEE
+                    AND A.GRANTEETYPE = G.GRANTEETYPE
+            WHERE G.STALE IN ('Y', 'R')
+            UNION ALL
+            SELECT C.GRANTEE, C.GRANTEETYPE, A.ROLENAME, SMALLINT(C.DEPTH + 1)
+            FROM
+                CLOSURE C
+                INNER JOIN SYSCAT.ROLEAUTH A
+                    ON A.GRANTEE = C.ROLENAME
+                    AND A.GRANTEETYPE = 'R'
+            WHERE C.DEPTH < 100
+        )
+        SELECT GRANTEE, GRANTEETYPE, ROLENAME, MIN(DEPTH)
+        FROM CLOSURE
+        GROUP BY GRANTEE, GRANTEETYPE, ROLENAME;
+    UPDATE AUTH_CACHE_GRANTEES
+        SET
+            STALE = 'N',
+            REFRESHED = CURRENT TIMESTAMP
+        WHERE STALE IN ('Y', 'R');
+END!
+
+CREATE PROCEDURE REFRESH_AUTH_CACHE()
+    SPECIFIC REFRESH_AUTH_CACHE2
+    MODIFIES SQL DATA
+    NOT DETERMINISTIC
+    NO EXTERNAL ACTION
+    LANGUAGE SQL
+BEGIN ATOMIC
+    CALL REFRESH_AUTH_CACHE('N');
+END!
+
+GRANT EXECUTE ON SPECIFIC PROCEDURE REFRESH_AUTH_CACHE1 TO ROLE UTILS_AUTH_USER!
+GRANT EXECUTE ON SPECIFIC PROCEDURE REFRESH_AUTH_CACHE2 TO ROLE UTILS_AUTH_USER!
+GRANT EXECUTE ON SPECIFIC PROCEDURE REFRESH_AUTH_CACHE1 TO ROLE UTILS_AUTH_ADMIN WITH GRANT OPTION!
+GRANT EXECUTE ON SPECIFIC PROCEDURE REFRESH_AUTH_CACHE2 TO ROLE UTILS_AUTH_ADMIN WITH GRANT OPTION!
+
+COMMENT ON SPECIFIC PROCEDURE REFRESH_AUTH_CACHE1
+    IS 'Refreshes the authorization cache, rebuilding all entries if FULL_REFRESH is ''Y'' or only those of grantees whose authorizations have changed otherwise'!
+COMMENT ON SPECIFIC PROCEDURE REFRESH_AUTH_CACHE2
+    IS 'Refreshes the authorization cache, rebuilding only the entries of grantees whose authorizations have changed'!
+
 -- vim: set et sw=4 sts=4:
@@ -38,43 +38,150 @@ GRANT ROLE UTILS_CORRECTIONS_USER TO ROLE UTILS_USER!
 GRANT ROLE UTILS_CORRECTIONS_USER TO ROLE UTILS_CORRECTIONS_ADMIN WITH ADMIN OPTION!
 GRANT ROLE UTILS_CORRECTIONS_ADMIN TO ROLE UTILS_ADMIN WITH ADMIN OPTION!
 
--- CREATE_CORRECTION_TRIGGERS(ASCHEMA, ATABLE, BASE_COLUMN, CORRECTION_COLUMN, LOGSCHEMA, LOGTABLE)
--- CREATE_CORRECTION_TRIGGERS(ASCHEMA, ATABLE, BASE_COLUMN, CORRECTION_COLUMN)
--- CREATE_CORRECTION_TRIGGERS(ATABLE, BASE_COLUMN, CORRECTION_COLUMN)
+-- The triggers generated by this module read BYPASS_TRIGGERS (defined in the
+-- toggle_triggers module)
+GRANT READ ON VARIABLE BYPASS_TRIGGERS TO ROLE UTILS_CORRECTIONS_USER!
+
+-- CREATED_CORRECTION_TRIGGERS
 -------------------------------------------------------------------------------
--- The CREATE_CORRECTION_TRIGGERS procedure creates, for a base table specified
--- by ASCHEMA and ATABLE, a couple of update triggers for the column specified
--- by BASE_COLUMN. In the event that BASE_COLUMN is updated, and the column
--- specified by CORRECTION_COLUMN is non-NULL, a before update trigger will set
--- CORRECTION_COLUMN to NULL, and an after update trigger will log the change
--- in the LOG table specified by LOGSCHEMA and LOGTABLE. If
---
--- If ASCHEMA is not specified it defaults to the current schema.  The schema
--- of the created trigger will be ASCHEMA. The name of the triggers will be
--- <ATABLE>_RESET_<CORRECTION_COLUMN> for the before trigger and
--- <ATABLE>_RESET_<CORRECTION_COLUMN>_LOG for the after trigger.
+-- The CREATED_CORRECTION_TRIGGERS table records, for each table processed by
+-- the last call to CREATE_SCHEMA_CORRECTION_TRIGGERS, the columns for which
+-- correction triggers were created and the time taken to do so.
 -------------------------------------------------------------------------------
 
-CREATE PROCEDURE CREATE_CORRECTION_TRIGGERS(
+CREATE TABLE CREATED_CORRECTION_TRIGGERS (
+    TABSCHEMA         VARCHAR(128) NOT NULL,
+    TABNAME           VARCHAR(128) NOT NULL,
+    BASE_COLUMN       VARCHAR(128) NOT NULL,
+    CORRECTION_COLUMN VARCHAR(128) NOT NULL,
+    STARTED           TIMESTAMP NOT NULL,
+    ELAPSED           DECIMAL(18, 6) NOT NULL
+)!
+
+CREATE UNIQUE INDEX CREATED_CORRECTION_TRIGGERS_PK
+    ON CREATED_CORRECTION_TRIGGERS (TABSCHEMA, TABNAME)!
+
+ALTER TABLE CREATED_CORRECTION_TRIGGERS
+    ADD CONSTRAINT PK PRIMARY KEY (TABSCHEMA, TABNAME)!
+
+GRANT CONTROL ON TABLE CREATED_CORRECTION_TRIGGERS TO ROLE UTILS_CORRECTIONS_ADMIN WITH GRANT OPTION!
+GRANT SELECT ON TABLE CREATED_CORRECTION_TRIGGERS TO ROLE UTILS_CORRECTIONS_USER!
+
+COMMENT ON TABLE CREATED_CORRECTION_TRIGGERS
+    IS 'Per table timings of the last CREATE_SCHEMA_CORRECTION_TRIGGERS call'!
+
+-- X_CORRECTION_TABLES(ASCHEMA, ATABLE, BASE_COLUMN, CORRECTION_COLUMN)
+-- X_CREATE_CORRECTION_TRIGGERS(ASCHEMA, ATABLE, BASE_COLUMN, CORRECTION_COLUMN, KEY_EXPR, BASE_TYPESCHEMA, BASE_TYPENAME, CORRECTION_TYPESCHEMA, CORRECTION_TYPENAME)
+-- X_CREATED_CORRECTION_TRIGGERS(ASCHEMA, ATABLE, ABASE_COLUMN, ACORRECTION_COLUMN, ASTARTED)
+-------------------------------------------------------------------------------
+-- These routines are effectively private utility subroutines for the
+-- procedures defined below. X_CORRECTION_TABLES returns, for every table in
+-- ASCHEMA (or just ATABLE if it is not NULL) with a primary key and both
+-- BASE_COLUMN and CORRECTION_COLUMN, the expression used to describe a row's
+-- key in the log along with the types of the two columns. The key expressions
+-- of all tables are built in a single query with XMLAGG rather than by
+-- repeated concatenation. X_CREATE_CORRECTION_TRIGGERS (re)creates the
+-- triggers for one table from this information, and
+-- X_CREATED_CORRECTION_TRIGGERS records the timing of a table in
+-- CREATED_CORRECTION_TRIGGERS.
+-------------------------------------------------------------------------------
+
+CREATE FUNCTION X_CORRECTION_TABLES(
     ASCHEMA VARCHAR(128),
     ATABLE VARCHAR(128),
     BASE_COLUMN VARCHAR(128),
     CORRECTION_COLUMN VARCHAR(128)
 )
-    SPECIFIC CREATE_CORRECTION_TRIGGERS1
+    RETURNS TABLE (
+        TABNAME VARCHAR(128),
+        KEY_EXPR CLOB(64K),
+        BASE_TYPESCHEMA VARCHAR(128),
+        BASE_TYPENAME VARCHAR(128),
+        CORRECTION_TYPESCHEMA VARCHAR(128),
+        CORRECTION_TYPENAME VARCHAR(128)
+    )
+    SPECIFIC X_CORRECTION_TABLES
+    NOT DETERMINISTIC
+    NO EXTERNAL ACTION
+    READS SQL DATA
+    LANGUAGE SQL
+RETURN
+    WITH
+    K (TABNAME, KEY_EXPR) AS (
+        SELECT
+            TABNAME,
+            CAST(
+                REPLACE(
+                REPLACE(
+                REPLACE(
+                REPLACE(
+                REPLACE(
+                REPLACE(
+                REPLACE(
+                    XML2CLOB(XMLAGG(XMLELEMENT(NAME K,
+                        CASE KEYSEQ WHEN 1 THEN '' ELSE ' || '', '' || ' END ||
+                        VARCHAR_EXPRESSION('OLD.' || QUOTE_IDENTIFIER(COLNAME), TYPESCHEMA, TYPENAME)
+                    ) ORDER BY KEYSEQ)),
+                    '<K>', ''),
+                    '</K>', ''),
+                    '&quot;', '"'),
+                    '&apos;', ''''),
+                    '&lt;', '<'),
+                    '&gt;', '>'),
+                    '&amp;', '&')
+                AS CLOB(64K))
+        FROM SYSCAT.COLUMNS
+        WHERE TABSCHEMA = ASCHEMA
+            AND (ATABLE IS NULL OR TABNAME = ATABLE)
+            AND COALESCE(KEYSEQ, 0) > 0
+        GROUP BY TABNAME
+    ),
+    C (TABNAME, BASE_TYPESCHEMA, BASE_TYPENAME, CORRECTION_TYPESCHEMA, CORRECTION_TYPENAME) AS (
+        SELECT
+            TABNAME,
+            MAX(CASE WHEN COLNAME = BASE_COLUMN THEN TYPESCHEMA END),
+            MAX(CASE WHEN COLNAME = BASE_COLUMN THEN TYPENAME END),
+            MAX(CASE WHEN COLNAME = CORRECTION_COLUMN THEN TYPESCHEMA END),
+            MAX(CASE WHEN COLNAME = CORRECTION_COLUMN THEN TYPENAME END)
+        FROM SYSCAT.COLUMNS
+        WHERE TABSCHEMA = ASCHEMA
+            AND (ATABLE IS NULL OR TABNAME = ATABLE)
+            AND COLNAME IN (BASE_COLUMN, CORRECTION_COLUMN)
+        GROUP BY TABNAME
+        HAVING COUNT(*) = 2
+    )
+    SELECT
+        C.TABNAME,
+        K.KEY_EXPR,
+        C.BASE_TYPESCHEMA,
+        C.BASE_TYPENAME,
+        C.CORRECTION_TYPESCHEMA,
+        C.CORRECTION_TYPENAME
+    FROM
+        C
+        INNER JOIN K
+            ON C.TABNAME = K.TABNAME!
+
+CREATE PROCEDURE X_CREATE_CORRECTION_TRIGGERS(
+    ASCHEMA VARCHAR(128),
+    ATABLE VARCHAR(128),
+    BASE_COLUMN VARCHAR(128),
+    CORRECTION_COLUMN VARCHAR(128),
+    KEY_EXPR CLOB(64K),
+    BASE_TYPESCHEMA VARCHAR(128),
+    BASE_TYPENAME VARCHAR(128),
+    CORRECTION_TYPESCHEMA VARCHAR(128),
+    CORRECTION_TYPENAME VARCHAR(128)
+)
+    SPECIFIC X_CREATE_CORRECTION_TRIGGERS
     MODIFIES SQL DATA
     NOT DETERMINISTIC
     NO EXTERNAL ACTION
     LANGUAGE SQL
 BEGIN ATOMIC
     DECLARE DDL CLOB(64K) DEFAULT '';
-    DECLARE KEY_EXPR CLOB(64K) DEFAULT '';
     DECLARE BEFORE_NAME VARCHAR(128) DEFAULT '';
     DECLARE AFTER_NAME VARCHAR(128) DEFAULT '';
-    DECLARE BASE_TYPE_SCHEMA VARCHAR(128);
-    DECLARE BASE_TYPE_NAME VARCHAR(128);
-    DECLARE CORRECTION_TYPE_SCHEMA VARCHAR(128);
-    DECLARE CORRECTION_TYPE_NAME VARCHAR(128);
 
     SET BEFORE_NAME = ATABLE || '_RESET_' || CORRECTION_COLUMN;
     SET AFTER_NAME = ATABLE || '_RESET_' || CORRECTION_COLUMN || '_LOG';
@@ -98,45 +205,13 @@ BEGIN ATOMIC
         || '    REFERENCING OLD AS OLD NEW AS NEW'
         || '    FOR EACH ROW '
         || '    WHEN ('
-        || '        OLD.' || QUOTE_IDENTIFIER(BASE_COLUMN) || ' <> NEW.' || QUOTE_IDENTIFIER(BASE_COLUMN)
+        || '        ' || X_BYPASS_TRIGGERS_WHEN()
+        || '        AND OLD.' || QUOTE_IDENTIFIER(BASE_COLUMN) || ' <> NEW.' || QUOTE_IDENTIFIER(BASE_COLUMN)
         || '        AND OLD.' || QUOTE_IDENTIFIER(CORRECTION_COLUMN) || ' IS NOT NULL'
         || '    )'
         || '    SET NEW.' || QUOTE_IDENTIFIER(CORRECTION_COLUMN) || ' = NULL';
     EXECUTE IMMEDIATE DDL;
     -- Create the after trigger to log the event
-    FOR K AS
-        SELECT
-            COLNAME,
-            TYPESCHEMA,
-            TYPENAME,
-            KEYSEQ
-        FROM
-            SYSCAT.COLUMNS
-        WHERE
-            TABSCHEMA = ASCHEMA
-            AND TABNAME = ATABLE
-            AND COALESCE(KEYSEQ, 0) > 0
-        ORDER BY
-            KEYSEQ
-    DO
-        SET KEY_EXPR = KEY_EXPR ||
-            CASE KEYSEQ WHEN 1 THEN '' ELSE ' || '', '' || ' END ||
-            VARCHAR_EXPRESSION('OLD.' || QUOTE_IDENTIFIER(COLNAME), TYPESCHEMA, TYPENAME);
-    END FOR;
-    SET (BASE_TYPE_SCHEMA, BASE_TYPE_NAME) = (
-        SELECT TYPESCHEMA, TYPENAME
-        FROM SYSCAT.COLUMNS
-        WHERE TABSCHEMA = ASCHEMA
-        AND TABNAME = ATABLE
-        AND COLNAME = BASE_COLUMN
-    );
-    SET (CORRECTION_TYPE_SCHEMA, CORRECTION_TYPE_NAME) = (
-        SELECT TYPESCHEMA, TYPENAME
-        FROM SYSCAT.COLUMNS
-        WHERE TABSCHEMA = ASCHEMA
-        AND TABNAME = ATABLE
-        AND COLNAME = CORRECTION_COLUMN
-    );
     SET DDL =
         'CREATE TRIGGER ' || QUOTE_IDENTIFIER(ASCHEMA) || '.' || QUOTE_IDENTIFIER(AFTER_NAME) || ' '
         || '    AFTER UPDATE OF ' || QUOTE_IDENTIFIER(BASE_COLUMN)
@@ -144,31 +219,112 @@ BEGIN ATOMIC
         || '    REFERENCING OLD AS OLD NEW AS NEW'
         || '    FOR EACH ROW '
         || '    WHEN ('
-        || '        OLD.' || QUOTE_IDENTIFIER(BASE_COLUMN) || ' <> NEW.' || QUOTE_IDENTIFIER(BASE_COLUMN)
+        || '        ' || X_BYPASS_TRIGGERS_WHEN()
+        || '        AND OLD.' || QUOTE_IDENTIFIER(BASE_COLUMN) || ' <> NEW.' || QUOTE_IDENTIFIER(BASE_COLUMN)
         || '        AND OLD.' || QUOTE_IDENTIFIER(CORRECTION_COLUMN) || ' IS NOT NULL'
         || '    )'
-        || '    INSERT INTO ' || QUOTE_IDENTIFIER(CURRENT SCHEMA) || '.LOG ('
-        || '        SEVERITY,'
-        || '        SUBJECT_TYPE,'
-        || '        SUBJECT_SCHEMA,'
-        || '        SUBJECT_NAME,'
-        || '        TEXT'
-        || '    )'
-        || '    VALUES ('
+        || '    CALL ' || QUOTE_IDENTIFIER(X_LOG_SCHEMA()) || '.WRITE_LOG('
         || '        ''W'', /* Warning */'
         || '        ''T'', /* Table subject */'
         ||          '''' || REPLACE(ASCHEMA, '''', '''''') || ''','
         ||          '''' || REPLACE(ATABLE, '''', '''''') || ''','
         ||          '''For row with key ('' || ' || KEY_EXPR || ' || ''), '
         ||              REPLACE(BASE_COLUMN, '''', '''''') || ' has changed value from '''
-        ||              ' || ' || VARCHAR_EXPRESSION('OLD.' || QUOTE_IDENTIFIER(BASE_COLUMN), BASE_TYPE_SCHEMA, BASE_TYPE_NAME) || ' || '' to '''
-        ||              ' || ' || VARCHAR_EXPRESSION('NEW.' || QUOTE_IDENTIFIER(BASE_COLUMN), BASE_TYPE_SCHEMA, BASE_TYPE_NAME) || ' || ''; '
+        ||              ' || ' || VARCHAR_EXPRESSION('OLD.' || QUOTE_IDENTIFIER(BASE_COLUMN), BASE_TYPESCHEMA, BASE_TYPENAME) || ' || '' to '''
+        ||              ' || ' || VARCHAR_EXPRESSION('NEW.' || QUOTE_IDENTIFIER(BASE_COLUMN), BASE_TYPESCHEMA, BASE_TYPENAME) || ' || ''; '
         ||              'resetting ' || REPLACE(CORRECTION_COLUMN, '''', '''''') || ' from '''
-        ||              ' || ' || VARCHAR_EXPRESSION('OLD.' || QUOTE_IDENTIFIER(CORRECTION_COLUMN), CORRECTION_TYPE_SCHEMA, CORRECTION_TYPE_NAME) || ' || '' to NULL'''
+        ||              ' || ' || VARCHAR_EXPRESSION('OLD.' || QUOTE_IDENTIFIER(CORRECTION_COLUMN), CORRECTION_TYPESCHEMA, CORRECTION_TYPENAME) || ' || '' to NULL'''
         || '    )';
     EXECUTE IMMEDIATE DDL;
 END!
 
+CREATE PROCEDURE X_CREATED_CORRECTION_TRIGGERS(
+    ASCHEMA VARCHAR(128),
+    ATABLE VARCHAR(128),
+    ABASE_COLUMN VARCHAR(128),
+    ACORRECTION_COLUMN VARCHAR(128),
+    ASTARTED TIMESTAMP
+)
+    SPECIFIC X_CREATED_CORRECTION_TRIGGERS
+    MODIFIES SQL DATA
+    NOT DETERMINISTIC
+    NO EXTERNAL ACTION
+    LANGUAGE SQL
+BEGIN ATOMIC
+    DECLARE FINISHED TIMESTAMP;
+    SET FINISHED = CURRENT TIMESTAMP;
+    DELETE FROM CREATED_CORRECTION_TRIGGERS
+        WHERE TABSCHEMA = ASCHEMA
+        AND TABNAME = ATABLE;
+    INSERT INTO CREATED_CORRECTION_TRIGGERS
+        (TABSCHEMA, TABNAME, BASE_COLUMN, CORRECTION_COLUMN, STARTED, ELAPSED)
+        VALUES (
+            ASCHEMA,
+            ATABLE,
+            ABASE_COLUMN,
+            ACORRECTION_COLUMN,
+            ASTARTED,
+            (SECONDS(FINISHED) - SECONDS(ASTARTED))
+                + (MICROSECOND(FINISHED) - MICROSECOND(ASTARTED)) / 1000000.0
+        );
+END!
+
+-- CREATE_CORRECTION_TRIGGERS(ASCHEMA, ATABLE, BASE_COLUMN, CORRECTION_COLUMN, LOGSCHEMA, LOGTABLE)
+-- CREATE_CORRECTION_TRIGGERS(ASCHEMA, ATABLE, BASE_COLUMN, CORRECTION_COLUMN)
+-- CREATE_CORRECTION_TRIGGERS(ATABLE, BASE_COLUMN, CORRECTION_COLUMN)
+-------------------------------------------------------------------------------
+-- The CREATE_CORRECTION_TRIGGERS procedure creates, for a base table specified
+-- by ASCHEMA and ATABLE, a couple of update triggers for the column specified
+-- by BASE_COLUMN. In the event that BASE_COLUMN is updated, and the column
+-- specified by CORRECTION_COLUMN is non-NULL, a before update trigger will set
+-- CORRECTION_COLUMN to NULL, and an after update trigger will log the change
+-- in the LOG table (via WRITE_LOG, so the message is buffered if the session
+-- has set LOG_BUFFER_SIZE).
+--
+-- If ASCHEMA is not specified it defaults to the current schema.  The schema
+-- of the created trigger will be ASCHEMA. The name of the triggers will be
+-- <ATABLE>_RESET_<CORRECTION_COLUMN> for the before trigger and
+-- <ATABLE>_RESET_<CORRECTION_COLUMN>_LOG for the after trigger.
+--
+-- Neither trigger does anything in a session which has set the BYPASS_TRIGGERS
+-- variable to 'Y'.
+-------------------------------------------------------------------------------
+
+CREATE PROCEDURE CREATE_CORRECTION_TRIGGERS(
+    ASCHEMA VARCHAR(128),
+    ATABLE VARCHAR(128),
+    BASE_COLUMN VARCHAR(128),
+    CORRECTION_COLUMN VARCHAR(128)
+)
+    SPECIFIC CREATE_CORRECTION_TRIGGERS1
+    MODIFIES SQL DATA
+    NOT DETERMINISTIC
+    NO EXTERNAL ACTION
+    LANGUAGE SQL
+BEGIN ATOMIC
+    DECLARE KEY_EXPR CLOB(64K) DEFAULT '';
+    DECLARE BASE_TYPESCHEMA VARCHAR(128);
+    DECLARE BASE_TYPENAME VARCHAR(128);
+    DECLARE CORRECTION_TYPESCHEMA VARCHAR(128);
+    DECLARE CORRECTION_TYPENAME VARCHAR(128);
+
+    SET (KEY_EXPR, BASE_TYPESCHEMA, BASE_TYPENAME, CORRECTION_TYPESCHEMA, CORRECTION_TYPENAME) = (
+        SELECT KEY_EXPR, BASE_TYPESCHEMA, BASE_TYPENAME, CORRECTION_TYPESCHEMA, CORRECTION_TYPENAME
+        FROM TABLE(X_CORRECTION_TABLES(ASCHEMA, ATABLE, BASE_COLUMN, CORRECTION_COLUMN)) AS T
+    );
+    CALL X_CREATE_CORRECTION_TRIGGERS(
+        ASCHEMA,
+        ATABLE,
+        BASE_COLUMN,
+        CORRECTION_COLUMN,
+        KEY_EXPR,
+        BASE_TYPESCHEMA,
+        BASE_TYPENAME,
+        CORRECTION_TYPESCHEMA,
+        CORRECTION_TYPENAME
+    );
+END!
+
 CREATE PROCEDURE CREATE_CORRECTION_TRIGGERS(
     ATABLE VARCHAR(128),
     BASE_COLUMN VARCHAR(128),
@@ -193,4 +349,126 @@ COMMENT ON SPECIFIC PROCEDURE CREATE_CORRECTION_TRIGGERS1
 COMMENT ON SPECIFIC PROCEDURE CREATE_CORRECTION_TRIGGERS2
     IS 'Creates triggers on the specified column which will log changes and NULL out a corresponding correction column. See source for usage examples'!
 
+-- CREATE_SCHEMA_CORRECTION_TRIGGERS(ASCHEMA, BASE_COLUMN, CORRECTION_COLUMN)
+-- CREATE_SCHEMA_CORRECTION_TRIGGERS(BASE_COLUMN, CORRECTION_COLUMN)
+-------------------------------------------------------------------------------
+-- The CREATE_SCHEMA_CORRECTION_TRIGGERS procedure is equivalent to calling
+-- CREATE_CORRECTION_TRIGGERS for every table in ASCHEMA which has a primary
+-- key and both the columns specified by BASE_COLUMN and CORRECTION_COLUMN.
+-- Rather than querying the catalog for each table in turn, the keys and
+-- column types of all such tables are read in a single query, and the
+-- triggers are then created table by table. The time taken for each table is
+-- recorded in CREATED_CORRECTION_TRIGGERS (which is cleared of prior entries
+-- for the schema first). The procedure commits after every 10 tables (and at
+-- the end), so a long run neither holds catalog locks on the whole schema
+-- nor loses all its work if interrupted; it may simply be run again.
+--
+-- If ASCHEMA is not specified it defaults to the current schema.
+-------------------------------------------------------------------------------
+
+CREATE PROCEDURE CREATE_SCHEMA_CORRECTION_TRIGGERS(
+    ASCHEMA VARCHAR(128),
+    BASE_COLUMN VARCHAR(128),
+    CORRECTION_COLUMN VARCHAR(128)
+)
+    SPECIFIC CREATE_SCHEMA_CORRECTION_TRIGGERS1
+    MODIFIES SQL DATA
+    NOT DETERMINISTIC
+    NO EXTERNAL ACTION
+    LANGUAGE SQL
+BEGIN
+    DECLARE COMMIT_TABLES INTEGER DEFAULT 10;
+    DECLARE DONE_TABLES INTEGER DEFAULT 0;
+    DECLARE TABLE_STARTED TIMESTAMP DEFAULT NULL;
+    DECLARE T_TABNAME VARCHAR(128) DEFAULT NULL;
+    DECLARE T_KEY_EXPR CLOB(64K) DEFAULT NULL;
+    DECLARE T_BASE_TYPESCHEMA VARCHAR(128) DEFAULT NULL;
+    DECLARE T_BASE_TYPENAME VARCHAR(128) DEFAULT NULL;
+    DECLARE T_CORRECTION_TYPESCHEMA VARCHAR(128) DEFAULT NULL;
+    DECLARE T_CORRECTION_TYPENAME VARCHAR(128) DEFAULT NULL;
+    DECLARE TABLES_CUR CURSOR WITH HOLD FOR
+        SELECT
+            C.TABNAME,
+            C.KEY_EXPR,
+            C.BASE_TYPESCHEMA,
+            C.BASE_TYPENAME,
+            C.CORRECTION_TYPESCHEMA,
+            C.CORRECTION_TYPENAME
+        FROM
+            TABLE(X_CORRECTION_TABLES(ASCHEMA, CAST(NULL AS VARCHAR(128)), BASE_COLUMN, CORRECTION_COLUMN)) AS C
+            INNER JOIN SYSCAT.TABLES S
+                ON S.TABSCHEMA = ASCHEMA
+                AND S.TABNAME = C.TABNAME
+        WHERE
+            S.TYPE = 'T'
+        ORDER BY
+            C.TABNAME;
+
+    DELETE FROM CREATED_CORRECTION_TRIGGERS
+        WHERE TABSCHEMA = ASCHEMA;
+    COMMIT;
+    -- The cursor is held open across the commit after every COMMIT_TABLES
+    -- tables, so the catalog is only read once
+    OPEN TABLES_CUR;
+    FETCH TABLES_CUR INTO
+        T_TABNAME,
+        T_KEY_EXPR,
+        T_BASE_TYPESCHEMA,
+        T_BASE_TYPENAME,
+        T_CORRECTION_TYPESCHEMA,
+        T_CORRECTION_TYPENAME;
+    WHILE T_TABNAME IS NOT NULL DO
+        SET TABLE_STARTED = CURRENT TIMESTAMP;
+        CALL X_CREATE_CORRECTION_TRIGGERS(
+            ASCHEMA,
+            T_TABNAME,
+            BASE_COLUMN,
+            CORRECTION_COLUMN,
+            T_KEY_EXPR,
+            T_BASE_TYPESCHEMA,
+            T_BASE_TYPENAME,
+            T_CORRECTION_TYPESCHEMA,
+            T_CORRECTION_TYPENAME
+        );
+        CALL X_CREATED_CORRECTION_TRIGGERS(ASCHEMA, T_TABNAME, BASE_COLUMN, CORRECTION_COLUMN, TABLE_STARTED);
+        SET DONE_TABLES = DONE_TABLES + 1;
+        IF MOD(DONE_TABLES, COMMIT_TABLES) = 0 THEN
+            COMMIT;
+        END IF;
+        SET T_TABNAME = NULL;
+        FETCH TABLES_CUR INTO
+            T_TABNAME,
+            T_KEY_EXPR,
+            T_BASE_TYPESCHEMA,
+            T_BASE_TYPENAME,
+            T_CORRECTION_TYPESCHEMA,
+            T_CORRECTION_TYPENAME;
+    END WHILE;
+    CLOSE TABLES_CUR;
+    COMMIT;
+END!
+
+CREATE PROCEDURE CREATE_SCHEMA_CORRECTION_TRIGGERS(
+    BASE_COLUMN VARCHAR(128),
+    CORRECTION_COLUMN VARCHAR(128)
+)
+    SPECIFIC CREATE_SCHEMA_CORRECTION_TRIGGERS2
+    MODIFIES SQL DATA
+    NOT DETERMINISTIC
+    NO EXTERNAL ACTION
+    LANGUAGE SQL
+BEGIN
+    CALL CREATE_SCHEMA_CORRECTION_TRIGGERS(CURRENT SCHEMA, BASE_COLUMN, CORRECTION_COLUMN);
+END!
+
+GRANT EXECUTE ON SPECIFIC PROCEDURE CREATE_SCHEMA_CORRECTION_TRIGGERS1 TO ROLE UTILS_CORRECTIONS_USER!
+GRANT EXECUTE ON SPECIFIC PROCEDURE CREATE_SCHEMA_CORRECTION_TRIGGERS2 TO ROLE UTILS_CORRECTIONS_USER!
+GRANT EXECUTE ON SPECIFIC PROCEDURE CREATE_SCHEMA_CORRECTION_TRIGGERS1 TO ROLE UTILS_CORRECTIONS_ADMIN WITH GRANT OPTION!
+GRANT EXECUTE ON SPECIFIC PROCEDURE CREATE_SCHEMA_CORRECTION_TRIGGERS2 TO ROLE UTILS_CORRECTIONS_ADMIN WITH GRANT OPTION!
+
+COMMENT ON SPECIFIC PROCEDURE CREATE_SCHEMA_CORRECTION_TRIGGERS1
+    IS 'Creates correction triggers on every table in the specified schema which has the specified base and correction columns'!
+COMMENT ON SPECIFIC PROCEDURE CREATE_SCHEMA_CORRECTION_TRIGGERS2
+    IS 'Creates correction triggers on every table in the current schema which has the specified base and correction columns'!
+
 -- vim: set et sw=4 sts=4:
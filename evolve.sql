@@ -121,6 +121,20 @@ COMMENT ON SPECIFIC PROCEDURE RECREATE_VIEW2
 -- RECREATE_VIEWS is a utility procedure which recreates all inoperative
 -- views in the optionally specified schema. If ASCHEMA is omitted it defaults
 -- to the CURRENT SCHEMA.
+--
+-- Views are recreated in order of their dependencies (as recorded in
+-- SYSCAT.VIEWDEP) so that a view is always recreated after any inoperative
+-- views it depends upon, regardless of creation order. Views at the same
+-- level of the dependency graph are recreated in order of creation. The SET
+-- SCHEMA and SET PATH statements required by each view are only executed when
+-- the qualifier or path differs from that of the prior view.
+--
+-- Rather than computing the level of every view up front (which, as a
+-- recursive query, means enumerating every path through the dependency graph
+-- and grows exponentially with the number of dependencies), views are
+-- recreated in passes. Each pass recreates those inoperative views which
+-- depend on no other inoperative views in the schema, so the number of passes
+-- is simply the depth of the graph.
 -------------------------------------------------------------------------------
 
 CREATE PROCEDURE RECREATE_VIEWS(ASCHEMA VARCHAR(128))
@@ -132,32 +146,60 @@ CREATE PROCEDURE RECREATE_VIEWS(ASCHEMA VARCHAR(128))
 BEGIN ATOMIC
     DECLARE SAVE_PATH VARCHAR(254);
     DECLARE SAVE_SCHEMA VARCHAR(128);
+    DECLARE LAST_QUALIFIER VARCHAR(200) DEFAULT '';
+    DECLARE LAST_PATH VARCHAR(2100) DEFAULT '';
+    DECLARE RECREATED INTEGER DEFAULT 1;
     SET SAVE_PATH = CURRENT PATH;
     SET SAVE_SCHEMA = CURRENT SCHEMA;
-    FOR D AS
-        SELECT
-            'SET SCHEMA ' || QUOTE_IDENTIFIER(V.QUALIFIER) AS SET_QUALIFIER,
-            'SET PATH '   || V.FUNC_PATH                   AS SET_PATH,
-            V.TEXT                                         AS TEXT,
-            'SET SCHEMA ' || QUOTE_IDENTIFIER(SAVE_SCHEMA) AS RESTORE_QUALIFIER,
-            'SET PATH '   || SAVE_PATH                     AS RESTORE_PATH
-        FROM
-            SYSCAT.VIEWS V
-            INNER JOIN SYSCAT.TABLES T
-                ON V.VIEWSCHEMA = T.TABSCHEMA
-                AND V.VIEWNAME = T.TABNAME
-        WHERE
-            V.VIEWSCHEMA = ASCHEMA
-            AND V.VALID = 'X'
-        ORDER BY
-            T.CREATE_TIME
-    DO
-        EXECUTE IMMEDIATE D.SET_PATH;
-        EXECUTE IMMEDIATE D.SET_QUALIFIER;
-        EXECUTE IMMEDIATE D.TEXT;
-        EXECUTE IMMEDIATE D.RESTORE_QUALIFIER;
-        EXECUTE IMMEDIATE D.RESTORE_PATH;
-    END FOR;
+    WHILE RECREATED > 0 DO
+        SET RECREATED = 0;
+        FOR D AS
+            SELECT
+                'SET SCHEMA ' || QUOTE_IDENTIFIER(V.QUALIFIER) AS SET_QUALIFIER,
+                'SET PATH '   || VARCHAR(V.FUNC_PATH, 2048)    AS SET_PATH,
+                V.TEXT                                         AS TEXT
+            FROM
+                SYSCAT.VIEWS V
+                INNER JOIN SYSCAT.TABLES T
+                    ON V.VIEWSCHEMA = T.TABSCHEMA
+                    AND V.VIEWNAME = T.TABNAME
+            WHERE
+                V.VIEWSCHEMA = ASCHEMA
+                AND V.VALID = 'X'
+                AND NOT EXISTS (
+                    SELECT 1
+                    FROM
+                        SYSCAT.VIEWDEP VD
+                        INNER JOIN SYSCAT.VIEWS B
+                            ON VD.BSCHEMA = B.VIEWSCHEMA
+                            AND VD.BNAME = B.VIEWNAME
+                    WHERE
+                        VD.VIEWSCHEMA = V.VIEWSCHEMA
+                        AND VD.VIEWNAME = V.VIEWNAME
+                        AND VD.BSCHEMA = ASCHEMA
+                        AND VD.BTYPE = 'V'
+                        AND VD.BNAME <> V.VIEWNAME
+                        AND B.VALID = 'X'
+                )
+            ORDER BY
+                T.CREATE_TIME
+        DO
+            IF D.SET_PATH <> LAST_PATH THEN
+                EXECUTE IMMEDIATE D.SET_PATH;
+                SET LAST_PATH = D.SET_PATH;
+            END IF;
+            IF D.SET_QUALIFIER <> LAST_QUALIFIER THEN
+                EXECUTE IMMEDIATE D.SET_QUALIFIER;
+                SET LAST_QUALIFIER = D.SET_QUALIFIER;
+            END IF;
+            EXECUTE IMMEDIATE D.TEXT;
+            SET RECREATED = RECREATED + 1;
+        END FOR;
+    END WHILE;
+    IF LAST_QUALIFIER <> '' THEN
+        EXECUTE IMMEDIATE 'SET SCHEMA ' || QUOTE_IDENTIFIER(SAVE_SCHEMA);
+        EXECUTE IMMEDIATE 'SET PATH ' || SAVE_PATH;
+    END IF;
 END!
 
 CREATE PROCEDURE RECREATE_VIEWS()
@@ -336,6 +378,32 @@ ALTER TABLE SAVED_VIEWS
 
 GRANT CONTROL ON TABLE SAVED_VIEWS TO ROLE UTILS_EVOLVE_ADMIN WITH GRANT OPTION!
 
+-- SAVED_VIEWDEP
+-------------------------------------------------------------------------------
+-- A simple table which replicates a portion of the SYSCAT.VIEWDEP view for use
+-- by the SAVE_VIEW and RESTORE_VIEWS procedures below. Only the dependencies
+-- of views upon other views are saved; RESTORE_VIEWS uses these to restore
+-- views in order of their dependencies.
+-------------------------------------------------------------------------------
+
+CREATE TABLE SAVED_VIEWDEP AS (
+    SELECT
+        VIEWSCHEMA,
+        VIEWNAME,
+        BSCHEMA,
+        BNAME
+    FROM SYSCAT.VIEWDEP
+)
+WITH NO DATA!
+
+CREATE UNIQUE INDEX SAVED_VIEWDEP_PK
+    ON SAVED_VIEWDEP(VIEWSCHEMA, VIEWNAME, BSCHEMA, BNAME)!
+
+ALTER TABLE SAVED_VIEWDEP
+    ADD CONSTRAINT PK PRIMARY KEY (VIEWSCHEMA, VIEWNAME, BSCHEMA, BNAME)!
+
+GRANT CONTROL ON TABLE SAVED_VIEWDEP TO ROLE UTILS_EVOLVE_ADMIN WITH GRANT OPTION!
+
 -- SAVE_VIEW(ASCHEMA, AVIEW)
 -- SAVE_VIEW(AVIEW)
 -------------------------------------------------------------------------------
@@ -389,6 +457,15 @@ BEGIN ATOMIC
                 SRC.FUNC_PATH,
                 SRC.TEXT
             );
+    DELETE FROM SAVED_VIEWDEP
+        WHERE VIEWSCHEMA = ASCHEMA
+        AND VIEWNAME = AVIEW;
+    INSERT INTO SAVED_VIEWDEP (VIEWSCHEMA, VIEWNAME, BSCHEMA, BNAME)
+        SELECT DISTINCT VIEWSCHEMA, VIEWNAME, BSCHEMA, BNAME
+        FROM SYSCAT.VIEWDEP
+        WHERE VIEWSCHEMA = ASCHEMA
+        AND VIEWNAME = AVIEW
+        AND BTYPE = 'V';
 END!
 
 CREATE PROCEDURE SAVE_VIEW(AVIEW VARCHAR(128))
@@ -459,6 +536,18 @@ BEGIN ATOMIC
                 SRC.FUNC_PATH,
                 SRC.TEXT
             );
+    DELETE FROM SAVED_VIEWDEP
+        WHERE VIEWSCHEMA = ASCHEMA
+        AND VIEWNAME IN (
+            SELECT VIEWNAME
+            FROM SYSCAT.VIEWS
+            WHERE VIEWSCHEMA = ASCHEMA
+        );
+    INSERT INTO SAVED_VIEWDEP (VIEWSCHEMA, VIEWNAME, BSCHEMA, BNAME)
+        SELECT DISTINCT VIEWSCHEMA, VIEWNAME, BSCHEMA, BNAME
+        FROM SYSCAT.VIEWDEP
+        WHERE VIEWSCHEMA = ASCHEMA
+        AND BTYPE = 'V';
     -- Can't directly use SAVE_AUTHS as that'll also save table authorizations
     -- which we don't want. Instead we call SAVE_AUTH for each view definition
     -- that we save...
@@ -538,6 +627,9 @@ BEGIN ATOMIC
     DELETE FROM SAVED_VIEWS
         WHERE VIEWSCHEMA = ASCHEMA
         AND VIEWNAME = AVIEW;
+    DELETE FROM SAVED_VIEWDEP
+        WHERE VIEWSCHEMA = ASCHEMA
+        AND VIEWNAME = AVIEW;
 END!
 
 CREATE PROCEDURE RESTORE_VIEW(AVIEW VARCHAR(128))
@@ -566,6 +658,16 @@ COMMENT ON SPECIFIC PROCEDURE RESTORE_VIEW2
 -- RESTORE_VIEWS is a utility procedure which restores all the views in the
 -- optionally specified schema from the SAVED_VIEWS table above. If ASCHEMA is
 -- omitted it defaults to the CURRENT SCHEMA.
+--
+-- As with RECREATE_VIEWS, views are restored in order of their dependencies
+-- (as recorded in SAVED_VIEWDEP when the views were saved), and the SET
+-- SCHEMA and SET PATH statements required by each view are only executed when
+-- the qualifier or path differs from that of the prior view.
+--
+-- Likewise, views are restored in passes; each pass restores those saved
+-- views which depend on no other saved view that has yet to be restored. A
+-- saved view is restored if it is missing or inoperative; operative views are
+-- left alone, and their saved definitions are kept in SAVED_VIEWS.
 -------------------------------------------------------------------------------
 
 CREATE PROCEDURE RESTORE_VIEWS(ASCHEMA VARCHAR(128))
@@ -575,12 +677,96 @@ CREATE PROCEDURE RESTORE_VIEWS(ASCHEMA VARCHAR(128))
     NO EXTERNAL ACTION
     LANGUAGE SQL
 BEGIN ATOMIC
+    DECLARE SAVE_PATH VARCHAR(254);
+    DECLARE SAVE_SCHEMA VARCHAR(128);
+    DECLARE LAST_QUALIFIER VARCHAR(200) DEFAULT '';
+    DECLARE LAST_PATH VARCHAR(2100) DEFAULT '';
+    DECLARE RESTORED INTEGER DEFAULT 1;
+    DECLARE STARTED TIMESTAMP;
+    SET STARTED = CURRENT TIMESTAMP;
+    SET SAVE_PATH = CURRENT PATH;
+    SET SAVE_SCHEMA = CURRENT SCHEMA;
+    -- A saved view needs restoring until it exists in the catalogue as an
+    -- operative view; an inoperative view is replaced by CREATE VIEW
+    WHILE RESTORED > 0 DO
+        SET RESTORED = 0;
+        FOR D AS
+            SELECT
+                'SET SCHEMA ' || QUOTE_IDENTIFIER(V.QUALIFIER) AS SET_QUALIFIER,
+                'SET PATH '   || VARCHAR(V.FUNC_PATH, 2048)    AS SET_PATH,
+                V.TEXT                                         AS TEXT
+            FROM
+                SAVED_VIEWS V
+            WHERE
+                V.VIEWSCHEMA = ASCHEMA
+                AND NOT EXISTS (
+                    SELECT 1
+                    FROM SYSCAT.VIEWS W
+                    WHERE W.VIEWSCHEMA = V.VIEWSCHEMA
+                    AND W.VIEWNAME = V.VIEWNAME
+                    AND W.VALID <> 'X'
+                )
+                AND NOT EXISTS (
+                    SELECT 1
+                    FROM
+                        SAVED_VIEWDEP VD
+                        INNER JOIN SAVED_VIEWS B
+                            ON VD.BSCHEMA = B.VIEWSCHEMA
+                            AND VD.BNAME = B.VIEWNAME
+                    WHERE
+                        VD.VIEWSCHEMA = V.VIEWSCHEMA
+                        AND VD.VIEWNAME = V.VIEWNAME
+                        AND VD.BSCHEMA = ASCHEMA
+                        AND VD.BNAME <> V.VIEWNAME
+                        AND NOT EXISTS (
+                            SELECT 1
+                            FROM SYSCAT.VIEWS W
+                            WHERE W.VIEWSCHEMA = B.VIEWSCHEMA
+                            AND W.VIEWNAME = B.VIEWNAME
+                            AND W.VALID <> 'X'
+                        )
+                )
+            ORDER BY
+                V.VIEWNAME
+        DO
+            IF D.SET_PATH <> LAST_PATH THEN
+                EXECUTE IMMEDIATE D.SET_PATH;
+                SET LAST_PATH = D.SET_PATH;
+            END IF;
+            IF D.SET_QUALIFIER <> LAST_QUALIFIER THEN
+                EXECUTE IMMEDIATE D.SET_QUALIFIER;
+                SET LAST_QUALIFIER = D.SET_QUALIFIER;
+            END IF;
+            EXECUTE IMMEDIATE D.TEXT;
+            SET RESTORED = RESTORED + 1;
+        END FOR;
+    END WHILE;
+    IF LAST_QUALIFIER <> '' THEN
+        EXECUTE IMMEDIATE 'SET SCHEMA ' || QUOTE_IDENTIFIER(SAVE_SCHEMA);
+        EXECUTE IMMEDIATE 'SET PATH ' || SAVE_PATH;
+    END IF;
+    -- Authorizations can only be restored once all the views exist. Only the
+    -- saved definitions of views restored by this call (those created since
+    -- it started) are removed; any others are left for a later call
     FOR D AS
-        SELECT VIEWNAME
-        FROM SAVED_VIEWS
-        WHERE VIEWSCHEMA = ASCHEMA
+        SELECT V.VIEWNAME
+        FROM
+            SAVED_VIEWS V
+            INNER JOIN SYSCAT.TABLES T
+                ON T.TABSCHEMA = V.VIEWSCHEMA
+                AND T.TABNAME = V.VIEWNAME
+        WHERE
+            V.VIEWSCHEMA = ASCHEMA
+            AND T.TYPE = 'V'
+            AND T.CREATE_TIME >= STARTED
     DO
-        CALL RESTORE_VIEW(ASCHEMA, D.VIEWNAME);
+        CALL RESTORE_AUTH(ASCHEMA, D.VIEWNAME);
+        DELETE FROM SAVED_VIEWDEP
+            WHERE VIEWSCHEMA = ASCHEMA
+            AND VIEWNAME = D.VIEWNAME;
+        DELETE FROM SAVED_VIEWS
+            WHERE VIEWSCHEMA = ASCHEMA
+            AND VIEWNAME = D.VIEWNAME;
     END FOR;
 END!
 
@@ -40,6 +40,227 @@ GRANT ROLE UTILS_EXCEPTIONS_USER TO ROLE UTILS_USER!
 GRANT ROLE UTILS_EXCEPTIONS_USER TO ROLE UTILS_EXCEPTIONS_ADMIN WITH ADMIN OPTION!
 GRANT ROLE UTILS_EXCEPTIONS_ADMIN TO ROLE UTILS_ADMIN WITH ADMIN OPTION!
 
+-- CREATED_EXCEPTION_OBJECTS
+-------------------------------------------------------------------------------
+-- The CREATED_EXCEPTION_OBJECTS table records, for each table processed by the
+-- last call to CREATE_SCHEMA_EXCEPTION_TABLES or CREATE_SCHEMA_EXCEPTION_VIEWS,
+-- the exceptions table (OBJTYPE 'T') or view (OBJTYPE 'V') created from it and
+-- the time taken to do so.
+-------------------------------------------------------------------------------
+
+CREATE TABLE CREATED_EXCEPTION_OBJECTS (
+    TABSCHEMA   VARCHAR(128) NOT NULL,
+    TABNAME     VARCHAR(128) NOT NULL,
+    OBJTYPE     CHAR(1) NOT NULL,
+    OBJSCHEMA   VARCHAR(128) NOT NULL,
+    OBJNAME     VARCHAR(128) NOT NULL,
+    STARTED     TIMESTAMP NOT NULL,
+    ELAPSED     DECIMAL(18, 6) NOT NULL
+)!
+
+CREATE UNIQUE INDEX CREATED_EXCEPTION_OBJECTS_PK
+    ON CREATED_EXCEPTION_OBJECTS (TABSCHEMA, TABNAME, OBJTYPE)!
+
+ALTER TABLE CREATED_EXCEPTION_OBJECTS
+    ADD CONSTRAINT PK PRIMARY KEY (TABSCHEMA, TABNAME, OBJTYPE)
+    ADD CONSTRAINT OBJTYPE_CK CHECK (OBJTYPE IN ('T', 'V'))!
+
+GRANT CONTROL ON TABLE CREATED_EXCEPTION_OBJECTS TO ROLE UTILS_EXCEPTIONS_ADMIN WITH GRANT OPTION!
+GRANT SELECT ON TABLE CREATED_EXCEPTION_OBJECTS TO ROLE UTILS_EXCEPTIONS_USER!
+
+COMMENT ON TABLE CREATED_EXCEPTION_OBJECTS
+    IS 'Per table timings of the last CREATE_SCHEMA_EXCEPTION_TABLES or CREATE_SCHEMA_EXCEPTION_VIEWS call'!
+
+-- X_EXCEPTION_COLUMNS(SOURCE_SCHEMA, SOURCE_TABLE)
+-- X_CREATE_EXCEPTION_VIEW(SOURCE_SCHEMA, SOURCE_TABLE, DEST_SCHEMA, DEST_VIEW, COLS)
+-- X_CREATED_EXCEPTION_OBJECT(ASCHEMA, ATABLE, AOBJTYPE, AOBJSCHEMA, AOBJNAME, ASTARTED)
+-------------------------------------------------------------------------------
+-- These routines are effectively private utility subroutines for the
+-- procedures defined below. X_EXCEPTION_COLUMNS returns, for every exceptions
+-- table in SOURCE_SCHEMA (or just SOURCE_TABLE if it is not NULL), a comma
+-- separated list of its columns other than EXCEPT_MSG and EXCEPT_TS, in
+-- order. The lists of all tables are built in a single query with XMLAGG
+-- rather than by repeated concatenation. X_CREATE_EXCEPTION_VIEW (re)creates
+-- an exceptions view from such a list, and X_CREATED_EXCEPTION_OBJECT records
+-- the timing of a table in CREATED_EXCEPTION_OBJECTS.
+-------------------------------------------------------------------------------
+
+CREATE FUNCTION X_EXCEPTION_COLUMNS(
+    SOURCE_SCHEMA VARCHAR(128),
+    SOURCE_TABLE VARCHAR(128)
+)
+    RETURNS TABLE (
+        TABNAME VARCHAR(128),
+        COLS CLOB(64K)
+    )
+    SPECIFIC X_EXCEPTION_COLUMNS
+    NOT DETERMINISTIC
+    NO EXTERNAL ACTION
+    READS SQL DATA
+    LANGUAGE SQL
+RETURN
+    WITH E (TABNAME) AS (
+        SELECT TABNAME
+        FROM SYSCAT.COLUMNS
+        WHERE TABSCHEMA = SOURCE_SCHEMA
+            AND (SOURCE_TABLE IS NULL OR TABNAME = SOURCE_TABLE)
+            AND COLNAME IN ('EXCEPT_MSG', 'EXCEPT_TS')
+        GROUP BY TABNAME
+        HAVING COUNT(*) = 2
+    )
+    SELECT
+        C.TABNAME,
+        CAST(
+            REPLACE(
+            REPLACE(
+            REPLACE(
+            REPLACE(
+            REPLACE(
+            REPLACE(
+            REPLACE(
+                XML2CLOB(XMLAGG(XMLELEMENT(NAME C, QUOTE_IDENTIFIER(C.COLNAME) || ', ') ORDER BY C.COLNO)),
+                '<C>', ''),
+                '</C>', ''),
+                '&quot;', '"'),
+                '&apos;', ''''),
+                '&lt;', '<'),
+                '&gt;', '>'),
+                '&amp;', '&')
+            AS CLOB(64K))
+    FROM
+        SYSCAT.COLUMNS C
+        INNER JOIN E
+            ON C.TABNAME = E.TABNAME
+    WHERE
+        C.TABSCHEMA = SOURCE_SCHEMA
+        AND C.COLNAME NOT IN ('EXCEPT_MSG', 'EXCEPT_TS')
+    GROUP BY
+        C.TABNAME!
+
+CREATE PROCEDURE X_CREATE_EXCEPTION_VIEW(
+    SOURCE_SCHEMA VARCHAR(128),
+    SOURCE_TABLE VARCHAR(128),
+    DEST_SCHEMA VARCHAR(128),
+    DEST_VIEW VARCHAR(128),
+    COLS CLOB(64K)
+)
+    SPECIFIC X_CREATE_EXCEPTION_VIEW
+    MODIFIES SQL DATA
+    NOT DETERMINISTIC
+    NO EXTERNAL ACTION
+    LANGUAGE SQL
+BEGIN ATOMIC
+    DECLARE DDL CLOB(64K) DEFAULT '';
+    -- Drop any existing view with the same name as the destination view
+    FOR D AS
+        SELECT
+            'DROP VIEW ' || QUOTE_IDENTIFIER(TABSCHEMA) || '.' || QUOTE_IDENTIFIER(TABNAME)  AS DROP_CMD
+        FROM
+            SYSCAT.TABLES
+        WHERE
+            TABSCHEMA = DEST_SCHEMA
+            AND TABNAME = DEST_VIEW
+            AND TYPE = 'V'
+    DO
+        EXECUTE IMMEDIATE D.DROP_CMD;
+    END FOR;
+    -- Create the exceptions view based on the structure of the source table
+    SET DDL =
+        'CREATE VIEW ' || QUOTE_IDENTIFIER(DEST_SCHEMA) || '.' || QUOTE_IDENTIFIER(DEST_VIEW) || ' AS '
+        || 'WITH T ('
+        ||      COLS
+        || '    EXCEPT_MSG,'
+        || '    EXCEPT_TYPE,'
+        || '    EXCEPT_OBJECT,'
+        || '    EXCEPT_TS,'
+        || '    I,'
+        || '    J'
+        || ') AS ('
+        || '    SELECT '
+        ||          COLS
+        || '        EXCEPT_MSG,'
+        || '        CHAR(SUBSTR(EXCEPT_MSG, 6, 1)),'
+        || '        SUBSTR(EXCEPT_MSG, 12, INTEGER(DECIMAL(VARCHAR(SUBSTR(EXCEPT_MSG, 7, 5)), 5, 0))),'
+        || '        EXCEPT_TS,'
+        || '        1,'
+        || '        15 + INTEGER(DECIMAL(VARCHAR(SUBSTR(EXCEPT_MSG, 7, 5)), 5, 0))'
+        || '    FROM ' || QUOTE_IDENTIFIER(SOURCE_SCHEMA) || '.' || QUOTE_IDENTIFIER(SOURCE_TABLE)
+        || '    UNION ALL'
+        || '    SELECT '
+        ||          COLS
+        || '        EXCEPT_MSG,'
+        || '        CHAR(SUBSTR(EXCEPT_MSG, J, 1)),'
+        || '        SUBSTR(EXCEPT_MSG, J + 6, INTEGER(DECIMAL(VARCHAR(SUBSTR(EXCEPT_MSG, J + 1, 5)), 5, 0))),'
+        || '        EXCEPT_TS,'
+        || '        I + 1,'
+        || '        J + 9 + INTEGER(DECIMAL(VARCHAR(SUBSTR(EXCEPT_MSG, J + 1, 5)), 5, 0))'
+        || '    FROM T'
+        || '    WHERE I < INTEGER(DECIMAL(VARCHAR(SUBSTR(EXCEPT_MSG, 1, 5)), 5, 0))'
+        || '    AND I < 20'
+        || ')'
+        || 'SELECT '
+        ||      COLS
+        || '    EXCEPT_TYPE,'
+        || '    CASE WHEN EXCEPT_TYPE = ''I'''
+        || '        THEN ('
+        || '            SELECT VARCHAR(RTRIM(INDSCHEMA) || ''.'' || RTRIM(INDNAME))'
+        || '            FROM SYSCAT.INDEXES'
+        || '            WHERE CHAR(IID) = EXCEPT_OBJECT'
+        || '        )'
+        || '        ELSE EXCEPT_OBJECT'
+        || '    END AS EXCEPT_OBJECT,'
+        || '    EXCEPT_TS '
+        || 'FROM T';
+    EXECUTE IMMEDIATE DDL;
+    -- Store the source table's authorizations, then redirect them to the
+    -- destination table filtering out those authorizations which should be
+    -- excluded
+    CALL SAVE_AUTH(SOURCE_SCHEMA, SOURCE_TABLE);
+    UPDATE SAVED_AUTH SET
+        TABSCHEMA = DEST_SCHEMA,
+        TABNAME = DEST_VIEW,
+        DELETEAUTH = 'N',
+        INSERTAUTH = 'N',
+        UPDATEAUTH = 'N'
+    WHERE TABSCHEMA = SOURCE_SCHEMA
+        AND TABNAME = SOURCE_TABLE;
+    CALL RESTORE_AUTH(DEST_SCHEMA, DEST_VIEW);
+END!
+
+CREATE PROCEDURE X_CREATED_EXCEPTION_OBJECT(
+    ASCHEMA VARCHAR(128),
+    ATABLE VARCHAR(128),
+    AOBJTYPE CHAR(1),
+    AOBJSCHEMA VARCHAR(128),
+    AOBJNAME VARCHAR(128),
+    ASTARTED TIMESTAMP
+)
+    SPECIFIC X_CREATED_EXCEPTION_OBJECT
+    MODIFIES SQL DATA
+    NOT DETERMINISTIC
+    NO EXTERNAL ACTION
+    LANGUAGE SQL
+BEGIN ATOMIC
+    DECLARE FINISHED TIMESTAMP;
+    SET FINISHED = CURRENT TIMESTAMP;
+    DELETE FROM CREATED_EXCEPTION_OBJECTS
+        WHERE TABSCHEMA = ASCHEMA
+        AND TABNAME = ATABLE
+        AND OBJTYPE = AOBJTYPE;
+    INSERT INTO CREATED_EXCEPTION_OBJECTS
+        (TABSCHEMA, TABNAME, OBJTYPE, OBJSCHEMA, OBJNAME, STARTED, ELAPSED)
+        VALUES (
+            ASCHEMA,
+            ATABLE,
+            AOBJTYPE,
+            AOBJSCHEMA,
+            AOBJNAME,
+            ASTARTED,
+            (SECONDS(FINISHED) - SECONDS(ASTARTED))
+                + (MICROSECOND(FINISHED) - MICROSECOND(ASTARTED)) / 1000000.0
+        );
+END!
+
 -- CREATE_EXCEPTION_TABLE(SOURCE_SCHEMA, SOURCE_TABLE, DEST_SCHEMA, DEST_TABLE, DEST_TBSPACE)
 -- CREATE_EXCEPTION_TABLE(SOURCE_SCHEMA, SOURCE_TABLE, DEST_SCHEMA, DEST_TABLE)
 -- CREATE_EXCEPTION_TABLE(SOURCE_TABLE, DEST_TABLE, DEST_TBSPACE)
@@ -110,7 +331,7 @@ BEGIN ATOMIC
         || '    FROM '
         ||          QUOTE_IDENTIFIER(SOURCE_SCHEMA) || '.' || QUOTE_IDENTIFIER(SOURCE_TABLE) || ' AS T'
         || ')'
-        || 'WITH NO DATA IN ' || DEST_TBSPACE;
+        || 'WITH NO DATA' || COALESCE(' IN ' || DEST_TBSPACE, '');
     EXECUTE IMMEDIATE DDL;
     -- Store the source table's authorizations, then redirect them to the
     -- destination table
@@ -210,6 +431,139 @@ COMMENT ON SPECIFIC PROCEDURE CREATE_EXCEPTION_TABLE4
 COMMENT ON SPECIFIC PROCEDURE CREATE_EXCEPTION_TABLE5
     IS 'Creates an exception table based on the structure of the specified table'!
 
+-- CREATE_SCHEMA_EXCEPTION_TABLES(SOURCE_SCHEMA, DEST_SCHEMA, DEST_TBSPACE)
+-- CREATE_SCHEMA_EXCEPTION_TABLES(SOURCE_SCHEMA, DEST_SCHEMA)
+-- CREATE_SCHEMA_EXCEPTION_TABLES(SOURCE_SCHEMA)
+-- CREATE_SCHEMA_EXCEPTION_TABLES()
+-------------------------------------------------------------------------------
+-- The CREATE_SCHEMA_EXCEPTION_TABLES procedure is equivalent to calling
+-- CREATE_EXCEPTION_TABLE for every table in SOURCE_SCHEMA (other than those
+-- which are already exceptions tables, or whose names end with
+-- '_EXCEPTIONS'), creating tables with the same names plus an '_EXCEPTIONS'
+-- suffix in DEST_SCHEMA. The tables to process are read from the catalog in a
+-- single query. The time taken for each table is recorded in
+-- CREATED_EXCEPTION_OBJECTS (which is cleared of prior exceptions table
+-- entries for the schema first). The procedure commits after every 10 tables
+-- (and at the end), so an interrupted run keeps the tables created so far and
+-- may simply be run again.
+--
+-- If DEST_TBSPACE is not specified, each exceptions table is created in the
+-- tablespace of its source table. If DEST_SCHEMA is not specified it defaults
+-- to SOURCE_SCHEMA, and if SOURCE_SCHEMA is not specified it defaults to the
+-- current schema.
+-------------------------------------------------------------------------------
+
+CREATE PROCEDURE CREATE_SCHEMA_EXCEPTION_TABLES(
+    SOURCE_SCHEMA VARCHAR(128),
+    DEST_SCHEMA VARCHAR(128),
+    DEST_TBSPACE VARCHAR(18)
+)
+    SPECIFIC CREATE_SCHEMA_EXCEPTION_TABLES1
+    MODIFIES SQL DATA
+    NOT DETERMINISTIC
+    NO EXTERNAL ACTION
+    LANGUAGE SQL
+BEGIN
+    DECLARE COMMIT_TABLES INTEGER DEFAULT 10;
+    DECLARE DONE_TABLES INTEGER DEFAULT 0;
+    DECLARE TABLE_STARTED TIMESTAMP DEFAULT NULL;
+    DECLARE T_TABNAME VARCHAR(128) DEFAULT NULL;
+    DECLARE T_DEST_TABLE VARCHAR(128) DEFAULT NULL;
+    DECLARE T_TBSPACE VARCHAR(128) DEFAULT NULL;
+    DECLARE TABLES_CUR CURSOR WITH HOLD FOR
+        SELECT
+            S.TABNAME,
+            S.TABNAME || '_EXCEPTIONS' AS DEST_TABLE,
+            COALESCE(DEST_TBSPACE, S.TBSPACE) AS TBSPACE
+        FROM
+            SYSCAT.TABLES S
+        WHERE
+            S.TABSCHEMA = SOURCE_SCHEMA
+            AND S.TYPE = 'T'
+            AND S.TABNAME NOT LIKE '%\_EXCEPTIONS' ESCAPE '\'
+            AND S.TABNAME NOT IN (
+                SELECT TABNAME
+                FROM TABLE(X_EXCEPTION_COLUMNS(SOURCE_SCHEMA, CAST(NULL AS VARCHAR(128)))) AS E
+            )
+        ORDER BY
+            S.TABNAME;
+
+    DELETE FROM CREATED_EXCEPTION_OBJECTS
+        WHERE TABSCHEMA = SOURCE_SCHEMA
+        AND OBJTYPE = 'T';
+    COMMIT;
+    -- The cursor is held open across the commit after every COMMIT_TABLES
+    -- tables. As it reads the catalog while tables are being created, the
+    -- exceptions tables created along the way are excluded by name, as well
+    -- as by their EXCEPT_MSG and EXCEPT_TS columns
+    OPEN TABLES_CUR;
+    FETCH TABLES_CUR INTO T_TABNAME, T_DEST_TABLE, T_TBSPACE;
+    WHILE T_TABNAME IS NOT NULL DO
+        SET TABLE_STARTED = CURRENT TIMESTAMP;
+        CALL CREATE_EXCEPTION_TABLE(SOURCE_SCHEMA, T_TABNAME, DEST_SCHEMA, T_DEST_TABLE, T_TBSPACE);
+        CALL X_CREATED_EXCEPTION_OBJECT(SOURCE_SCHEMA, T_TABNAME, 'T', DEST_SCHEMA, T_DEST_TABLE, TABLE_STARTED);
+        SET DONE_TABLES = DONE_TABLES + 1;
+        IF MOD(DONE_TABLES, COMMIT_TABLES) = 0 THEN
+            COMMIT;
+        END IF;
+        SET T_TABNAME = NULL;
+        FETCH TABLES_CUR INTO T_TABNAME, T_DEST_TABLE, T_TBSPACE;
+    END WHILE;
+    CLOSE TABLES_CUR;
+    COMMIT;
+END!
+
+CREATE PROCEDURE CREATE_SCHEMA_EXCEPTION_TABLES(
+    SOURCE_SCHEMA VARCHAR(128),
+    DEST_SCHEMA VARCHAR(128)
+)
+    SPECIFIC CREATE_SCHEMA_EXCEPTION_TABLES2
+    MODIFIES SQL DATA
+    NOT DETERMINISTIC
+    NO EXTERNAL ACTION
+    LANGUAGE SQL
+BEGIN
+    CALL CREATE_SCHEMA_EXCEPTION_TABLES(SOURCE_SCHEMA, DEST_SCHEMA, CAST(NULL AS VARCHAR(18)));
+END!
+
+CREATE PROCEDURE CREATE_SCHEMA_EXCEPTION_TABLES(SOURCE_SCHEMA VARCHAR(128))
+    SPECIFIC CREATE_SCHEMA_EXCEPTION_TABLES3
+    MODIFIES SQL DATA
+    NOT DETERMINISTIC
+    NO EXTERNAL ACTION
+    LANGUAGE SQL
+BEGIN
+    CALL CREATE_SCHEMA_EXCEPTION_TABLES(SOURCE_SCHEMA, SOURCE_SCHEMA);
+END!
+
+CREATE PROCEDURE CREATE_SCHEMA_EXCEPTION_TABLES()
+    SPECIFIC CREATE_SCHEMA_EXCEPTION_TABLES4
+    MODIFIES SQL DATA
+    NOT DETERMINISTIC
+    NO EXTERNAL ACTION
+    LANGUAGE SQL
+BEGIN
+    CALL CREATE_SCHEMA_EXCEPTION_TABLES(CURRENT SCHEMA);
+END!
+
+GRANT EXECUTE ON SPECIFIC PROCEDURE CREATE_SCHEMA_EXCEPTION_TABLES1 TO ROLE UTILS_EXCEPTIONS_USER!
+GRANT EXECUTE ON SPECIFIC PROCEDURE CREATE_SCHEMA_EXCEPTION_TABLES2 TO ROLE UTILS_EXCEPTIONS_USER!
+GRANT EXECUTE ON SPECIFIC PROCEDURE CREATE_SCHEMA_EXCEPTION_TABLES3 TO ROLE UTILS_EXCEPTIONS_USER!
+GRANT EXECUTE ON SPECIFIC PROCEDURE CREATE_SCHEMA_EXCEPTION_TABLES4 TO ROLE UTILS_EXCEPTIONS_USER!
+GRANT EXECUTE ON SPECIFIC PROCEDURE CREATE_SCHEMA_EXCEPTION_TABLES1 TO ROLE UTILS_EXCEPTIONS_ADMIN WITH GRANT OPTION!
+GRANT EXECUTE ON SPECIFIC PROCEDURE CREATE_SCHEMA_EXCEPTION_TABLES2 TO ROLE UTILS_EXCEPTIONS_ADMIN WITH GRANT OPTION!
+GRANT EXECUTE ON SPECIFIC PROCEDURE CREATE_SCHEMA_EXCEPTION_TABLES3 TO ROLE UTILS_EXCEPTIONS_ADMIN WITH GRANT OPTION!
+GRANT EXECUTE ON SPECIFIC PROCEDURE CREATE_SCHEMA_EXCEPTION_TABLES4 TO ROLE UTILS_EXCEPTIONS_ADMIN WITH GRANT OPTION!
+
+COMMENT ON SPECIFIC PROCEDURE CREATE_SCHEMA_EXCEPTION_TABLES1
+    IS 'Creates exception tables based on the structure of every table in the specified schema'!
+COMMENT ON SPECIFIC PROCEDURE CREATE_SCHEMA_EXCEPTION_TABLES2
+    IS 'Creates exception tables based on the structure of every table in the specified schema'!
+COMMENT ON SPECIFIC PROCEDURE CREATE_SCHEMA_EXCEPTION_TABLES3
+    IS 'Creates exception tables based on the structure of every table in the specified schema'!
+COMMENT ON SPECIFIC PROCEDURE CREATE_SCHEMA_EXCEPTION_TABLES4
+    IS 'Creates exception tables based on the structure of every table in the current schema'!
+
 -- CREATE_EXCEPTION_VIEW(SOURCE_SCHEMA, SOURCE_TABLE, DEST_SCHEMA, DEST_VIEW)
 -- CREATE_EXCEPTION_VIEW(SOURCE_TABLE, DEST_VIEW)
 -- CREATE_EXCEPTION_VIEW(SOURCE_TABLE)
@@ -253,99 +607,10 @@ CREATE PROCEDURE CREATE_EXCEPTION_VIEW(
     NO EXTERNAL ACTION
     LANGUAGE SQL
 BEGIN ATOMIC
-    DECLARE COLS CLOB(64K) DEFAULT '';
-    DECLARE DDL CLOB(64K) DEFAULT '';
-    -- Drop any existing view with the same name as the destination view
-    FOR D AS
-        SELECT
-            'DROP VIEW ' || QUOTE_IDENTIFIER(TABSCHEMA) || '.' || QUOTE_IDENTIFIER(TABNAME)  AS DROP_CMD
-        FROM
-            SYSCAT.TABLES
-        WHERE
-            TABSCHEMA = DEST_SCHEMA
-            AND TABNAME = DEST_VIEW
-            AND TYPE = 'V'
-    DO
-        EXECUTE IMMEDIATE D.DROP_CMD;
-    END FOR;
-    -- Generate a comma separated list of the source table fields in the order
-    -- that they exist in the source table
-    FOR C AS
-        SELECT
-            COLNAME
-        FROM
-            SYSCAT.COLUMNS
-        WHERE
-            TABSCHEMA = SOURCE_SCHEMA
-            AND TABNAME = SOURCE_TABLE
-            AND COLNAME <> 'EXCEPT_MSG'
-            AND COLNAME <> 'EXCEPT_TS'
-        ORDER BY
-            COLNO
-    DO
-        SET COLS = COLS || QUOTE_IDENTIFIER(C.COLNAME) || ', ';
-    END FOR;
-    -- Create the exceptions view based on the structure of the source table
-    SET DDL =
-        'CREATE VIEW ' || QUOTE_IDENTIFIER(DEST_SCHEMA) || '.' || QUOTE_IDENTIFIER(DEST_VIEW) || ' AS '
-        || 'WITH T ('
-        ||      COLS
-        || '    EXCEPT_MSG,'
-        || '    EXCEPT_TYPE,'
-        || '    EXCEPT_OBJECT,'
-        || '    EXCEPT_TS,'
-        || '    I,'
-        || '    J'
-        || ') AS ('
-        || '    SELECT '
-        ||          COLS
-        || '        EXCEPT_MSG,'
-        || '        CHAR(SUBSTR(EXCEPT_MSG, 6, 1)),'
-        || '        SUBSTR(EXCEPT_MSG, 12, INTEGER(DECIMAL(VARCHAR(SUBSTR(EXCEPT_MSG, 7, 5)), 5, 0))),'
-        || '        EXCEPT_TS,'
-        || '        1,'
-        || '        15 + INTEGER(DECIMAL(VARCHAR(SUBSTR(EXCEPT_MSG, 7, 5)), 5, 0))'
-        || '    FROM ' || QUOTE_IDENTIFIER(SOURCE_SCHEMA) || '.' || QUOTE_IDENTIFIER(SOURCE_TABLE)
-        || '    UNION ALL'
-        || '    SELECT '
-        ||          COLS
-        || '        EXCEPT_MSG,'
-        || '        CHAR(SUBSTR(EXCEPT_MSG, J, 1)),'
-        || '        SUBSTR(EXCEPT_MSG, J + 6, INTEGER(DECIMAL(VARCHAR(SUBSTR(EXCEPT_MSG, J + 1, 5)), 5, 0))),'
-        || '        EXCEPT_TS,'
-        || '        I + 1,'
-        || '        J + 9 + INTEGER(DECIMAL(VARCHAR(SUBSTR(EXCEPT_MSG, J + 1, 5)), 5, 0))'
-        || '    FROM T'
-        || '    WHERE I < INTEGER(DECIMAL(VARCHAR(SUBSTR(EXCEPT_MSG, 1, 5)), 5, 0))'
-        || '    AND I < 20'
-        || ')'
-        || 'SELECT '
-        ||      COLS
-        || '    EXCEPT_TYPE,'
-        || '    CASE WHEN EXCEPT_TYPE = ''I'''
-        || '        THEN ('
-        || '            SELECT VARCHAR(RTRIM(INDSCHEMA) || ''.'' || RTRIM(INDNAME))'
-        || '            FROM SYSCAT.INDEXES'
-        || '            WHERE CHAR(IID) = EXCEPT_OBJECT'
-        || '        )'
-        || '        ELSE EXCEPT_OBJECT'
-        || '    END AS EXCEPT_OBJECT,'
-        || '    EXCEPT_TS '
-        || 'FROM T';
-    EXECUTE IMMEDIATE DDL;
-    -- Store the source table's authorizations, then redirect them to the
-    -- destination table filtering out those authorizations which should be
-    -- excluded
-    CALL SAVE_AUTH(SOURCE_SCHEMA, SOURCE_TABLE);
-    UPDATE SAVED_AUTH SET
-        TABSCHEMA = DEST_SCHEMA,
-        TABNAME = DEST_VIEW,
-        DELETEAUTH = 'N',
-        INSERTAUTH = 'N',
-        UPDATEAUTH = 'N'
-    WHERE TABSCHEMA = SOURCE_SCHEMA
-        AND TABNAME = SOURCE_TABLE;
-    CALL RESTORE_AUTH(DEST_SCHEMA, DEST_VIEW);
+    CALL X_CREATE_EXCEPTION_VIEW(SOURCE_SCHEMA, SOURCE_TABLE, DEST_SCHEMA, DEST_VIEW, (
+        SELECT COLS
+        FROM TABLE(X_EXCEPTION_COLUMNS(SOURCE_SCHEMA, SOURCE_TABLE)) AS T
+    ));
 END!
 
 CREATE PROCEDURE CREATE_EXCEPTION_VIEW(SOURCE_TABLE VARCHAR(128), DEST_VIEW VARCHAR(128))
@@ -382,4 +647,110 @@ COMMENT ON SPECIFIC PROCEDURE CREATE_EXCEPTION_VIEW2
 COMMENT ON SPECIFIC PROCEDURE CREATE_EXCEPTION_VIEW3
     IS 'Creates a view based on the specified exception table which interprets the content of the EXCEPT_MSG column'!
 
+-- CREATE_SCHEMA_EXCEPTION_VIEWS(SOURCE_SCHEMA, DEST_SCHEMA)
+-- CREATE_SCHEMA_EXCEPTION_VIEWS(SOURCE_SCHEMA)
+-- CREATE_SCHEMA_EXCEPTION_VIEWS()
+-------------------------------------------------------------------------------
+-- The CREATE_SCHEMA_EXCEPTION_VIEWS procedure is equivalent to calling
+-- CREATE_EXCEPTION_VIEW for every exceptions table (any table with EXCEPT_MSG
+-- and EXCEPT_TS columns) in SOURCE_SCHEMA, creating views with the same names
+-- plus a '_V' suffix in DEST_SCHEMA. The columns of all the exceptions tables
+-- are read from the catalog in a single query. The time taken for each table
+-- is recorded in CREATED_EXCEPTION_OBJECTS (which is cleared of prior
+-- exceptions view entries for the schema first). Like
+-- CREATE_SCHEMA_EXCEPTION_TABLES, the procedure commits after every 10 tables
+-- and at the end.
+--
+-- If DEST_SCHEMA is not specified it defaults to SOURCE_SCHEMA, and if
+-- SOURCE_SCHEMA is not specified it defaults to the current schema.
+-------------------------------------------------------------------------------
+
+CREATE PROCEDURE CREATE_SCHEMA_EXCEPTION_VIEWS(
+    SOURCE_SCHEMA VARCHAR(128),
+    DEST_SCHEMA VARCHAR(128)
+)
+    SPECIFIC CREATE_SCHEMA_EXCEPTION_VIEWS1
+    MODIFIES SQL DATA
+    NOT DETERMINISTIC
+    NO EXTERNAL ACTION
+    LANGUAGE SQL
+BEGIN
+    DECLARE COMMIT_TABLES INTEGER DEFAULT 10;
+    DECLARE DONE_TABLES INTEGER DEFAULT 0;
+    DECLARE TABLE_STARTED TIMESTAMP DEFAULT NULL;
+    DECLARE T_TABNAME VARCHAR(128) DEFAULT NULL;
+    DECLARE T_DEST_VIEW VARCHAR(128) DEFAULT NULL;
+    DECLARE T_COLS CLOB(64K) DEFAULT NULL;
+    DECLARE TABLES_CUR CURSOR WITH HOLD FOR
+        SELECT
+            E.TABNAME,
+            E.TABNAME || '_V' AS DEST_VIEW,
+            E.COLS
+        FROM
+            TABLE(X_EXCEPTION_COLUMNS(SOURCE_SCHEMA, CAST(NULL AS VARCHAR(128)))) AS E
+            INNER JOIN SYSCAT.TABLES S
+                ON S.TABSCHEMA = SOURCE_SCHEMA
+                AND S.TABNAME = E.TABNAME
+        WHERE
+            S.TYPE = 'T'
+        ORDER BY
+            E.TABNAME;
+
+    DELETE FROM CREATED_EXCEPTION_OBJECTS
+        WHERE TABSCHEMA = SOURCE_SCHEMA
+        AND OBJTYPE = 'V';
+    COMMIT;
+    -- The cursor is held open across the commit after every COMMIT_TABLES
+    -- tables, so the catalog is only read once
+    OPEN TABLES_CUR;
+    FETCH TABLES_CUR INTO T_TABNAME, T_DEST_VIEW, T_COLS;
+    WHILE T_TABNAME IS NOT NULL DO
+        SET TABLE_STARTED = CURRENT TIMESTAMP;
+        CALL X_CREATE_EXCEPTION_VIEW(SOURCE_SCHEMA, T_TABNAME, DEST_SCHEMA, T_DEST_VIEW, T_COLS);
+        CALL X_CREATED_EXCEPTION_OBJECT(SOURCE_SCHEMA, T_TABNAME, 'V', DEST_SCHEMA, T_DEST_VIEW, TABLE_STARTED);
+        SET DONE_TABLES = DONE_TABLES + 1;
+        IF MOD(DONE_TABLES, COMMIT_TABLES) = 0 THEN
+            COMMIT;
+        END IF;
+        SET T_TABNAME = NULL;
+        FETCH TABLES_CUR INTO T_TABNAME, T_DEST_VIEW, T_COLS;
+    END WHILE;
+    CLOSE TABLES_CUR;
+    COMMIT;
+END!
+
+CREATE PROCEDURE CREATE_SCHEMA_EXCEPTION_VIEWS(SOURCE_SCHEMA VARCHAR(128))
+    SPECIFIC CREATE_SCHEMA_EXCEPTION_VIEWS2
+    MODIFIES SQL DATA
+    NOT DETERMINISTIC
+    NO EXTERNAL ACTION
+    LANGUAGE SQL
+BEGIN
+    CALL CREATE_SCHEMA_EXCEPTION_VIEWS(SOURCE_SCHEMA, SOURCE_SCHEMA);
+END!
+
+CREATE PROCEDURE CREATE_SCHEMA_EXCEPTION_VIEWS()
+    SPECIFIC CREATE_SCHEMA_EXCEPTION_VIEWS3
+    MODIFIES SQL DATA
+    NOT DETERMINISTIC
+    NO EXTERNAL ACTION
+    LANGUAGE SQL
+BEGIN
+    CALL CREATE_SCHEMA_EXCEPTION_VIEWS(CURRENT SCHEMA);
+END!
+
+GRANT EXECUTE ON SPECIFIC PROCEDURE CREATE_SCHEMA_EXCEPTION_VIEWS1 TO ROLE UTILS_EXCEPTIONS_USER!
+GRANT EXECUTE ON SPECIFIC PROCEDURE CREATE_SCHEMA_EXCEPTION_VIEWS2 TO ROLE UTILS_EXCEPTIONS_USER!
+GRANT EXECUTE ON SPECIFIC PROCEDURE CREATE_SCHEMA_EXCEPTION_VIEWS3 TO ROLE UTILS_EXCEPTIONS_USER!
+GRANT EXECUTE ON SPECIFIC PROCEDURE CREATE_SCHEMA_EXCEPTION_VIEWS1 TO ROLE UTILS_EXCEPTIONS_ADMIN WITH GRANT OPTION!
+GRANT EXECUTE ON SPECIFIC PROCEDURE CREATE_SCHEMA_EXCEPTION_VIEWS2 TO ROLE UTILS_EXCEPTIONS_ADMIN WITH GRANT OPTION!
+GRANT EXECUTE ON SPECIFIC PROCEDURE CREATE_SCHEMA_EXCEPTION_VIEWS3 TO ROLE UTILS_EXCEPTIONS_ADMIN WITH GRANT OPTION!
+
+COMMENT ON SPECIFIC PROCEDURE CREATE_SCHEMA_EXCEPTION_VIEWS1
+    IS 'Creates views interpreting the EXCEPT_MSG column of every exception table in the specified schema'!
+COMMENT ON SPECIFIC PROCEDURE CREATE_SCHEMA_EXCEPTION_VIEWS2
+    IS 'Creates views interpreting the EXCEPT_MSG column of every exception table in the specified schema'!
+COMMENT ON SPECIFIC PROCEDURE CREATE_SCHEMA_EXCEPTION_VIEWS3
+    IS 'Creates views interpreting the EXCEPT_MSG column of every exception table in the current schema'!
+
 -- vim: set et sw=4 sts=4:
@@ -26,7 +26,9 @@
 -- utility is firstly that arbitrary SQL queries can be used to precisely
 -- define the set of tables to generate statements for, and also that
 -- parameters are provided to handle tables containing generated and identity
--- columns gracefully (db2move tends to barf on these).
+-- columns gracefully (db2move tends to barf on these). Exports can also be
+-- incremental, skipping tables which haven't changed since they were last
+-- exported (as recorded in the EXPORT_MANIFEST table).
 -------------------------------------------------------------------------------
 
 
@@ -43,6 +45,20 @@ GRANT ROLE UTILS_LOAD_USER TO ROLE UTILS_USER!
 GRANT ROLE UTILS_LOAD_USER TO ROLE UTILS_LOAD_ADMIN WITH ADMIN OPTION!
 GRANT ROLE UTILS_LOAD_ADMIN TO ROLE UTILS_ADMIN WITH ADMIN OPTION!
 
+-- SQLSTATES
+-------------------------------------------------------------------------------
+-- The following variables define the set of SQLSTATEs raised by the procedures
+-- and functions in this module.
+-------------------------------------------------------------------------------
+
+CREATE VARIABLE LOAD_INCREMENTAL_STATE CHAR(5) CONSTANT '90017'!
+
+GRANT READ ON VARIABLE LOAD_INCREMENTAL_STATE TO ROLE UTILS_LOAD_USER!
+GRANT READ ON VARIABLE LOAD_INCREMENTAL_STATE TO ROLE UTILS_LOAD_ADMIN WITH GRANT OPTION!
+
+COMMENT ON VARIABLE LOAD_INCREMENTAL_STATE
+    IS 'The SQLSTATE raised when RUN_EXPORT_SCHEMA is called with an INCREMENTAL value other than N, Y, or D'!
+
 -- TABLE_COLUMNS(ASCHEMA, ATABLE, INCLUDE_GENERATED, INCLUDE_IDENTITY)
 -- TABLE_COLUMNS(ATABLE, INCLUDE_GENERATED, INCLUDE_IDENTITY)
 -- TABLE_COLUMNS(ATABLE)
@@ -303,6 +319,477 @@ COMMENT ON SPECIFIC FUNCTION EXPORT_SCHEMA2
 COMMENT ON SPECIFIC FUNCTION EXPORT_SCHEMA3
     IS 'Generates EXPORT commands for all tables in the specified schema, including or excluding generated and/or identity columns as requested'!
 
+-- EXPORT_MANIFEST
+-------------------------------------------------------------------------------
+-- The EXPORT_MANIFEST table records the state of each table in a schema as of
+-- the last call to REFRESH_EXPORT_MANIFEST (SCANNED, ROW_COUNT, CHECKSUM and
+-- LAST_CHANGED) and as of its last export (the EXPORTED columns). A table is
+-- considered changed, and hence in need of export, if the two differ.
+--
+-- For ordinary tables, CHECKSUM is the sum of the ROW_HASH of every row. For
+-- history tables (those created by CREATE_HISTORY_TABLE, with EFFECTIVE and
+-- EXPIRY columns), LAST_CHANGED is the latest effective or expiry date in the
+-- table, and CHECKSUM covers only the rows changed at that date; this is far
+-- cheaper than hashing the whole table, and still detects changes to the
+-- current rows within a single history period. CHECKSUM is NULL if the table
+-- contains columns which cannot be hashed, in which case an ordinary table is
+-- always considered changed.
+-------------------------------------------------------------------------------
+
+CREATE TABLE EXPORT_MANIFEST (
+    TABSCHEMA         VARCHAR(128) NOT NULL,
+    TABNAME           VARCHAR(128) NOT NULL,
+    SCANNED           TIMESTAMP NOT NULL,
+    ROW_COUNT         BIGINT NOT NULL,
+    CHECKSUM          DECIMAL(31, 0) DEFAULT NULL,
+    LAST_CHANGED      TIMESTAMP DEFAULT NULL,
+    EXPORTED          TIMESTAMP DEFAULT NULL,
+    EXPORTED_ROWS     BIGINT DEFAULT NULL,
+    EXPORTED_CHECKSUM DECIMAL(31, 0) DEFAULT NULL,
+    EXPORTED_CHANGED  TIMESTAMP DEFAULT NULL
+)!
+
+CREATE UNIQUE INDEX EXPORT_MANIFEST_PK
+    ON EXPORT_MANIFEST (TABSCHEMA, TABNAME)!
+
+ALTER TABLE EXPORT_MANIFEST
+    ADD CONSTRAINT PK PRIMARY KEY (TABSCHEMA, TABNAME)!
+
+GRANT CONTROL ON TABLE EXPORT_MANIFEST TO ROLE UTILS_LOAD_ADMIN WITH GRANT OPTION!
+GRANT SELECT ON TABLE EXPORT_MANIFEST TO ROLE UTILS_LOAD_USER!
+
+COMMENT ON TABLE EXPORT_MANIFEST
+    IS 'Row counts and checksums of tables as last scanned and as last exported, used by incremental exports'!
+
+-- X_EXPORT_HASHABLE(ASCHEMA, ATABLE)
+-- X_EXPORT_CHANGED(ASCHEMA, ATABLE)
+-- X_EXPORT_SINCE(ASCHEMA, ATABLE, SINCE)
+-- X_EXPORT_DELTA(ASCHEMA, ATABLE, INCLUDE_GENERATED, INCLUDE_IDENTITY, SINCE)
+-------------------------------------------------------------------------------
+-- These functions are effectively private utility subroutines for the
+-- routines defined below. X_EXPORT_HASHABLE returns 'Y' if all columns of the
+-- specified table are of types that X_BUILD_ROW_HASH can hash, and 'N'
+-- otherwise.
+--
+-- The others return NULL unless the specified table is a history table (its
+-- first two columns are an EFFECTIVE and EXPIRY column of the same date or
+-- timestamp type, the latter with a default). X_EXPORT_CHANGED returns an
+-- aggregate expression giving the latest effective or expiry date of the
+-- table as a TIMESTAMP. X_EXPORT_SINCE returns a predicate matching rows
+-- which became effective on or after SINCE, or which expired in or after the
+-- period containing SINCE, and X_EXPORT_DELTA an EXPORT command (like that of
+-- EXPORT_TABLE) for those rows. As a row changed within a period expires at
+-- the end of the prior period (a day or a microsecond before the period
+-- starts, depending on the type of the columns) expiry dates are compared
+-- with SINCE less that step, otherwise rows updated or deleted in the same
+-- period as the last export would be missed.
+-------------------------------------------------------------------------------
+
+CREATE FUNCTION X_EXPORT_HASHABLE(ASCHEMA VARCHAR(128), ATABLE VARCHAR(128))
+    RETURNS CHAR(1)
+    SPECIFIC X_EXPORT_HASHABLE
+    LANGUAGE SQL
+    NOT DETERMINISTIC
+    NO EXTERNAL ACTION
+    READS SQL DATA
+RETURN
+    CASE WHEN EXISTS (
+        SELECT 1
+        FROM SYSCAT.COLUMNS
+        WHERE TABSCHEMA = ASCHEMA
+        AND TABNAME = ATABLE
+        AND NOT (
+            TYPESCHEMA = 'SYSIBM'
+            AND TYPENAME IN (
+                'CHARACTER', 'VARCHAR', 'GRAPHIC', 'VARGRAPHIC', 'SMALLINT',
+                'INTEGER', 'BIGINT', 'DECIMAL', 'DECFLOAT', 'REAL', 'DOUBLE',
+                'TIMESTAMP', 'DATE', 'TIME'
+            )
+        )
+    )
+        THEN 'N'
+        ELSE 'Y'
+    END!
+
+CREATE FUNCTION X_EXPORT_CHANGED(ASCHEMA VARCHAR(128), ATABLE VARCHAR(128))
+    RETURNS VARCHAR(1000)
+    SPECIFIC X_EXPORT_CHANGED
+    LANGUAGE SQL
+    NOT DETERMINISTIC
+    NO EXTERNAL ACTION
+    READS SQL DATA
+RETURN
+    SELECT
+        CASE E.TYPENAME WHEN 'DATE' THEN 'TIMESTAMP(' ELSE '' END
+        || 'MAX(CASE WHEN ' || QUOTE_IDENTIFIER(X.COLNAME) || ' = ' || X.DEFAULT
+        || ' THEN ' || QUOTE_IDENTIFIER(E.COLNAME)
+        || ' ELSE ' || QUOTE_IDENTIFIER(X.COLNAME) || ' END)'
+        || CASE E.TYPENAME WHEN 'DATE' THEN ', ''00:00:00'')' ELSE '' END
+    FROM
+        SYSCAT.COLUMNS E
+        INNER JOIN SYSCAT.COLUMNS X
+            ON E.TABSCHEMA = X.TABSCHEMA
+            AND E.TABNAME = X.TABNAME
+    WHERE
+        E.TABSCHEMA = ASCHEMA
+        AND E.TABNAME = ATABLE
+        AND E.COLNO = 0
+        AND X.COLNO = 1
+        AND E.COLNAME LIKE 'EFFECTIVE\_%' ESCAPE '\'
+        AND X.COLNAME LIKE 'EXPIRY\_%' ESCAPE '\'
+        AND E.TYPESCHEMA = 'SYSIBM'
+        AND E.TYPENAME IN ('DATE', 'TIMESTAMP')
+        AND X.TYPESCHEMA = E.TYPESCHEMA
+        AND X.TYPENAME = E.TYPENAME
+        AND X.DEFAULT IS NOT NULL!
+
+CREATE FUNCTION X_EXPORT_SINCE(
+    ASCHEMA VARCHAR(128),
+    ATABLE VARCHAR(128),
+    SINCE TIMESTAMP
+)
+    RETURNS VARCHAR(1000)
+    SPECIFIC X_EXPORT_SINCE
+    LANGUAGE SQL
+    NOT DETERMINISTIC
+    NO EXTERNAL ACTION
+    READS SQL DATA
+RETURN
+    SELECT
+        '(' || QUOTE_IDENTIFIER(E.COLNAME) || ' >= ' || L.LITERAL
+        || ' OR (' || QUOTE_IDENTIFIER(X.COLNAME) || ' <> ' || X.DEFAULT
+        || ' AND ' || QUOTE_IDENTIFIER(X.COLNAME) || ' >= ' || L.EXPIRY_LITERAL || '))'
+    FROM
+        SYSCAT.COLUMNS E
+        INNER JOIN SYSCAT.COLUMNS X
+            ON E.TABSCHEMA = X.TABSCHEMA
+            AND E.TABNAME = X.TABNAME
+        CROSS JOIN (
+            VALUES
+                ('DATE', '''' || CHAR(DATE(SINCE), ISO) || '''', '''' || CHAR(DATE(SINCE) - 1 DAY, ISO) || ''''),
+                ('TIMESTAMP', '''' || CHAR(SINCE) || '''', '''' || CHAR(SINCE - 1 MICROSECOND) || '''')
+        ) AS L (TYPENAME, LITERAL, EXPIRY_LITERAL)
+    WHERE
+        E.TABSCHEMA = ASCHEMA
+        AND E.TABNAME = ATABLE
+        AND E.COLNO = 0
+        AND X.COLNO = 1
+        AND E.COLNAME LIKE 'EFFECTIVE\_%' ESCAPE '\'
+        AND X.COLNAME LIKE 'EXPIRY\_%' ESCAPE '\'
+        AND E.TYPESCHEMA = 'SYSIBM'
+        AND E.TYPENAME = L.TYPENAME
+        AND X.TYPESCHEMA = E.TYPESCHEMA
+        AND X.TYPENAME = E.TYPENAME
+        AND X.DEFAULT IS NOT NULL!
+
+CREATE FUNCTION X_EXPORT_DELTA(
+    ASCHEMA VARCHAR(128),
+    ATABLE VARCHAR(128),
+    INCLUDE_GENERATED VARCHAR(1),
+    INCLUDE_IDENTITY VARCHAR(1),
+    SINCE TIMESTAMP
+)
+    RETURNS VARCHAR(8000)
+    SPECIFIC X_EXPORT_DELTA
+    LANGUAGE SQL
+    NOT DETERMINISTIC
+    NO EXTERNAL ACTION
+    READS SQL DATA
+RETURN
+    VALUES
+        'EXPORT TO "' || RTRIM(ASCHEMA) || '.' || RTRIM(ATABLE) || '.DELTA.IXF" OF IXF ' ||
+        'SELECT ' || TABLE_COLUMNS(ASCHEMA, ATABLE, INCLUDE_GENERATED, INCLUDE_IDENTITY) || ' ' ||
+        'FROM ' || QUOTE_IDENTIFIER(ASCHEMA) || '.' || QUOTE_IDENTIFIER(ATABLE) || ' ' ||
+        'WHERE ' || X_EXPORT_SINCE(ASCHEMA, ATABLE, SINCE)!
+
+-- REFRESH_EXPORT_MANIFEST(ASCHEMA)
+-- REFRESH_EXPORT_MANIFEST()
+-------------------------------------------------------------------------------
+-- The REFRESH_EXPORT_MANIFEST procedure scans all tables in the specified
+-- schema (or the current schema if ASCHEMA is omitted), recording the row
+-- count and checksum of each in EXPORT_MANIFEST (see above). Rows for tables
+-- which no longer exist are removed from the manifest. This procedure reads
+-- every row of every ordinary table (though writes nothing but the manifest);
+-- for history tables only the latest changes are read in full.
+-------------------------------------------------------------------------------
+
+CREATE PROCEDURE REFRESH_EXPORT_MANIFEST(ASCHEMA VARCHAR(128))
+    SPECIFIC REFRESH_EXPORT_MANIFEST1
+    MODIFIES SQL DATA
+    NOT DETERMINISTIC
+    NO EXTERNAL ACTION
+    LANGUAGE SQL
+BEGIN
+    DECLARE DDL CLOB(64K) DEFAULT '';
+    DECLARE HASH_EXPR CLOB(64K) DEFAULT '';
+    DECLARE N BIGINT DEFAULT 0;
+    DECLARE TOTAL DECIMAL(31, 0) DEFAULT NULL;
+    DECLARE CHANGED TIMESTAMP DEFAULT NULL;
+    DECLARE S STATEMENT;
+    DECLARE C CURSOR FOR S;
+
+    FOR T AS
+        SELECT
+            TABNAME,
+            X_EXPORT_HASHABLE(TABSCHEMA, TABNAME) AS HASHABLE,
+            X_EXPORT_CHANGED(TABSCHEMA, TABNAME) AS CHANGED_EXPR
+        FROM SYSCAT.TABLES
+        WHERE TABSCHEMA = ASCHEMA
+        AND TYPE = 'T'
+        ORDER BY TABNAME
+    DO
+        IF T.HASHABLE = 'Y' THEN
+            -- An empty table (or empty set of changes) must hash to zero
+            -- rather than NULL, which would mark the table as unhashable
+            SET HASH_EXPR = 'COALESCE(SUM(DECIMAL('
+                || X_BUILD_ROW_HASH(ASCHEMA, T.TABNAME, ASCHEMA, T.TABNAME, '', NULL, 'S', '')
+                || ', 19, 0)), 0)';
+        ELSE
+            SET HASH_EXPR = 'CAST(NULL AS DECIMAL(31, 0))';
+        END IF;
+        -- Ordinary tables are counted and hashed in a single pass. History
+        -- tables are counted in the first pass (which also finds the latest
+        -- change), and only the rows changed at that point are hashed in the
+        -- second (an empty history table skips the second pass, so the first
+        -- hashes it to zero)
+        SET DDL = 'SELECT COUNT(*), '
+            || COALESCE(T.CHANGED_EXPR, 'CAST(NULL AS TIMESTAMP)') || ', '
+            || CASE
+                WHEN T.CHANGED_EXPR IS NULL THEN HASH_EXPR
+                WHEN T.HASHABLE = 'Y' THEN 'CAST(0 AS DECIMAL(31, 0))'
+                ELSE 'CAST(NULL AS DECIMAL(31, 0))'
+            END
+            || ' FROM ' || QUOTE_IDENTIFIER(ASCHEMA) || '.' || QUOTE_IDENTIFIER(T.TABNAME);
+        PREPARE S FROM DDL;
+        OPEN C;
+        FETCH C INTO N, CHANGED, TOTAL;
+        CLOSE C;
+        IF T.CHANGED_EXPR IS NOT NULL AND T.HASHABLE = 'Y' AND CHANGED IS NOT NULL THEN
+            SET DDL = 'SELECT ' || HASH_EXPR
+                || ' FROM ' || QUOTE_IDENTIFIER(ASCHEMA) || '.' || QUOTE_IDENTIFIER(T.TABNAME)
+                || ' WHERE ' || X_EXPORT_SINCE(ASCHEMA, T.TABNAME, CHANGED);
+            PREPARE S FROM DDL;
+            OPEN C;
+            FETCH C INTO TOTAL;
+            CLOSE C;
+        END IF;
+        MERGE INTO EXPORT_MANIFEST AS DEST
+            USING (
+                VALUES (ASCHEMA, T.TABNAME, N, TOTAL, CHANGED)
+            ) AS SRC (TABSCHEMA, TABNAME, ROW_COUNT, CHECKSUM, LAST_CHANGED)
+            ON DEST.TABSCHEMA = SRC.TABSCHEMA
+            AND DEST.TABNAME = SRC.TABNAME
+            WHEN MATCHED THEN
+                UPDATE SET
+                    SCANNED = CURRENT TIMESTAMP,
+                    ROW_COUNT = SRC.ROW_COUNT,
+                    CHECKSUM = SRC.CHECKSUM,
+                    LAST_CHANGED = SRC.LAST_CHANGED
+            WHEN NOT MATCHED THEN
+                INSERT (TABSCHEMA, TABNAME, SCANNED, ROW_COUNT, CHECKSUM, LAST_CHANGED)
+                VALUES (SRC.TABSCHEMA, SRC.TABNAME, CURRENT TIMESTAMP, SRC.ROW_COUNT, SRC.CHECKSUM, SRC.LAST_CHANGED);
+    END FOR;
+    DELETE FROM EXPORT_MANIFEST M
+        WHERE M.TABSCHEMA = ASCHEMA
+        AND NOT EXISTS (
+            SELECT 1
+            FROM SYSCAT.TABLES T
+            WHERE T.TABSCHEMA = M.TABSCHEMA
+            AND T.TABNAME = M.TABNAME
+            AND T.TYPE = 'T'
+        );
+END!
+
+CREATE PROCEDURE REFRESH_EXPORT_MANIFEST()
+    SPECIFIC REFRESH_EXPORT_MANIFEST2
+    MODIFIES SQL DATA
+    NOT DETERMINISTIC
+    NO EXTERNAL ACTION
+    LANGUAGE SQL
+BEGIN
+    CALL REFRESH_EXPORT_MANIFEST(CURRENT SCHEMA);
+END!
+
+GRANT EXECUTE ON SPECIFIC PROCEDURE REFRESH_EXPORT_MANIFEST1 TO ROLE UTILS_LOAD_USER!
+GRANT EXECUTE ON SPECIFIC PROCEDURE REFRESH_EXPORT_MANIFEST2 TO ROLE UTILS_LOAD_USER!
+GRANT EXECUTE ON SPECIFIC PROCEDURE REFRESH_EXPORT_MANIFEST1 TO ROLE UTILS_LOAD_ADMIN WITH GRANT OPTION!
+GRANT EXECUTE ON SPECIFIC PROCEDURE REFRESH_EXPORT_MANIFEST2 TO ROLE UTILS_LOAD_ADMIN WITH GRANT OPTION!
+
+COMMENT ON SPECIFIC PROCEDURE REFRESH_EXPORT_MANIFEST1
+    IS 'Records the row count and checksum of all tables in the specified schema in EXPORT_MANIFEST'!
+COMMENT ON SPECIFIC PROCEDURE REFRESH_EXPORT_MANIFEST2
+    IS 'Records the row count and checksum of all tables in the current schema in EXPORT_MANIFEST'!
+
+-- EXPORT_SCHEMA_CHANGES(ASCHEMA, INCLUDE_GENERATED, INCLUDE_IDENTITY, DELTAS)
+-- EXPORT_SCHEMA_CHANGES(INCLUDE_GENERATED, INCLUDE_IDENTITY, DELTAS)
+-- EXPORT_SCHEMA_CHANGES()
+-------------------------------------------------------------------------------
+-- This table function is the incremental equivalent of EXPORT_SCHEMA. It
+-- returns the same columns, but only for those tables in the specified schema
+-- (or the current schema if ASCHEMA is omitted) which have changed since they
+-- were last exported, according to EXPORT_MANIFEST. A table is considered
+-- changed if it has never been exported (or is missing from the manifest),
+-- if its row count, checksum, or latest history change differ from those
+-- recorded at its last export, or if it is an ordinary table which cannot be
+-- hashed. REFRESH_EXPORT_MANIFEST should be called first to bring the
+-- manifest up to date.
+--
+-- If DELTAS is 'Y', history tables which have been exported before (and have
+-- not lost any rows since) are exported as deltas: the generated EXPORT
+-- command targets a file named like "DATAMART.COUNTRIES.DELTA.IXF" and
+-- includes only those rows which became effective or expired on or after the
+-- latest change recorded at the last export. This overlaps the previous
+-- export by one history period, so deltas should be merged (not loaded) into
+-- the target. RUN_LOAD_SCHEMA only loads full exports (replacing the content
+-- of each table) and ignores delta files; apply a delta with IMPORT ...
+-- INSERT_UPDATE instead, which updates the rows matching the target's primary
+-- key and inserts the rest. DELTAS defaults to 'N', and INCLUDE_GENERATED and
+-- INCLUDE_IDENTITY default to 'Y' as for EXPORT_SCHEMA.
+--
+-- Once the generated commands have been run successfully, call MARK_EXPORTED
+-- for each table to record the export in the manifest (RUN_EXPORT_SCHEMA does
+-- this automatically for incremental exports).
+-------------------------------------------------------------------------------
+
+CREATE FUNCTION EXPORT_SCHEMA_CHANGES(
+    ASCHEMA VARCHAR(128),
+    INCLUDE_GENERATED VARCHAR(1),
+    INCLUDE_IDENTITY VARCHAR(1),
+    DELTAS VARCHAR(1)
+)
+    RETURNS TABLE(
+        TABSCHEMA VARCHAR(128),
+        TABNAME VARCHAR(128),
+        SQL VARCHAR(8000)
+    )
+    SPECIFIC EXPORT_SCHEMA_CHANGES1
+    LANGUAGE SQL
+    NOT DETERMINISTIC
+    NO EXTERNAL ACTION
+    READS SQL DATA
+RETURN
+    SELECT
+        T.TABSCHEMA,
+        T.TABNAME,
+        COALESCE(
+            CASE
+                WHEN DELTAS = 'Y'
+                AND M.EXPORTED_CHANGED IS NOT NULL
+                AND M.ROW_COUNT >= M.EXPORTED_ROWS
+                    THEN X_EXPORT_DELTA(T.TABSCHEMA, T.TABNAME, INCLUDE_GENERATED, INCLUDE_IDENTITY, M.EXPORTED_CHANGED)
+            END,
+            EXPORT_TABLE(T.TABSCHEMA, T.TABNAME, INCLUDE_GENERATED, INCLUDE_IDENTITY)
+        ) AS SQL
+    FROM
+        SYSCAT.TABLES T
+        LEFT OUTER JOIN EXPORT_MANIFEST M
+            ON T.TABSCHEMA = M.TABSCHEMA
+            AND T.TABNAME = M.TABNAME
+    WHERE
+        T.TABSCHEMA = ASCHEMA
+        AND T.TYPE = 'T'
+        AND (
+            M.EXPORTED IS NULL
+            OR M.ROW_COUNT <> M.EXPORTED_ROWS
+            OR COALESCE(M.LAST_CHANGED, TIMESTAMP('0001-01-01-00.00.00')) <> COALESCE(M.EXPORTED_CHANGED, TIMESTAMP('0001-01-01-00.00.00'))
+            OR (M.CHECKSUM IS NULL AND M.LAST_CHANGED IS NULL)
+            OR M.CHECKSUM <> M.EXPORTED_CHECKSUM
+        )!
+
+CREATE FUNCTION EXPORT_SCHEMA_CHANGES(
+    INCLUDE_GENERATED VARCHAR(1),
+    INCLUDE_IDENTITY VARCHAR(1),
+    DELTAS VARCHAR(1)
+)
+    RETURNS TABLE(
+        TABSCHEMA VARCHAR(128),
+        TABNAME VARCHAR(128),
+        SQL VARCHAR(8000)
+    )
+    SPECIFIC EXPORT_SCHEMA_CHANGES2
+    LANGUAGE SQL
+    NOT DETERMINISTIC
+    NO EXTERNAL ACTION
+    READS SQL DATA
+RETURN
+    SELECT *
+    FROM TABLE(EXPORT_SCHEMA_CHANGES(CURRENT SCHEMA, INCLUDE_GENERATED, INCLUDE_IDENTITY, DELTAS)) AS T!
+
+CREATE FUNCTION EXPORT_SCHEMA_CHANGES()
+    RETURNS TABLE(
+        TABSCHEMA VARCHAR(128),
+        TABNAME VARCHAR(128),
+        SQL VARCHAR(8000)
+    )
+    SPECIFIC EXPORT_SCHEMA_CHANGES3
+    LANGUAGE SQL
+    NOT DETERMINISTIC
+    NO EXTERNAL ACTION
+    READS SQL DATA
+RETURN
+    SELECT *
+    FROM TABLE(EXPORT_SCHEMA_CHANGES(CURRENT SCHEMA, 'Y', 'Y', 'N')) AS T!
+
+GRANT EXECUTE ON SPECIFIC FUNCTION EXPORT_SCHEMA_CHANGES1 TO ROLE UTILS_LOAD_USER!
+GRANT EXECUTE ON SPECIFIC FUNCTION EXPORT_SCHEMA_CHANGES2 TO ROLE UTILS_LOAD_USER!
+GRANT EXECUTE ON SPECIFIC FUNCTION EXPORT_SCHEMA_CHANGES3 TO ROLE UTILS_LOAD_USER!
+GRANT EXECUTE ON SPECIFIC FUNCTION EXPORT_SCHEMA_CHANGES1 TO ROLE UTILS_LOAD_ADMIN WITH GRANT OPTION!
+GRANT EXECUTE ON SPECIFIC FUNCTION EXPORT_SCHEMA_CHANGES2 TO ROLE UTILS_LOAD_ADMIN WITH GRANT OPTION!
+GRANT EXECUTE ON SPECIFIC FUNCTION EXPORT_SCHEMA_CHANGES3 TO ROLE UTILS_LOAD_ADMIN WITH GRANT OPTION!
+
+COMMENT ON SPECIFIC FUNCTION EXPORT_SCHEMA_CHANGES1
+    IS 'Generates EXPORT commands for all tables in the specified schema which have changed since they were last exported'!
+COMMENT ON SPECIFIC FUNCTION EXPORT_SCHEMA_CHANGES2
+    IS 'Generates EXPORT commands for all tables in the current schema which have changed since they were last exported'!
+COMMENT ON SPECIFIC FUNCTION EXPORT_SCHEMA_CHANGES3
+    IS 'Generates EXPORT commands for all tables in the current schema which have changed since they were last exported'!
+
+-- MARK_EXPORTED(ASCHEMA, ATABLE)
+-- MARK_EXPORTED(ATABLE)
+-------------------------------------------------------------------------------
+-- The MARK_EXPORTED procedure records in EXPORT_MANIFEST that the specified
+-- table (in the current schema if ASCHEMA is omitted) has been exported in
+-- the state it was in when REFRESH_EXPORT_MANIFEST last scanned it. The table
+-- will then be excluded by EXPORT_SCHEMA_CHANGES until it changes again.
+-------------------------------------------------------------------------------
+
+CREATE PROCEDURE MARK_EXPORTED(ASCHEMA VARCHAR(128), ATABLE VARCHAR(128))
+    SPECIFIC MARK_EXPORTED1
+    MODIFIES SQL DATA
+    NOT DETERMINISTIC
+    NO EXTERNAL ACTION
+    LANGUAGE SQL
+BEGIN ATOMIC
+    UPDATE EXPORT_MANIFEST
+        SET
+            EXPORTED = SCANNED,
+            EXPORTED_ROWS = ROW_COUNT,
+            EXPORTED_CHECKSUM = CHECKSUM,
+            EXPORTED_CHANGED = LAST_CHANGED
+        WHERE TABSCHEMA = ASCHEMA
+        AND TABNAME = ATABLE;
+END!
+
+CREATE PROCEDURE MARK_EXPORTED(ATABLE VARCHAR(128))
+    SPECIFIC MARK_EXPORTED2
+    MODIFIES SQL DATA
+    NOT DETERMINISTIC
+    NO EXTERNAL ACTION
+    LANGUAGE SQL
+BEGIN ATOMIC
+    CALL MARK_EXPORTED(CURRENT SCHEMA, ATABLE);
+END!
+
+GRANT EXECUTE ON SPECIFIC PROCEDURE MARK_EXPORTED1 TO ROLE UTILS_LOAD_USER!
+GRANT EXECUTE ON SPECIFIC PROCEDURE MARK_EXPORTED2 TO ROLE UTILS_LOAD_USER!
+GRANT EXECUTE ON SPECIFIC PROCEDURE MARK_EXPORTED1 TO ROLE UTILS_LOAD_ADMIN WITH GRANT OPTION!
+GRANT EXECUTE ON SPECIFIC PROCEDURE MARK_EXPORTED2 TO ROLE UTILS_LOAD_ADMIN WITH GRANT OPTION!
+
+COMMENT ON SPECIFIC PROCEDURE MARK_EXPORTED1
+    IS 'Records in EXPORT_MANIFEST that the specified table has been exported as last scanned'!
+COMMENT ON SPECIFIC PROCEDURE MARK_EXPORTED2
+    IS 'Records in EXPORT_MANIFEST that the specified table has been exported as last scanned'!
+
 -- LOAD_TABLE(ASCHEMA, ATABLE, INCLUDE_GENERATED, INCLUDE_IDENTITY)
 -- LOAD_TABLE(ATABLE, INCLUDE_GENERATED, INCLUDE_IDENTITY)
 -- LOAD_TABLE(ATABLE)
@@ -513,4 +1000,676 @@ COMMENT ON SPECIFIC FUNCTION LOAD_SCHEMA2
 COMMENT ON SPECIFIC FUNCTION LOAD_SCHEMA3
     IS 'Generates LOAD commands for all tables in the specified schema, including or excluding generated and/or identity columns as requested'!
 
+-- EXPORT_LOAD_JOBS
+-------------------------------------------------------------------------------
+-- The EXPORT_LOAD_JOBS table is the work queue for the RUN_EXPORT_SCHEMA and
+-- RUN_LOAD_SCHEMA procedures below, and records the outcome of each job once
+-- it has run. There is one row for each table in each run (identified by
+-- RUN_ID), and the jobs of each DEPTH are run in JOB_ID order. OPERATION is
+-- 'E' for an export or 'L' for a load, and COMMAND is the command executed by
+-- ADMIN_CMD. DEPTH is the length of the longest chain of foreign keys from the
+-- table to a parent in the same schema (always 0 for exports); no job is
+-- started until all jobs with a lower DEPTH have finished.
+--
+-- STATUS is 'W' while the job is waiting to run, 'R' while it is running, 'C'
+-- once it has completed, and 'F' if it failed (in which case ERROR_STATE and
+-- ERROR_TEXT describe the error). WORKER is the application handle of the
+-- session which queued the job while it is waiting, and of the worker which
+-- claimed it thereafter. ROWS_READ, ROWS_WRITTEN (the number of rows exported
+-- or loaded) and ROWS_REJECTED are taken from the result of ADMIN_CMD. BYTES
+-- is an estimate of the data moved by the job (ROWS_WRITTEN multiplied by the
+-- average row size of the table from the catalog, hence NULL if the table has
+-- no statistics), and ELAPSED is the time taken by the job in seconds.
+-------------------------------------------------------------------------------
+
+CREATE TABLE EXPORT_LOAD_JOBS (
+    RUN_ID        INTEGER NOT NULL,
+    JOB_ID        INTEGER NOT NULL,
+    OPERATION     CHAR(1) NOT NULL,
+    TABSCHEMA     VARCHAR(128) NOT NULL,
+    TABNAME       VARCHAR(128) NOT NULL,
+    DEPTH         SMALLINT DEFAULT 0 NOT NULL,
+    COMMAND       VARCHAR(8000) NOT NULL,
+    STATUS        CHAR(1) DEFAULT 'W' NOT NULL,
+    WORKER        BIGINT DEFAULT NULL,
+    ROWS_READ     BIGINT DEFAULT NULL,
+    ROWS_WRITTEN  BIGINT DEFAULT NULL,
+    ROWS_REJECTED BIGINT DEFAULT NULL,
+    BYTES         BIGINT DEFAULT NULL,
+    STARTED       TIMESTAMP DEFAULT NULL,
+    COMPLETED     TIMESTAMP DEFAULT NULL,
+    ELAPSED       DECIMAL(18, 6) DEFAULT NULL,
+    ERROR_STATE   CHAR(5) DEFAULT NULL,
+    ERROR_TEXT    VARCHAR(1000) DEFAULT NULL
+)!
+
+CREATE UNIQUE INDEX EXPORT_LOAD_JOBS_PK
+    ON EXPORT_LOAD_JOBS (RUN_ID, JOB_ID)!
+
+CREATE INDEX EXPORT_LOAD_JOBS_X1
+    ON EXPORT_LOAD_JOBS (RUN_ID, STATUS, DEPTH)!
+
+ALTER TABLE EXPORT_LOAD_JOBS
+    ADD CONSTRAINT PK PRIMARY KEY (RUN_ID, JOB_ID)
+    ADD CONSTRAINT OPERATION_CK CHECK (OPERATION IN ('E', 'L'))
+    ADD CONSTRAINT STATUS_CK CHECK (STATUS IN ('W', 'R', 'C', 'F'))!
+
+GRANT CONTROL ON TABLE EXPORT_LOAD_JOBS TO ROLE UTILS_LOAD_ADMIN WITH GRANT OPTION!
+GRANT SELECT ON TABLE EXPORT_LOAD_JOBS TO ROLE UTILS_LOAD_USER!
+
+COMMENT ON TABLE EXPORT_LOAD_JOBS
+    IS 'Work queue and per-table statistics of the RUN_EXPORT_SCHEMA and RUN_LOAD_SCHEMA procedures'!
+
+-- X_SERVER_COMMAND(COMMAND, DIRECTORY)
+-- X_EXPORT_LOAD_JOB(ARUN_ID, AJOB_ID)
+-------------------------------------------------------------------------------
+-- These routines are effectively private utility subroutines for the
+-- procedures defined below. X_SERVER_COMMAND prefixes the (quoted) filename
+-- in an EXPORT or LOAD command generated by EXPORT_TABLE or LOAD_TABLE with
+-- DIRECTORY (if it is not blank); ADMIN_CMD runs commands on the server so
+-- files must be given a path on the server.
+--
+-- X_EXPORT_LOAD_JOB runs the command of the specified job (which must have
+-- been claimed by the caller) with ADMIN_CMD and records the result in
+-- EXPORT_LOAD_JOBS. After a load, if the table has been placed in set
+-- integrity pending state it is checked immediately (any parents have
+-- already been loaded and checked as they have a lower DEPTH). Errors are
+-- recorded against the job rather than raised.
+-------------------------------------------------------------------------------
+
+CREATE FUNCTION X_SERVER_COMMAND(
+    COMMAND VARCHAR(8000),
+    DIRECTORY VARCHAR(1000)
+)
+    RETURNS VARCHAR(8000)
+    SPECIFIC X_SERVER_COMMAND
+    LANGUAGE SQL
+    DETERMINISTIC
+    NO EXTERNAL ACTION
+    CONTAINS SQL
+RETURN
+    CASE WHEN COALESCE(DIRECTORY, '') = ''
+        THEN COMMAND
+        ELSE INSERT(COMMAND, LOCATE('"', COMMAND) + 1, 0,
+            DIRECTORY || CASE WHEN RIGHT(DIRECTORY, 1) = '/' THEN '' ELSE '/' END)
+    END!
+
+CREATE PROCEDURE X_EXPORT_LOAD_JOB(ARUN_ID INTEGER, AJOB_ID INTEGER)
+    SPECIFIC X_EXPORT_LOAD_JOB
+    MODIFIES SQL DATA
+    NOT DETERMINISTIC
+    NO EXTERNAL ACTION
+    LANGUAGE SQL
+BEGIN
+    DECLARE SQLSTATE CHAR(5) DEFAULT '00000';
+    DECLARE SQLCODE INTEGER DEFAULT 0;
+    DECLARE JOB_OPERATION CHAR(1) DEFAULT '';
+    DECLARE JOB_SCHEMA VARCHAR(128) DEFAULT '';
+    DECLARE JOB_TABLE VARCHAR(128) DEFAULT '';
+    DECLARE JOB_COMMAND VARCHAR(8000) DEFAULT '';
+    DECLARE JOB_START TIMESTAMP DEFAULT NULL;
+    DECLARE JOB_END TIMESTAMP DEFAULT NULL;
+    DECLARE ERR_STATE CHAR(5) DEFAULT NULL;
+    DECLARE ERR_TEXT VARCHAR(32672) DEFAULT NULL;
+    DECLARE N_READ BIGINT DEFAULT NULL;
+    DECLARE N_SKIPPED BIGINT DEFAULT NULL;
+    DECLARE N_WRITTEN BIGINT DEFAULT NULL;
+    DECLARE N_REJECTED BIGINT DEFAULT NULL;
+    DECLARE N_DELETED BIGINT DEFAULT NULL;
+    DECLARE N_COMMITTED BIGINT DEFAULT NULL;
+    DECLARE N_PARTITIONED BIGINT DEFAULT NULL;
+    DECLARE N_AGENTINFO BIGINT DEFAULT NULL;
+    DECLARE N_BYTES BIGINT DEFAULT NULL;
+    DECLARE MSG_RETRIEVAL VARCHAR(512) DEFAULT NULL;
+    DECLARE MSG_REMOVAL VARCHAR(512) DEFAULT NULL;
+    DECLARE RESULT RESULT_SET_LOCATOR VARYING;
+
+    SELECT OPERATION, TABSCHEMA, TABNAME, COMMAND
+        INTO JOB_OPERATION, JOB_SCHEMA, JOB_TABLE, JOB_COMMAND
+        FROM EXPORT_LOAD_JOBS
+        WHERE RUN_ID = ARUN_ID
+        AND JOB_ID = AJOB_ID;
+    SET JOB_START = CURRENT TIMESTAMP;
+    -- The inner handler captures the full text of the error (including its
+    -- tokens, which SQLERRM can't reproduce from the SQLCODE alone) before
+    -- re-raising it for the outer handler to capture the SQLSTATE
+    BEGIN
+        DECLARE EXIT HANDLER FOR SQLEXCEPTION
+            SET ERR_STATE = SQLSTATE;
+        BEGIN
+            DECLARE EXIT HANDLER FOR SQLEXCEPTION
+                BEGIN
+                    GET DIAGNOSTICS EXCEPTION 1 ERR_TEXT = MESSAGE_TEXT;
+                    RESIGNAL;
+                END;
+            CALL SYSPROC.ADMIN_CMD(JOB_COMMAND);
+            ASSOCIATE RESULT SET LOCATOR (RESULT) WITH PROCEDURE SYSPROC.ADMIN_CMD;
+            IF JOB_OPERATION = 'E' THEN
+                ALLOCATE EXPORT_CUR CURSOR FOR RESULT SET RESULT;
+                FETCH EXPORT_CUR INTO N_WRITTEN, MSG_RETRIEVAL, MSG_REMOVAL;
+                CLOSE EXPORT_CUR;
+                SET N_READ = N_WRITTEN;
+            ELSE
+                ALLOCATE LOAD_CUR CURSOR FOR RESULT SET RESULT;
+                FETCH LOAD_CUR INTO
+                    N_READ, N_SKIPPED, N_WRITTEN, N_REJECTED, N_DELETED,
+                    N_COMMITTED, N_PARTITIONED, N_AGENTINFO, MSG_RETRIEVAL, MSG_REMOVAL;
+                CLOSE LOAD_CUR;
+                IF EXISTS (
+                    SELECT 1
+                    FROM SYSCAT.TABLES
+                    WHERE TABSCHEMA = JOB_SCHEMA
+                    AND TABNAME = JOB_TABLE
+                    AND STATUS = 'C'
+                ) THEN
+                    EXECUTE IMMEDIATE
+                        'SET INTEGRITY FOR ' || QUOTE_IDENTIFIER(JOB_SCHEMA) || '.' || QUOTE_IDENTIFIER(JOB_TABLE)
+                        || ' IMMEDIATE CHECKED';
+                END IF;
+            END IF;
+        END;
+    END;
+    SET JOB_END = CURRENT TIMESTAMP;
+    SET N_BYTES = (
+        SELECT N_WRITTEN * AVGROWSIZE
+        FROM SYSCAT.TABLES
+        WHERE TABSCHEMA = JOB_SCHEMA
+        AND TABNAME = JOB_TABLE
+        AND AVGROWSIZE > 0
+    );
+    UPDATE EXPORT_LOAD_JOBS
+        SET
+            STATUS = CASE WHEN ERR_STATE IS NULL THEN 'C' ELSE 'F' END,
+            ROWS_READ = N_READ,
+            ROWS_WRITTEN = N_WRITTEN,
+            ROWS_REJECTED = N_REJECTED,
+            BYTES = N_BYTES,
+            COMPLETED = JOB_END,
+            ELAPSED = (SECONDS(JOB_END) - SECONDS(JOB_START))
+                + (MICROSECOND(JOB_END) - MICROSECOND(JOB_START)) / 1000000.0,
+            ERROR_STATE = ERR_STATE,
+            ERROR_TEXT = CASE WHEN ERR_STATE IS NULL THEN NULL ELSE LEFT(COALESCE(ERR_TEXT, ''), 1000) END
+        WHERE RUN_ID = ARUN_ID
+        AND JOB_ID = AJOB_ID;
+END!
+
+-- EXPORT_LOAD_WORKER(ARUN_ID)
+-- EXPORT_LOAD_WORKER()
+-------------------------------------------------------------------------------
+-- EXPORT_LOAD_WORKER runs the jobs of the specified run of RUN_EXPORT_SCHEMA
+-- or RUN_LOAD_SCHEMA (in EXPORT_LOAD_JOBS), returning when all jobs in the
+-- run have finished. Several workers may run concurrently (in separate
+-- sessions), each claiming the next waiting job with the lowest DEPTH and
+-- committing after each job. When all waiting jobs at the lowest DEPTH have
+-- been claimed, workers wait for those running to finish before starting the
+-- next DEPTH.
+--
+-- RUN_EXPORT_SCHEMA and RUN_LOAD_SCHEMA run a worker in the calling session;
+-- this procedure is called from additional sessions to run jobs in parallel.
+-- If ARUN_ID is omitted, the procedure waits (for up to an hour) for a run to
+-- be queued by a session which is still connected, and joins the latest such
+-- run. Hence the additional sessions can be started at the same time as the
+-- session calling RUN_EXPORT_SCHEMA or RUN_LOAD_SCHEMA, as the export_schema
+-- and load_schema targets of the Makefile do.
+-------------------------------------------------------------------------------
+
+CREATE PROCEDURE EXPORT_LOAD_WORKER(ARUN_ID INTEGER)
+    SPECIFIC EXPORT_LOAD_WORKER1
+    MODIFIES SQL DATA
+    NOT DETERMINISTIC
+    NO EXTERNAL ACTION
+    LANGUAGE SQL
+BEGIN
+    DECLARE ME BIGINT DEFAULT NULL;
+    DECLARE ALERT_NAME VARCHAR(128) DEFAULT '';
+    DECLARE ALERT_MESSAGE VARCHAR(32672) DEFAULT '';
+    DECLARE ALERT_STATUS INTEGER DEFAULT 0;
+    DECLARE REMAINING INTEGER DEFAULT 0;
+    DECLARE CLAIMED INTEGER DEFAULT 0;
+    DECLARE NEXT_DEPTH SMALLINT DEFAULT NULL;
+    DECLARE NEXT_JOB INTEGER DEFAULT NULL;
+
+    SET ME = MON_GET_APPLICATION_HANDLE();
+    SET ALERT_NAME = 'EXPORT_LOAD_' || VARCHAR(ARUN_ID);
+    CALL DBMS_ALERT.REGISTER(ALERT_NAME);
+    COMMIT;
+    SET REMAINING = (
+        SELECT COUNT(*)
+        FROM EXPORT_LOAD_JOBS
+        WHERE RUN_ID = ARUN_ID
+        AND STATUS IN ('W', 'R')
+    );
+    WHILE REMAINING > 0 DO
+        SET NEXT_DEPTH = (
+            SELECT MIN(DEPTH)
+            FROM EXPORT_LOAD_JOBS
+            WHERE RUN_ID = ARUN_ID
+            AND STATUS IN ('W', 'R')
+        );
+        SET NEXT_JOB = (
+            SELECT MIN(JOB_ID)
+            FROM EXPORT_LOAD_JOBS
+            WHERE RUN_ID = ARUN_ID
+            AND STATUS = 'W'
+            AND DEPTH = NEXT_DEPTH
+        );
+        IF NEXT_JOB IS NULL THEN
+            -- Everything at this depth is running in other workers. Fail any
+            -- jobs abandoned by workers that have disconnected, then wait for
+            -- a job to complete (or a few seconds, whichever comes first)
+            UPDATE EXPORT_LOAD_JOBS
+                SET
+                    STATUS = 'F',
+                    COMPLETED = CURRENT TIMESTAMP,
+                    ERROR_TEXT = 'Worker disconnected before completing the job'
+                WHERE RUN_ID = ARUN_ID
+                AND STATUS = 'R'
+                AND NOT EXISTS (
+                    SELECT 1
+                    FROM TABLE(MON_GET_CONNECTION(WORKER, -2)) AS C
+                );
+            COMMIT;
+            CALL DBMS_ALERT.WAITONE(ALERT_NAME, ALERT_MESSAGE, ALERT_STATUS, 5);
+        ELSE
+            -- Claim the job; if another worker beat us to it, the update
+            -- affects no rows and we just go round again
+            UPDATE EXPORT_LOAD_JOBS
+                SET
+                    STATUS = 'R',
+                    WORKER = ME,
+                    STARTED = CURRENT TIMESTAMP
+                WHERE RUN_ID = ARUN_ID
+                AND JOB_ID = NEXT_JOB
+                AND STATUS = 'W';
+            GET DIAGNOSTICS CLAIMED = ROW_COUNT;
+            COMMIT;
+            IF CLAIMED = 1 THEN
+                CALL X_EXPORT_LOAD_JOB(ARUN_ID, NEXT_JOB);
+                CALL DBMS_ALERT.SIGNAL(ALERT_NAME, VARCHAR(NEXT_JOB));
+                COMMIT;
+            END IF;
+        END IF;
+        SET REMAINING = (
+            SELECT COUNT(*)
+            FROM EXPORT_LOAD_JOBS
+            WHERE RUN_ID = ARUN_ID
+            AND STATUS IN ('W', 'R')
+        );
+    END WHILE;
+    CALL DBMS_ALERT.REMOVE(ALERT_NAME);
+    COMMIT;
+END!
+
+CREATE PROCEDURE EXPORT_LOAD_WORKER()
+    SPECIFIC EXPORT_LOAD_WORKER2
+    MODIFIES SQL DATA
+    NOT DETERMINISTIC
+    NO EXTERNAL ACTION
+    LANGUAGE SQL
+BEGIN
+    DECLARE RUN INTEGER DEFAULT NULL;
+    DECLARE GIVE_UP TIMESTAMP DEFAULT NULL;
+    DECLARE ALERT_MESSAGE VARCHAR(32672) DEFAULT '';
+    DECLARE ALERT_STATUS INTEGER DEFAULT 0;
+
+    -- Register for the alert signalled by X_EXPORT_LOAD_RUN before looking
+    -- for a run, so that a run queued after the search isn't missed
+    SET GIVE_UP = CURRENT TIMESTAMP + 1 HOUR;
+    CALL DBMS_ALERT.REGISTER('EXPORT_LOAD_RUNS');
+    COMMIT;
+    WHILE RUN IS NULL AND CURRENT TIMESTAMP < GIVE_UP DO
+        -- Runs abandoned by a session which has since disconnected are
+        -- ignored; the session which queued a run is its first worker
+        SET RUN = (
+            SELECT MAX(J.RUN_ID)
+            FROM EXPORT_LOAD_JOBS J
+            WHERE J.STATUS = 'W'
+            AND EXISTS (
+                SELECT 1
+                FROM
+                    EXPORT_LOAD_JOBS L,
+                    TABLE(MON_GET_CONNECTION(L.WORKER, -2)) AS C
+                WHERE L.RUN_ID = J.RUN_ID
+                AND L.STATUS IN ('W', 'R')
+            )
+        );
+        IF RUN IS NULL THEN
+            CALL DBMS_ALERT.WAITONE('EXPORT_LOAD_RUNS', ALERT_MESSAGE, ALERT_STATUS, 5);
+        END IF;
+    END WHILE;
+    CALL DBMS_ALERT.REMOVE('EXPORT_LOAD_RUNS');
+    COMMIT;
+    IF RUN IS NOT NULL THEN
+        CALL EXPORT_LOAD_WORKER(RUN);
+    END IF;
+END!
+
+GRANT EXECUTE ON SPECIFIC PROCEDURE EXPORT_LOAD_WORKER1 TO ROLE UTILS_LOAD_USER!
+GRANT EXECUTE ON SPECIFIC PROCEDURE EXPORT_LOAD_WORKER2 TO ROLE UTILS_LOAD_USER!
+GRANT EXECUTE ON SPECIFIC PROCEDURE EXPORT_LOAD_WORKER1 TO ROLE UTILS_LOAD_ADMIN WITH GRANT OPTION!
+GRANT EXECUTE ON SPECIFIC PROCEDURE EXPORT_LOAD_WORKER2 TO ROLE UTILS_LOAD_ADMIN WITH GRANT OPTION!
+
+COMMENT ON SPECIFIC PROCEDURE EXPORT_LOAD_WORKER1
+    IS 'Runs the jobs of the specified run of RUN_EXPORT_SCHEMA or RUN_LOAD_SCHEMA, returning when all jobs have finished'!
+COMMENT ON SPECIFIC PROCEDURE EXPORT_LOAD_WORKER2
+    IS 'Waits for a run of RUN_EXPORT_SCHEMA or RUN_LOAD_SCHEMA to be queued, then runs its jobs, returning when all jobs have finished'!
+
+-- X_EXPORT_LOAD_RUN(AOPERATION, ASCHEMA, DIRECTORY, INCLUDE_GENERATED, INCLUDE_IDENTITY, INCREMENTAL)
+-------------------------------------------------------------------------------
+-- X_EXPORT_LOAD_RUN is the private implementation of RUN_EXPORT_SCHEMA
+-- (AOPERATION = 'E') and RUN_LOAD_SCHEMA (AOPERATION = 'L'). It queues a job
+-- for each table in ASCHEMA in EXPORT_LOAD_JOBS under a new RUN_ID, ordered by
+-- foreign key depth (for loads), then by size (largest first, so that the
+-- longest jobs don't end up running alone at the end of a depth), commits,
+-- and signals the EXPORT_LOAD_RUNS alert to wake any workers waiting for a
+-- run in other sessions. It then runs a worker itself, returning when all
+-- jobs have finished.
+--
+-- If INCREMENTAL is 'Y' or 'D', EXPORT_MANIFEST is refreshed first, only
+-- those tables returned by EXPORT_SCHEMA_CHANGES (with DELTAS = 'Y' in the
+-- case of 'D') are queued, and the manifest is updated for each export that
+-- completes.
+-------------------------------------------------------------------------------
+
+CREATE PROCEDURE X_EXPORT_LOAD_RUN(
+    AOPERATION CHAR(1),
+    ASCHEMA VARCHAR(128),
+    DIRECTORY VARCHAR(1000),
+    INCLUDE_GENERATED VARCHAR(1),
+    INCLUDE_IDENTITY VARCHAR(1),
+    INCREMENTAL CHAR(1)
+)
+    SPECIFIC X_EXPORT_LOAD_RUN
+    MODIFIES SQL DATA
+    NOT DETERMINISTIC
+    NO EXTERNAL ACTION
+    LANGUAGE SQL
+BEGIN
+    DECLARE RUN INTEGER DEFAULT 0;
+    DECLARE PASSES INTEGER DEFAULT 0;
+    DECLARE CHANGED INTEGER DEFAULT 0;
+
+    IF INCREMENTAL IS NULL OR INCREMENTAL NOT IN ('N', 'Y', 'D') THEN
+        CALL SIGNAL_STATE(LOAD_INCREMENTAL_STATE, 'INCREMENTAL must be N, Y, or D');
+    END IF;
+
+    IF INCREMENTAL <> 'N' THEN
+        CALL REFRESH_EXPORT_MANIFEST(ASCHEMA);
+        COMMIT;
+    END IF;
+
+    LOCK TABLE EXPORT_LOAD_JOBS IN EXCLUSIVE MODE;
+    SET RUN = COALESCE((SELECT MAX(RUN_ID) FROM EXPORT_LOAD_JOBS), 0) + 1;
+    INSERT INTO EXPORT_LOAD_JOBS (RUN_ID, JOB_ID, OPERATION, TABSCHEMA, TABNAME, DEPTH, COMMAND, WORKER)
+        SELECT
+            RUN,
+            ROW_NUMBER() OVER (ORDER BY T.NPAGES DESC, T.TABNAME),
+            AOPERATION,
+            T.TABSCHEMA,
+            T.TABNAME,
+            0,
+            X_SERVER_COMMAND(
+                CASE AOPERATION
+                    WHEN 'E' THEN COALESCE(C.SQL, EXPORT_TABLE(T.TABSCHEMA, T.TABNAME, INCLUDE_GENERATED, INCLUDE_IDENTITY))
+                    ELSE LOAD_TABLE(T.TABSCHEMA, T.TABNAME, INCLUDE_GENERATED, INCLUDE_IDENTITY)
+                END, DIRECTORY),
+            MON_GET_APPLICATION_HANDLE()
+        FROM
+            SYSCAT.TABLES T
+            LEFT OUTER JOIN TABLE(
+                EXPORT_SCHEMA_CHANGES(ASCHEMA, INCLUDE_GENERATED, INCLUDE_IDENTITY,
+                    CASE INCREMENTAL WHEN 'D' THEN 'Y' ELSE 'N' END)
+            ) AS C
+                ON INCREMENTAL <> 'N'
+                AND C.TABNAME = T.TABNAME
+        WHERE
+            T.TABSCHEMA = ASCHEMA
+            AND T.TYPE = 'T'
+            AND (INCREMENTAL = 'N' OR C.TABNAME IS NOT NULL);
+    -- For loads, the depth of each table is the longest chain of foreign keys
+    -- to it from a parent in the run. Rather than enumerating every chain
+    -- (which grows exponentially with the number of foreign keys), the depths
+    -- are computed iteratively: each pass sets the depth of every table to one
+    -- more than the deepest of its parents, until nothing changes. Self
+    -- referencing keys are ignored, and the number of passes is limited to the
+    -- number of tables to guard against cycles of foreign keys (which can't be
+    -- ordered anyway)
+    IF AOPERATION = 'L' THEN
+        SET PASSES = (SELECT COUNT(*) FROM EXPORT_LOAD_JOBS WHERE RUN_ID = RUN);
+        SET CHANGED = 1;
+        WHILE CHANGED > 0 AND PASSES > 0 DO
+            UPDATE EXPORT_LOAD_JOBS C
+                SET DEPTH = (
+                    SELECT MAX(P.DEPTH) + 1
+                    FROM
+                        EXPORT_LOAD_JOBS P
+                        INNER JOIN SYSCAT.REFERENCES R
+                            ON R.REFTABSCHEMA = P.TABSCHEMA
+                            AND R.REFTABNAME = P.TABNAME
+                    WHERE
+                        P.RUN_ID = RUN
+                        AND R.TABSCHEMA = C.TABSCHEMA
+                        AND R.TABNAME = C.TABNAME
+                        AND R.TABNAME <> R.REFTABNAME
+                )
+                WHERE C.RUN_ID = RUN
+                AND EXISTS (
+                    SELECT 1
+                    FROM
+                        EXPORT_LOAD_JOBS P
+                        INNER JOIN SYSCAT.REFERENCES R
+                            ON R.REFTABSCHEMA = P.TABSCHEMA
+                            AND R.REFTABNAME = P.TABNAME
+                    WHERE
+                        P.RUN_ID = RUN
+                        AND R.TABSCHEMA = C.TABSCHEMA
+                        AND R.TABNAME = C.TABNAME
+                        AND R.TABNAME <> R.REFTABNAME
+                        AND P.DEPTH >= C.DEPTH
+                );
+            GET DIAGNOSTICS CHANGED = ROW_COUNT;
+            SET PASSES = PASSES - 1;
+        END WHILE;
+    END IF;
+    COMMIT;
+    CALL DBMS_ALERT.SIGNAL('EXPORT_LOAD_RUNS', VARCHAR(RUN));
+    COMMIT;
+
+    CALL EXPORT_LOAD_WORKER(RUN);
+
+    IF INCREMENTAL <> 'N' THEN
+        FOR J AS
+            SELECT TABSCHEMA, TABNAME
+            FROM EXPORT_LOAD_JOBS
+            WHERE RUN_ID = RUN
+            AND STATUS = 'C'
+        DO
+            CALL MARK_EXPORTED(J.TABSCHEMA, J.TABNAME);
+        END FOR;
+        COMMIT;
+    END IF;
+END!
+
+-- RUN_EXPORT_SCHEMA(ASCHEMA, DIRECTORY, INCLUDE_GENERATED, INCLUDE_IDENTITY, INCREMENTAL)
+-- RUN_EXPORT_SCHEMA(ASCHEMA, DIRECTORY, INCLUDE_GENERATED, INCLUDE_IDENTITY)
+-- RUN_EXPORT_SCHEMA(ASCHEMA, DIRECTORY)
+-- RUN_EXPORT_SCHEMA(DIRECTORY)
+-------------------------------------------------------------------------------
+-- The RUN_EXPORT_SCHEMA procedure executes the EXPORT commands generated by
+-- the EXPORT_SCHEMA function with ADMIN_CMD. The exported files are written
+-- to DIRECTORY on the server (which must be writeable by the instance owner).
+-- The procedure returns when all exports have finished, and commits after
+-- each one.
+--
+-- The calling session runs the exports one at a time. To run several at once,
+-- call EXPORT_LOAD_WORKER from additional sessions; each joins the run and
+-- runs exports alongside the caller. The export_schema target of the Makefile
+-- does this, starting PARALLELISM - 1 extra sessions with the command line
+-- processor.
+--
+-- The outcome of each export, including the number of rows, the size of the
+-- table, and the time taken, is recorded in the EXPORT_LOAD_JOBS table under
+-- a new RUN_ID. Failed exports are recorded there rather than raising an
+-- error.
+--
+-- If INCREMENTAL is 'Y', only tables which have changed since they were last
+-- exported are exported (see EXPORT_SCHEMA_CHANGES); the manifest is
+-- refreshed before the export and updated as each export completes. If it is
+-- 'D', history tables are exported as deltas where possible. INCREMENTAL
+-- defaults to 'N', which exports every table (and leaves the manifest alone).
+--
+-- If ASCHEMA is omitted it defaults to the current schema. INCLUDE_GENERATED
+-- and INCLUDE_IDENTITY default to 'Y' and are passed to EXPORT_TABLE.
+-------------------------------------------------------------------------------
+
+CREATE PROCEDURE RUN_EXPORT_SCHEMA(
+    ASCHEMA VARCHAR(128),
+    DIRECTORY VARCHAR(1000),
+    INCLUDE_GENERATED VARCHAR(1),
+    INCLUDE_IDENTITY VARCHAR(1),
+    INCREMENTAL CHAR(1)
+)
+    SPECIFIC RUN_EXPORT_SCHEMA4
+    MODIFIES SQL DATA
+    NOT DETERMINISTIC
+    NO EXTERNAL ACTION
+    LANGUAGE SQL
+BEGIN
+    CALL X_EXPORT_LOAD_RUN('E', ASCHEMA, DIRECTORY, INCLUDE_GENERATED, INCLUDE_IDENTITY, INCREMENTAL);
+END!
+
+CREATE PROCEDURE RUN_EXPORT_SCHEMA(
+    ASCHEMA VARCHAR(128),
+    DIRECTORY VARCHAR(1000),
+    INCLUDE_GENERATED VARCHAR(1),
+    INCLUDE_IDENTITY VARCHAR(1)
+)
+    SPECIFIC RUN_EXPORT_SCHEMA1
+    MODIFIES SQL DATA
+    NOT DETERMINISTIC
+    NO EXTERNAL ACTION
+    LANGUAGE SQL
+BEGIN
+    CALL X_EXPORT_LOAD_RUN('E', ASCHEMA, DIRECTORY, INCLUDE_GENERATED, INCLUDE_IDENTITY, 'N');
+END!
+
+CREATE PROCEDURE RUN_EXPORT_SCHEMA(
+    ASCHEMA VARCHAR(128),
+    DIRECTORY VARCHAR(1000)
+)
+    SPECIFIC RUN_EXPORT_SCHEMA2
+    MODIFIES SQL DATA
+    NOT DETERMINISTIC
+    NO EXTERNAL ACTION
+    LANGUAGE SQL
+BEGIN
+    CALL X_EXPORT_LOAD_RUN('E', ASCHEMA, DIRECTORY, 'Y', 'Y', 'N');
+END!
+
+CREATE PROCEDURE RUN_EXPORT_SCHEMA(
+    DIRECTORY VARCHAR(1000)
+)
+    SPECIFIC RUN_EXPORT_SCHEMA3
+    MODIFIES SQL DATA
+    NOT DETERMINISTIC
+    NO EXTERNAL ACTION
+    LANGUAGE SQL
+BEGIN
+    CALL X_EXPORT_LOAD_RUN('E', CURRENT SCHEMA, DIRECTORY, 'Y', 'Y', 'N');
+END!
+
+GRANT EXECUTE ON SPECIFIC PROCEDURE RUN_EXPORT_SCHEMA1 TO ROLE UTILS_LOAD_USER!
+GRANT EXECUTE ON SPECIFIC PROCEDURE RUN_EXPORT_SCHEMA2 TO ROLE UTILS_LOAD_USER!
+GRANT EXECUTE ON SPECIFIC PROCEDURE RUN_EXPORT_SCHEMA3 TO ROLE UTILS_LOAD_USER!
+GRANT EXECUTE ON SPECIFIC PROCEDURE RUN_EXPORT_SCHEMA4 TO ROLE UTILS_LOAD_USER!
+GRANT EXECUTE ON SPECIFIC PROCEDURE RUN_EXPORT_SCHEMA1 TO ROLE UTILS_LOAD_ADMIN WITH GRANT OPTION!
+GRANT EXECUTE ON SPECIFIC PROCEDURE RUN_EXPORT_SCHEMA2 TO ROLE UTILS_LOAD_ADMIN WITH GRANT OPTION!
+GRANT EXECUTE ON SPECIFIC PROCEDURE RUN_EXPORT_SCHEMA3 TO ROLE UTILS_LOAD_ADMIN WITH GRANT OPTION!
+GRANT EXECUTE ON SPECIFIC PROCEDURE RUN_EXPORT_SCHEMA4 TO ROLE UTILS_LOAD_ADMIN WITH GRANT OPTION!
+
+COMMENT ON SPECIFIC PROCEDURE RUN_EXPORT_SCHEMA1
+    IS 'Exports all tables in the specified schema to DIRECTORY on the server'!
+COMMENT ON SPECIFIC PROCEDURE RUN_EXPORT_SCHEMA2
+    IS 'Exports all tables in the specified schema to DIRECTORY on the server'!
+COMMENT ON SPECIFIC PROCEDURE RUN_EXPORT_SCHEMA3
+    IS 'Exports all tables in the specified schema to DIRECTORY on the server'!
+COMMENT ON SPECIFIC PROCEDURE RUN_EXPORT_SCHEMA4
+    IS 'Exports all (or only changed) tables in the specified schema to DIRECTORY on the server'!
+
+-- RUN_LOAD_SCHEMA(ASCHEMA, DIRECTORY, INCLUDE_GENERATED, INCLUDE_IDENTITY)
+-- RUN_LOAD_SCHEMA(ASCHEMA, DIRECTORY)
+-- RUN_LOAD_SCHEMA(DIRECTORY)
+-------------------------------------------------------------------------------
+-- The RUN_LOAD_SCHEMA procedure executes the LOAD commands generated by the
+-- LOAD_SCHEMA function with ADMIN_CMD. The files to load are read from
+-- DIRECTORY on the server (as written by RUN_EXPORT_SCHEMA, or by the
+-- commands generated by EXPORT_SCHEMA). The procedure returns when all loads
+-- have finished, and commits after each one.
+--
+-- Tables are loaded in order of foreign key dependency: no table is loaded
+-- until all of its parents (in the same schema) have been loaded, while
+-- tables which don't depend on each other are loaded concurrently. After each
+-- load, if the table has been placed in set integrity pending state, it is
+-- checked with SET INTEGRITY.
+--
+-- Parallelism and the recording of statistics are handled as for
+-- RUN_EXPORT_SCHEMA, which see. If ASCHEMA is omitted it defaults to the
+-- current schema. INCLUDE_GENERATED and INCLUDE_IDENTITY default to 'Y' and
+-- are passed to LOAD_TABLE.
+-------------------------------------------------------------------------------
+
+CREATE PROCEDURE RUN_LOAD_SCHEMA(
+    ASCHEMA VARCHAR(128),
+    DIRECTORY VARCHAR(1000),
+    INCLUDE_GENERATED VARCHAR(1),
+    INCLUDE_IDENTITY VARCHAR(1)
+)
+    SPECIFIC RUN_LOAD_SCHEMA1
+    MODIFIES SQL DATA
+    NOT DETERMINISTIC
+    NO EXTERNAL ACTION
+    LANGUAGE SQL
+BEGIN
+    CALL X_EXPORT_LOAD_RUN('L', ASCHEMA, DIRECTORY, INCLUDE_GENERATED, INCLUDE_IDENTITY, 'N');
+END!
+
+CREATE PROCEDURE RUN_LOAD_SCHEMA(
+    ASCHEMA VARCHAR(128),
+    DIRECTORY VARCHAR(1000)
+)
+    SPECIFIC RUN_LOAD_SCHEMA2
+    MODIFIES SQL DATA
+    NOT DETERMINISTIC
+    NO EXTERNAL ACTION
+    LANGUAGE SQL
+BEGIN
+    CALL X_EXPORT_LOAD_RUN('L', ASCHEMA, DIRECTORY, 'Y', 'Y', 'N');
+END!
+
+CREATE PROCEDURE RUN_LOAD_SCHEMA(
+    DIRECTORY VARCHAR(1000)
+)
+    SPECIFIC RUN_LOAD_SCHEMA3
+    MODIFIES SQL DATA
+    NOT DETERMINISTIC
+    NO EXTERNAL ACTION
+    LANGUAGE SQL
+BEGIN
+    CALL X_EXPORT_LOAD_RUN('L', CURRENT SCHEMA, DIRECTORY, 'Y', 'Y', 'N');
+END!
+
+GRANT EXECUTE ON SPECIFIC PROCEDURE RUN_LOAD_SCHEMA1 TO ROLE UTILS_LOAD_USER!
+GRANT EXECUTE ON SPECIFIC PROCEDURE RUN_LOAD_SCHEMA2 TO ROLE UTILS_LOAD_USER!
+GRANT EXECUTE ON SPECIFIC PROCEDURE RUN_LOAD_SCHEMA3 TO ROLE UTILS_LOAD_USER!
+GRANT EXECUTE ON SPECIFIC PROCEDURE RUN_LOAD_SCHEMA1 TO ROLE UTILS_LOAD_ADMIN WITH GRANT OPTION!
+GRANT EXECUTE ON SPECIFIC PROCEDURE RUN_LOAD_SCHEMA2 TO ROLE UTILS_LOAD_ADMIN WITH GRANT OPTION!
+GRANT EXECUTE ON SPECIFIC PROCEDURE RUN_LOAD_SCHEMA3 TO ROLE UTILS_LOAD_ADMIN WITH GRANT OPTION!
+
+COMMENT ON SPECIFIC PROCEDURE RUN_LOAD_SCHEMA1
+    IS 'Loads all tables in the specified schema from DIRECTORY on the server in foreign key order'!
+COMMENT ON SPECIFIC PROCEDURE RUN_LOAD_SCHEMA2
+    IS 'Loads all tables in the specified schema from DIRECTORY on the server in foreign key order'!
+COMMENT ON SPECIFIC PROCEDURE RUN_LOAD_SCHEMA3
+    IS 'Loads all tables in the specified schema from DIRECTORY on the server in foreign key order'!
+
 -- vim: set et sw=4 sts=4:
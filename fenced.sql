@@ -0,0 +1,48 @@
+-------------------------------------------------------------------------------
+-- FENCED THREADSAFE REGISTRATION OF EXTERNAL FUNCTIONS
+-------------------------------------------------------------------------------
+-- Copyright (c) 2005-2013 Dave Hughes <dave@waveform.org.uk>
+--
+-- Permission is hereby granted, free of charge, to any person obtaining a copy
+-- of this software and associated documentation files (the "Software"), to
+-- deal in the Software without restriction, including without limitation the
+-- rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+-- sell copies of the Software, and to permit persons to whom the Software is
+-- furnished to do so, subject to the following conditions:
+--
+-- The above copyright notice and this permission notice shall be included in
+-- all copies or substantial portions of the Software.
+--
+-- THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+-- IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+-- FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+-- AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+-- LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+-- FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+-- IN THE SOFTWARE.
+-------------------------------------------------------------------------------
+-- By default, the external (C) functions in the sql, hash, pcre and unicode
+-- modules are registered NOT FENCED. This is the fastest option, but it means the
+-- functions run within the database engine itself, so a crash in one of them
+-- (or in the pcre library) will bring down the instance. This script alters
+-- those functions to run FENCED THREADSAFE instead: each call is passed to a
+-- separate, multi-threaded fenced mode process which protects the engine at
+-- some cost in performance. To revert to NOT FENCED, run unfenced.sql.
+--
+-- Do not run this script directly. Rather, use the "fenced" target of the
+-- Makefile after installation. The "concurrency" target of the tests
+-- Makefile compares the throughput of the two modes.
+-------------------------------------------------------------------------------
+
+ALTER SPECIFIC FUNCTION QUOTE_STRING1 FENCED THREADSAFE!
+ALTER SPECIFIC FUNCTION QUOTE_IDENTIFIER1 FENCED THREADSAFE!
+ALTER SPECIFIC FUNCTION ROW_HASH1 FENCED THREADSAFE!
+ALTER SPECIFIC FUNCTION PCRE_SEARCH1 FENCED THREADSAFE!
+ALTER SPECIFIC FUNCTION PCRE_SUB1 FENCED THREADSAFE!
+ALTER SPECIFIC FUNCTION PCRE_GROUPS1 FENCED THREADSAFE!
+ALTER SPECIFIC FUNCTION PCRE_SPLIT1 FENCED THREADSAFE!
+ALTER SPECIFIC FUNCTION UNICODE_REPLACE_BAD1 FENCED THREADSAFE!
+
+COMMIT!
+
+-- vim: set et sw=4 sts=4:
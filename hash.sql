@@ -0,0 +1,103 @@
+-------------------------------------------------------------------------------
+-- ROW HASHING FUNCTIONS
+-------------------------------------------------------------------------------
+-- Copyright (c) 2015 Dave Hughes <dave@waveform.org.uk>
+--
+-- Permission is hereby granted, free of charge, to any person obtaining a copy
+-- of this software and associated documentation files (the "Software"), to
+-- deal in the Software without restriction, including without limitation the
+-- rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+-- sell copies of the Software, and to permit persons to whom the Software is
+-- furnished to do so, subject to the following conditions:
+--
+-- The above copyright notice and this permission notice shall be included in
+-- all copies or substantial portions of the Software.
+--
+-- THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+-- IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+-- FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+-- AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+-- LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+-- FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+-- IN THE SOFTWARE.
+-------------------------------------------------------------------------------
+-- These functions provide a fast, non-cryptographic 64-bit hash intended for
+-- detecting changes to rows (for example, to avoid needlessly updating rows
+-- which haven't changed in a MERGE). They are not suitable for any security
+-- related purpose.
+--
+-- The hash used is Austin Appleby's MurmurHash64A, which can be found at
+-- https://github.com/aappleby/smhasher
+--
+-- To install these functions, do not run this script. Rather, use the Makefile
+-- with the GNU make utility. The "build", "install", and "register" targets do
+-- what they say on the tin...
+-------------------------------------------------------------------------------
+
+-- ROLES
+-------------------------------------------------------------------------------
+-- The following roles grant usage and administrative rights to the objects
+-- created by this module.
+-------------------------------------------------------------------------------
+
+CREATE ROLE UTILS_HASH_USER!
+CREATE ROLE UTILS_HASH_ADMIN!
+
+GRANT ROLE UTILS_HASH_USER TO ROLE UTILS_USER!
+GRANT ROLE UTILS_HASH_USER TO ROLE UTILS_HASH_ADMIN WITH ADMIN OPTION!
+GRANT ROLE UTILS_HASH_ADMIN TO ROLE UTILS_ADMIN WITH ADMIN OPTION!
+
+-- ROW_HASH(SEED, VALUE)
+-- ROW_HASH(VALUE)
+-------------------------------------------------------------------------------
+-- Returns a 64-bit hash of the bytes of VALUE as a BIGINT. If SEED is
+-- specified, it is used to seed the hash; this permits the hashes of several
+-- values to be chained together by passing the result of one call as the SEED
+-- of the next. If SEED is omitted or NULL, it defaults to zero.
+--
+-- Unlike most functions, a NULL VALUE does not produce a NULL result. Instead
+-- it produces a hash distinct from that of the empty string, making it
+-- possible to distinguish NULL from blank in chained hashes. The result is
+-- the same on all platforms, hence it may be safely persisted in a table.
+--
+-- EXAMPLES
+-------------------------------------------------------------------------------
+-- Hash two columns, distinguishing NULL from the empty string:
+--
+--   ROW_HASH(ROW_HASH(GIVENNAME), SURNAME)
+-------------------------------------------------------------------------------
+
+CREATE FUNCTION ROW_HASH(SEED BIGINT, VALUE VARCHAR(32672) FOR BIT DATA)
+    RETURNS BIGINT
+    SPECIFIC ROW_HASH1
+    EXTERNAL NAME 'hash_udfs!hash_udf_row_hash'
+    LANGUAGE C
+    PARAMETER STYLE SQL
+    DETERMINISTIC
+    NOT FENCED
+    CALLED ON NULL INPUT
+    NO SQL
+    NO EXTERNAL ACTION
+    ALLOW PARALLEL!
+
+CREATE FUNCTION ROW_HASH(VALUE VARCHAR(32672) FOR BIT DATA)
+    RETURNS BIGINT
+    SPECIFIC ROW_HASH2
+    LANGUAGE SQL
+    DETERMINISTIC
+    NO EXTERNAL ACTION
+    CONTAINS SQL
+RETURN
+    ROW_HASH(BIGINT(0), VALUE)!
+
+GRANT EXECUTE ON SPECIFIC FUNCTION ROW_HASH1 TO ROLE UTILS_HASH_USER!
+GRANT EXECUTE ON SPECIFIC FUNCTION ROW_HASH2 TO ROLE UTILS_HASH_USER!
+GRANT EXECUTE ON SPECIFIC FUNCTION ROW_HASH1 TO ROLE UTILS_HASH_ADMIN WITH GRANT OPTION!
+GRANT EXECUTE ON SPECIFIC FUNCTION ROW_HASH2 TO ROLE UTILS_HASH_ADMIN WITH GRANT OPTION!
+
+COMMENT ON SPECIFIC FUNCTION ROW_HASH1
+    IS 'Returns a 64-bit hash of VALUE seeded with SEED, distinguishing NULL from the empty string'!
+COMMENT ON SPECIFIC FUNCTION ROW_HASH2
+    IS 'Returns a 64-bit hash of VALUE, distinguishing NULL from the empty string'!
+
+-- vim: set et sw=4 sts=4:
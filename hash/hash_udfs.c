@@ -0,0 +1,118 @@
+/**
+ * Row hashing UDFs for IBM DB2 for Linux
+ *
+ * Copyright (c) 2015 Dave Hughes <dave@waveform.org.uk>
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * Use the provided Makefile to build and install this library, and to register
+ * the contained functions with the database (see also hash.sql). The hash
+ * function used is Austin Appleby's public domain MurmurHash64A, which can be
+ * found at:
+ *
+ * <https://github.com/aappleby/smhasher>
+ *
+ */
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <sqludf.h>
+#include <sqlsystm.h>
+#include <sqlstate.h>
+
+#include "hash_udfs.h"
+
+/**
+ * Calculates the MurmurHash64A hash of the len bytes at data, with the
+ * specified seed. Unlike the reference implementation, blocks are always read
+ * in little-endian order so that the result is the same on all platforms
+ * (which matters as hashes may be persisted in tables).
+ */
+static uint64_t
+murmur_hash_64a(const unsigned char *data, size_t len, uint64_t seed)
+{
+    const unsigned char *end = data + (len & ~(size_t)7);
+    uint64_t h = seed ^ (len * HASH_MURMUR_M);
+    uint64_t k;
+
+    for (; data != end; data += 8) {
+        k = (uint64_t)data[0]
+            | ((uint64_t)data[1] << 8)
+            | ((uint64_t)data[2] << 16)
+            | ((uint64_t)data[3] << 24)
+            | ((uint64_t)data[4] << 32)
+            | ((uint64_t)data[5] << 40)
+            | ((uint64_t)data[6] << 48)
+            | ((uint64_t)data[7] << 56);
+        k *= HASH_MURMUR_M;
+        k ^= k >> HASH_MURMUR_R;
+        k *= HASH_MURMUR_M;
+        h ^= k;
+        h *= HASH_MURMUR_M;
+    }
+    switch (len & 7) {
+        case 7: h ^= (uint64_t)data[6] << 48; /* fall through */
+        case 6: h ^= (uint64_t)data[5] << 40; /* fall through */
+        case 5: h ^= (uint64_t)data[4] << 32; /* fall through */
+        case 4: h ^= (uint64_t)data[3] << 24; /* fall through */
+        case 3: h ^= (uint64_t)data[2] << 16; /* fall through */
+        case 2: h ^= (uint64_t)data[1] << 8; /* fall through */
+        case 1: h ^= (uint64_t)data[0];
+                h *= HASH_MURMUR_M;
+    }
+    h ^= h >> HASH_MURMUR_R;
+    h *= HASH_MURMUR_M;
+    h ^= h >> HASH_MURMUR_R;
+
+    return h;
+}
+
+/**
+ * This is the implementation for the ROW_HASH function. See the hash.sql
+ * script for a full description of this function's purpose and parameters.
+ * Unlike most of the UDFs in this suite, NULL inputs do not produce a NULL
+ * result: a NULL seed is treated as zero, and a NULL value produces a hash
+ * distinct from that of the empty string.
+ */
+SQL_API_RC SQL_API_FN
+hash_udf_row_hash(
+    // input parameters
+    SQLUDF_BIGINT *seed, SQLUDF_VARCHAR_FBD *value,
+    // output parameters
+    SQLUDF_BIGINT *result,
+    // null indicators
+    SQLUDF_NULLIND *seed_ind, SQLUDF_NULLIND *value_ind,
+    SQLUDF_NULLIND *result_ind,
+    SQLUDF_TRAIL_ARGS)
+{
+    uint64_t h = (*seed_ind == -1) ? 0 : (uint64_t)*seed;
+
+    if (*value_ind == -1)
+        h = murmur_hash_64a((const unsigned char *)"", 0, h ^ HASH_NULL_MARKER);
+    else
+        h = murmur_hash_64a((const unsigned char *)value->data, value->length, h);
+    *result = (SQLUDF_BIGINT)h;
+    *result_ind = 0;
+
+    return;
+}
+
+/* vim: set et sw=4 sts=4: */
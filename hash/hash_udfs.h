@@ -0,0 +1,36 @@
+/**
+ * Row hashing UDFs for IBM DB2 for Linux
+ *
+ * Copyright (c) 2015 Dave Hughes <dave@waveform.org.uk>
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * Use the provided Makefile to build and install this library, and to register
+ * the contained functions with the database (see also hash.sql).
+ */
+
+// The multiplier and shift of the MurmurHash64A mixing function
+#define HASH_MURMUR_M 0xc6a4a7935bd1e995ULL
+#define HASH_MURMUR_R 47
+
+// This value is XORed with the seed to produce the hash of a NULL value. It
+// ensures that NULL hashes differently to the empty string
+#define HASH_NULL_MARKER 0x9e3779b97f4a7c15ULL
+
+/* vim: set et sw=4 sts=4: */
@@ -47,6 +47,10 @@ GRANT ROLE UTILS_HISTORY_USER TO ROLE UTILS_USER!
 GRANT ROLE UTILS_HISTORY_USER TO ROLE UTILS_HISTORY_ADMIN WITH ADMIN OPTION!
 GRANT ROLE UTILS_HISTORY_ADMIN TO ROLE UTILS_ADMIN WITH ADMIN OPTION!
 
+-- The triggers generated by this module read BYPASS_TRIGGERS (defined in the
+-- toggle_triggers module)
+GRANT READ ON VARIABLE BYPASS_TRIGGERS TO ROLE UTILS_HISTORY_USER!
+
 -- SQLSTATES
 -------------------------------------------------------------------------------
 -- The following variables define the set of SQLSTATEs raised by the procedures
@@ -56,13 +60,16 @@ GRANT ROLE UTILS_HISTORY_ADMIN TO ROLE UTILS_ADMIN WITH ADMIN OPTION!
 CREATE VARIABLE HISTORY_KEY_FIELDS_STATE CHAR(5) CONSTANT '90004'!
 CREATE VARIABLE HISTORY_NO_PK_STATE CHAR(5) CONSTANT '90005'!
 CREATE VARIABLE HISTORY_UPDATE_PK_STATE CHAR(5) CONSTANT '90006'!
+CREATE VARIABLE HISTORY_PARTITION_STATE CHAR(5) CONSTANT '90013'!
 
 GRANT READ ON VARIABLE HISTORY_KEY_FIELDS_STATE TO ROLE UTILS_HISTORY_USER!
 GRANT READ ON VARIABLE HISTORY_NO_PK_STATE TO ROLE UTILS_HISTORY_USER!
 GRANT READ ON VARIABLE HISTORY_UPDATE_PK_STATE TO ROLE UTILS_HISTORY_USER!
+GRANT READ ON VARIABLE HISTORY_PARTITION_STATE TO ROLE UTILS_HISTORY_USER!
 GRANT READ ON VARIABLE HISTORY_KEY_FIELDS_STATE TO ROLE UTILS_HISTORY_ADMIN WITH GRANT OPTION!
 GRANT READ ON VARIABLE HISTORY_NO_PK_STATE TO ROLE UTILS_HISTORY_ADMIN WITH GRANT OPTION!
 GRANT READ ON VARIABLE HISTORY_UPDATE_PK_STATE TO ROLE UTILS_HISTORY_ADMIN WITH GRANT OPTION!
+GRANT READ ON VARIABLE HISTORY_PARTITION_STATE TO ROLE UTILS_HISTORY_ADMIN WITH GRANT OPTION!
 
 COMMENT ON VARIABLE HISTORY_KEY_FIELDS_STATE
     IS 'The SQLSTATE raised when a history sub-routine is called with something other than ''Y'' or ''N'' as the KEY_FIELDS parameter'!
@@ -73,6 +80,9 @@ COMMENT ON VARIABLE HISTORY_NO_PK_STATE
 COMMENT ON VARIABLE HISTORY_UPDATE_PK_STATE
     IS 'The SQLSTATE raised when an attempt is made to update a primary key''s value in a table with an associated history table'!
 
+COMMENT ON VARIABLE HISTORY_PARTITION_STATE
+    IS 'The SQLSTATE raised when an invalid partition or compaction resolution is given, or partition maintenance is requested for an unpartitioned history table'!
+
 -- X_HISTORY_EFFNAME(RESOLUTION)
 -- X_HISTORY_EFFNAME(SOURCE_SCHEMA, SOURCE_TABLE)
 -- X_HISTORY_EXPNAME(RESOLUTION)
@@ -84,8 +94,14 @@ COMMENT ON VARIABLE HISTORY_UPDATE_PK_STATE
 -- X_HISTORY_PERIODSTART(RESOLUTION, EXPRESSION)
 -- X_HISTORY_PERIODEND(RESOLUTION, EXPRESSION)
 -- X_HISTORY_PERIODLEN(RESOLUTION)
+-- X_HISTORY_PERIODRANK(RESOLUTION)
+-- X_HISTORY_RESOLUTION(SOURCE_SCHEMA, SOURCE_TABLE)
 -- X_HISTORY_EFFNEXT(RESOLUTION, OFFSET)
 -- X_HISTORY_EXPPRIOR(RESOLUTION, OFFSET)
+-- X_HISTORY_PARTSTART(PARTITION_RESOLUTION, ADATE)
+-- X_HISTORY_PARTVALUE(BOUNDARY)
+-- X_HISTORY_PARTLITERAL(RESOLUTION, VALUE)
+-- X_HISTORY_PARTLITERAL(SOURCE_SCHEMA, SOURCE_TABLE, VALUE)
 -- X_HISTORY_INSERT(SOURCE_SCHEMA, SOURCE_TABLE, DEST_SCHEMA, DEST_TABLE, RESOLUTION, OFFSET)
 -- X_HISTORY_EXPIRE(SOURCE_SCHEMA, SOURCE_TABLE, DEST_SCHEMA, DEST_TABLE, RESOLUTION, OFFSET)
 -- X_HISTORY_DELETE(SOURCE_SCHEMA, SOURCE_TABLE, DEST_SCHEMA, DEST_TABLE, RESOLUTION)
@@ -294,6 +310,56 @@ RETURN
         ELSE RAISE_ERROR('70001', 'Invalid RESOLUTION value ' || RESOLUTION)
     END!
 
+CREATE FUNCTION X_HISTORY_PERIODRANK(RESOLUTION VARCHAR(11))
+    RETURNS SMALLINT
+    SPECIFIC X_HISTORY_PERIODRANK
+    LANGUAGE SQL
+    DETERMINISTIC
+    NO EXTERNAL ACTION
+    CONTAINS SQL
+RETURN
+    CASE RESOLUTION
+        WHEN 'MICROSECOND' THEN 1
+        WHEN 'SECOND'      THEN 2
+        WHEN 'MINUTE'      THEN 3
+        WHEN 'HOUR'        THEN 4
+        WHEN 'DAY'         THEN 5
+        WHEN 'WEEK'        THEN 6
+        WHEN 'WEEK_ISO'    THEN 6
+        WHEN 'MONTH'       THEN 7
+        WHEN 'YEAR'        THEN 8
+        ELSE RAISE_ERROR('70001', 'Invalid RESOLUTION value ' || RESOLUTION)
+    END!
+
+CREATE FUNCTION X_HISTORY_RESOLUTION(SOURCE_SCHEMA VARCHAR(128), SOURCE_TABLE VARCHAR(128))
+    RETURNS VARCHAR(11)
+    SPECIFIC X_HISTORY_RESOLUTION
+    LANGUAGE SQL
+    DETERMINISTIC
+    NO EXTERNAL ACTION
+    READS SQL DATA
+RETURN
+    SELECT
+        CASE
+            WHEN COLNAME IN (
+                'EFFECTIVE_MICROSECOND',
+                'EFFECTIVE_SECOND',
+                'EFFECTIVE_MINUTE',
+                'EFFECTIVE_HOUR',
+                'EFFECTIVE_DAY',
+                'EFFECTIVE_WEEK',
+                'EFFECTIVE_WEEK_ISO',
+                'EFFECTIVE_MONTH',
+                'EFFECTIVE_YEAR'
+            ) THEN SUBSTR(COLNAME, 11)
+            WHEN TYPENAME = 'DATE' THEN 'DAY'
+            ELSE 'MICROSECOND'
+        END
+    FROM SYSCAT.COLUMNS
+    WHERE TABSCHEMA = SOURCE_SCHEMA
+    AND TABNAME = SOURCE_TABLE
+    AND COLNO = 0!
+
 CREATE FUNCTION X_HISTORY_PERIODSTEP(RESOLUTION VARCHAR(11))
     RETURNS VARCHAR(13)
     SPECIFIC X_HISTORY_PERIODSTEP1
@@ -348,6 +414,71 @@ CREATE FUNCTION X_HISTORY_EXPPRIOR(RESOLUTION VARCHAR(11), OFFSET VARCHAR(100))
 RETURN
     X_HISTORY_PERIODEND(RESOLUTION, X_HISTORY_EFFDEFAULT(RESOLUTION) || ' - ' || X_HISTORY_PERIODLEN(RESOLUTION) || ' ' || OFFSET)!
 
+CREATE FUNCTION X_HISTORY_PARTSTART(PARTITION_RESOLUTION VARCHAR(11), ADATE DATE)
+    RETURNS DATE
+    SPECIFIC X_HISTORY_PARTSTART
+    LANGUAGE SQL
+    DETERMINISTIC
+    NO EXTERNAL ACTION
+    CONTAINS SQL
+RETURN
+    CASE PARTITION_RESOLUTION
+        WHEN 'DAY'         THEN ADATE
+        WHEN 'WEEK'        THEN WEEKSTART(ADATE)
+        WHEN 'WEEK_ISO'    THEN WEEKSTART_ISO(ADATE)
+        WHEN 'MONTH'       THEN MONTHSTART(ADATE)
+        WHEN 'YEAR'        THEN YEARSTART(ADATE)
+        ELSE RAISE_ERROR('70001', 'Invalid PARTITION_RESOLUTION value ' || PARTITION_RESOLUTION)
+    END!
+
+CREATE FUNCTION X_HISTORY_PARTVALUE(BOUNDARY VARCHAR(512))
+    RETURNS TIMESTAMP
+    SPECIFIC X_HISTORY_PARTVALUE
+    LANGUAGE SQL
+    DETERMINISTIC
+    NO EXTERNAL ACTION
+    CONTAINS SQL
+RETURN
+    CASE
+        WHEN BOUNDARY IN ('MINVALUE', 'MAXVALUE') THEN NULL
+        WHEN LENGTH(TRIM(BOTH '''' FROM BOUNDARY)) = 10 THEN TIMESTAMP(DATE(TRIM(BOTH '''' FROM BOUNDARY)), '00:00:00')
+        ELSE TIMESTAMP(TRIM(BOTH '''' FROM BOUNDARY))
+    END!
+
+CREATE FUNCTION X_HISTORY_PARTLITERAL(RESOLUTION VARCHAR(11), VALUE TIMESTAMP)
+    RETURNS VARCHAR(40)
+    SPECIFIC X_HISTORY_PARTLITERAL1
+    LANGUAGE SQL
+    DETERMINISTIC
+    NO EXTERNAL ACTION
+    CONTAINS SQL
+RETURN
+    CASE
+        WHEN RESOLUTION IN ('MICROSECOND', 'SECOND', 'MINUTE', 'HOUR') THEN '''' || CHAR(VALUE) || ''''
+        WHEN RESOLUTION IN ('DAY', 'WEEK', 'WEEK_ISO', 'MONTH', 'YEAR') THEN '''' || CHAR(DATE(VALUE), ISO) || ''''
+        ELSE RAISE_ERROR('70001', 'Invalid RESOLUTION value ' || RESOLUTION)
+    END!
+
+CREATE FUNCTION X_HISTORY_PARTLITERAL(SOURCE_SCHEMA VARCHAR(128), SOURCE_TABLE VARCHAR(128), VALUE TIMESTAMP)
+    RETURNS VARCHAR(40)
+    SPECIFIC X_HISTORY_PARTLITERAL2
+    LANGUAGE SQL
+    DETERMINISTIC
+    NO EXTERNAL ACTION
+    READS SQL DATA
+RETURN
+    CASE (
+            SELECT TYPENAME
+            FROM SYSCAT.COLUMNS
+            WHERE TABSCHEMA = SOURCE_SCHEMA
+            AND TABNAME = SOURCE_TABLE
+            AND COLNO = 0
+        )
+        WHEN 'TIMESTAMP' THEN '''' || CHAR(VALUE) || ''''
+        WHEN 'DATE' THEN '''' || CHAR(DATE(VALUE), ISO) || ''''
+        ELSE RAISE_ERROR('70001', 'Unexpected datatype found in effective column')
+    END!
+
 CREATE FUNCTION X_HISTORY_INSERT(
     SOURCE_SCHEMA VARCHAR(128),
     SOURCE_TABLE VARCHAR(128),
@@ -533,8 +664,15 @@ BEGIN ATOMIC
     DECLARE INSERT_TEST CLOB(64K) DEFAULT '';
     DECLARE UPDATE_TEST CLOB(64K) DEFAULT '';
     DECLARE DELETE_TEST CLOB(64K) DEFAULT '';
+    -- The expired rows are selected with a nested table expression rather
+    -- than a common table expression so that the result can also be used as
+    -- the fullselect of a CREATE TABLE .. AS statement
     SET FROM_STMT =
-        ' FROM ' || QUOTE_IDENTIFIER('OLD_' || SOURCE_TABLE) || ' AS OLD'
+        ' FROM ('
+        || '    SELECT *'
+        || '    FROM ' || QUOTE_IDENTIFIER(SOURCE_SCHEMA) || '.' || QUOTE_IDENTIFIER(SOURCE_TABLE)
+        || '    WHERE ' || X_HISTORY_EXPNAME(SOURCE_SCHEMA, SOURCE_TABLE) || ' < ' || X_HISTORY_EXPDEFAULT(SOURCE_SCHEMA, SOURCE_TABLE)
+        || ') AS OLD'
         || ' FULL OUTER JOIN ' || QUOTE_IDENTIFIER(SOURCE_SCHEMA) || '.' || QUOTE_IDENTIFIER(SOURCE_TABLE) || ' AS NEW'
         || ' ON NEW.' || X_HISTORY_EFFNAME(SOURCE_SCHEMA, SOURCE_TABLE) || ' - ' || X_HISTORY_PERIODSTEP(SOURCE_SCHEMA, SOURCE_TABLE)
         || ' BETWEEN OLD.' || X_HISTORY_EFFNAME(SOURCE_SCHEMA, SOURCE_TABLE)
@@ -575,14 +713,7 @@ BEGIN ATOMIC
             || 'WHEN' || SUBSTR(DELETE_TEST, 4) || 'THEN ''DELETE'' '
             || 'ELSE ''ERROR'' END) AS CHANGE'
         || SELECT_STMT;
-    RETURN
-        'WITH ' || QUOTE_IDENTIFIER('OLD_' || SOURCE_TABLE) || ' AS ('
-        || '    SELECT *'
-        || '    FROM ' || QUOTE_IDENTIFIER(SOURCE_SCHEMA) || '.' || QUOTE_IDENTIFIER(SOURCE_TABLE)
-        || '    WHERE ' || X_HISTORY_EXPNAME(SOURCE_SCHEMA, SOURCE_TABLE) || ' < ' || X_HISTORY_EXPDEFAULT(SOURCE_SCHEMA, SOURCE_TABLE)
-        || ') '
-        || SELECT_STMT
-        || FROM_STMT;
+    RETURN SELECT_STMT || FROM_STMT;
 END!
 
 CREATE FUNCTION X_HISTORY_SNAPSHOTS(
@@ -693,7 +824,9 @@ BEGIN ATOMIC
     RETURN SUBSTR(RESULT, 5);
 END!
 
+-- CREATE_HISTORY_TABLE(SOURCE_SCHEMA, SOURCE_TABLE, DEST_SCHEMA, DEST_TABLE, DEST_TBSPACE, RESOLUTION, PARTITION_RESOLUTION)
 -- CREATE_HISTORY_TABLE(SOURCE_SCHEMA, SOURCE_TABLE, DEST_SCHEMA, DEST_TABLE, DEST_TBSPACE, RESOLUTION)
+-- CREATE_HISTORY_TABLE(SOURCE_TABLE, DEST_TABLE, DEST_TBSPACE, RESOLUTION, PARTITION_RESOLUTION)
 -- CREATE_HISTORY_TABLE(SOURCE_TABLE, DEST_TABLE, DEST_TBSPACE, RESOLUTION)
 -- CREATE_HISTORY_TABLE(SOURCE_TABLE, DEST_TABLE, RESOLUTION)
 -- CREATE_HISTORY_TABLE(SOURCE_TABLE, RESOLUTION)
@@ -719,6 +852,18 @@ END!
 -- record can cover. See the CREATE_HISTORY_TRIGGER documentation for a list of
 -- the possible values.
 --
+-- If PARTITION_RESOLUTION is specified (and not NULL), the history table is
+-- range partitioned on its EFFECTIVE column. PARTITION_RESOLUTION may be one
+-- of 'DAY', 'WEEK', 'WEEK_ISO', 'MONTH', or 'YEAR' and determines the size of
+-- each partition. One partition holds everything prior to the current period,
+-- and further partitions are created for the periods up to a year ahead. The
+-- ARCHIVE_HISTORY procedure below adds partitions as time passes, and
+-- detaches partitions older than a retention period. The unique index on the
+-- key and EXPIRY columns (which the history triggers probe) is created as a
+-- non-partitioned index so that trigger lookups remain a single probe, while
+-- the other indexes (including the key, EFFECTIVE, EXPIRY index probed by the
+-- changes and snapshots views) are partitioned.
+--
 -- All SELECT and CONTROL authorities present on the source table will be
 -- copied to the destination table. However, INSERT, UPDATE and DELETE
 -- authorities are excluded as these operations should only ever be performed
@@ -735,7 +880,8 @@ CREATE PROCEDURE CREATE_HISTORY_TABLE(
     DEST_SCHEMA VARCHAR(128),
     DEST_TABLE VARCHAR(128),
     DEST_TBSPACE VARCHAR(18),
-    RESOLUTION VARCHAR(11)
+    RESOLUTION VARCHAR(11),
+    PARTITION_RESOLUTION VARCHAR(11)
 )
     SPECIFIC CREATE_HISTORY_TABLE1
     MODIFIES SQL DATA
@@ -746,12 +892,37 @@ BEGIN ATOMIC
     DECLARE KEY_COLS CLOB(64K) DEFAULT '';
     DECLARE INC_COLS CLOB(64K) DEFAULT '';
     DECLARE DDL CLOB(64K) DEFAULT '';
+    DECLARE PART_CLAUSE CLOB(64K) DEFAULT '';
+    DECLARE PARTITIONED VARCHAR(20) DEFAULT '';
+    DECLARE NOT_PARTITIONED VARCHAR(20) DEFAULT '';
+    DECLARE PART_START DATE;
+    DECLARE PART_END DATE;
     DECLARE SAVE_PATH VARCHAR(254);
     DECLARE SAVE_SCHEMA VARCHAR(128);
     DECLARE PK_CLUSTERED CHAR(1) DEFAULT 'N';
     DECLARE TAB_COMPRESSED CHAR(1) DEFAULT 'N';
 
     CALL ASSERT_TABLE_EXISTS(SOURCE_SCHEMA, SOURCE_TABLE);
+    -- Calculate the partitioning clause. The first partition covers
+    -- everything prior to the current period, subsequent partitions cover
+    -- each period up to a year ahead
+    IF PARTITION_RESOLUTION IS NOT NULL THEN
+        IF PARTITION_RESOLUTION NOT IN ('DAY', 'WEEK', 'WEEK_ISO', 'MONTH', 'YEAR') THEN
+            CALL SIGNAL_STATE(HISTORY_PARTITION_STATE, 'Invalid PARTITION_RESOLUTION value ' || PARTITION_RESOLUTION);
+        END IF;
+        SET PART_START = X_HISTORY_PARTSTART(PARTITION_RESOLUTION, CURRENT DATE);
+        SET PART_END = X_HISTORY_PARTSTART(PARTITION_RESOLUTION, CURRENT DATE + 1 YEAR);
+        SET PART_CLAUSE =
+            ' PARTITION BY RANGE (' || QUOTE_IDENTIFIER(X_HISTORY_EFFNAME(RESOLUTION)) || ') ('
+            || '    STARTING MINVALUE'
+            || '    ENDING ' || X_HISTORY_PARTLITERAL(RESOLUTION, TIMESTAMP(PART_START, '00:00:00')) || ' EXCLUSIVE,'
+            || '    STARTING ' || X_HISTORY_PARTLITERAL(RESOLUTION, TIMESTAMP(PART_START, '00:00:00'))
+            || '    ENDING ' || X_HISTORY_PARTLITERAL(RESOLUTION, TIMESTAMP(PART_END, '00:00:00')) || ' EXCLUSIVE'
+            || '    EVERY (' || X_HISTORY_PERIODLEN(PARTITION_RESOLUTION) || ')'
+            || ')';
+        SET PARTITIONED = ' PARTITIONED';
+        SET NOT_PARTITIONED = ' NOT PARTITIONED';
+    END IF;
     -- Check the source table has a primary key
     IF (SELECT COALESCE(KEYCOLUMNS, 0)
         FROM SYSCAT.TABLES
@@ -834,31 +1005,40 @@ BEGIN ATOMIC
         ||          QUOTE_IDENTIFIER(SOURCE_SCHEMA) || '.' || QUOTE_IDENTIFIER(SOURCE_TABLE) || ' AS T'
         || ')'
         || 'WITH NO DATA IN ' || DEST_TBSPACE || ' '
-        || 'COMPRESS ' || CASE TAB_COMPRESSED WHEN 'Y' THEN 'YES' ELSE 'NO' END;
+        || 'COMPRESS ' || CASE TAB_COMPRESSED WHEN 'Y' THEN 'YES' ELSE 'NO' END
+        || PART_CLAUSE;
     EXECUTE IMMEDIATE DDL;
     -- Create two unique indexes, both based on the source table's primary key,
     -- plus the EFFECTIVE and EXPIRY fields respectively. Use INCLUDE for
     -- additional small fields in the EFFECTIVE index. The columns included are
-    -- the same as those included in the primary key of the source table.
+    -- the same as those included in the primary key of the source table. The
+    -- EFFECTIVE index (which also serves as the key, EFFECTIVE, EXPIRY index
+    -- probed by the changes and snapshots views) can be partitioned as it
+    -- includes the partitioning column. The EXPIRY index cannot, and is
+    -- deliberately left non-partitioned as the history triggers probe it
+    -- without an EFFECTIVE value.
     SET DDL =
         'CREATE UNIQUE INDEX ' || QUOTE_IDENTIFIER(DEST_SCHEMA) || '.' || QUOTE_IDENTIFIER(DEST_TABLE || '_PK') || ' '
         || 'ON ' || QUOTE_IDENTIFIER(DEST_SCHEMA) || '.' || QUOTE_IDENTIFIER(DEST_TABLE)
         || '(' || KEY_COLS || QUOTE_IDENTIFIER(X_HISTORY_EFFNAME(RESOLUTION))
         || ') INCLUDE (' || INC_COLS || QUOTE_IDENTIFIER(X_HISTORY_EXPNAME(RESOLUTION)) || ') '
-        || CASE PK_CLUSTERED WHEN 'Y' THEN 'CLUSTER' ELSE '' END;
+        || CASE PK_CLUSTERED WHEN 'Y' THEN 'CLUSTER' ELSE '' END
+        || PARTITIONED;
     EXECUTE IMMEDIATE DDL;
     SET DDL =
         'CREATE UNIQUE INDEX ' || QUOTE_IDENTIFIER(DEST_SCHEMA) || '.' || QUOTE_IDENTIFIER(DEST_TABLE || '_PK2') || ' '
         || 'ON ' || QUOTE_IDENTIFIER(DEST_SCHEMA) || '.' || QUOTE_IDENTIFIER(DEST_TABLE)
         || '(' || KEY_COLS || QUOTE_IDENTIFIER(X_HISTORY_EXPNAME(RESOLUTION))
-        || ')';
+        || ')'
+        || NOT_PARTITIONED;
     EXECUTE IMMEDIATE DDL;
     -- Create additional indexes that are useful for performance purposes
     SET DDL =
         'CREATE INDEX ' || QUOTE_IDENTIFIER(DEST_SCHEMA) || '.' || QUOTE_IDENTIFIER(DEST_TABLE || '_IX1') || ' '
         || 'ON ' || QUOTE_IDENTIFIER(DEST_SCHEMA) || '.' || QUOTE_IDENTIFIER(DEST_TABLE)
         || '(' || QUOTE_IDENTIFIER(X_HISTORY_EFFNAME(RESOLUTION)) || ', ' || QUOTE_IDENTIFIER(X_HISTORY_EXPNAME(RESOLUTION))
-        || ')';
+        || ')'
+        || PARTITIONED;
     EXECUTE IMMEDIATE DDL;
     -- Create a primary key with the same fields as the EFFECTIVE index defined
     -- above.
@@ -937,6 +1117,39 @@ BEGIN ATOMIC
     END FOR;
 END!
 
+CREATE PROCEDURE CREATE_HISTORY_TABLE(
+    SOURCE_SCHEMA VARCHAR(128),
+    SOURCE_TABLE VARCHAR(128),
+    DEST_SCHEMA VARCHAR(128),
+    DEST_TABLE VARCHAR(128),
+    DEST_TBSPACE VARCHAR(18),
+    RESOLUTION VARCHAR(11)
+)
+    SPECIFIC CREATE_HISTORY_TABLE5
+    MODIFIES SQL DATA
+    NOT DETERMINISTIC
+    NO EXTERNAL ACTION
+    LANGUAGE SQL
+BEGIN ATOMIC
+    CALL CREATE_HISTORY_TABLE(SOURCE_SCHEMA, SOURCE_TABLE, DEST_SCHEMA, DEST_TABLE, DEST_TBSPACE, RESOLUTION, CAST(NULL AS VARCHAR(11)));
+END!
+
+CREATE PROCEDURE CREATE_HISTORY_TABLE(
+    SOURCE_TABLE VARCHAR(128),
+    DEST_TABLE VARCHAR(128),
+    DEST_TBSPACE VARCHAR(18),
+    RESOLUTION VARCHAR(11),
+    PARTITION_RESOLUTION VARCHAR(11)
+)
+    SPECIFIC CREATE_HISTORY_TABLE6
+    MODIFIES SQL DATA
+    NOT DETERMINISTIC
+    NO EXTERNAL ACTION
+    LANGUAGE SQL
+BEGIN ATOMIC
+    CALL CREATE_HISTORY_TABLE(CURRENT SCHEMA, SOURCE_TABLE, CURRENT SCHEMA, DEST_TABLE, DEST_TBSPACE, RESOLUTION, PARTITION_RESOLUTION);
+END!
+
 CREATE PROCEDURE CREATE_HISTORY_TABLE(
     SOURCE_TABLE VARCHAR(128),
     DEST_TABLE VARCHAR(128),
@@ -985,10 +1198,14 @@ GRANT EXECUTE ON SPECIFIC PROCEDURE CREATE_HISTORY_TABLE1 TO ROLE UTILS_HISTORY_
 GRANT EXECUTE ON SPECIFIC PROCEDURE CREATE_HISTORY_TABLE2 TO ROLE UTILS_HISTORY_USER!
 GRANT EXECUTE ON SPECIFIC PROCEDURE CREATE_HISTORY_TABLE3 TO ROLE UTILS_HISTORY_USER!
 GRANT EXECUTE ON SPECIFIC PROCEDURE CREATE_HISTORY_TABLE4 TO ROLE UTILS_HISTORY_USER!
+GRANT EXECUTE ON SPECIFIC PROCEDURE CREATE_HISTORY_TABLE5 TO ROLE UTILS_HISTORY_USER!
+GRANT EXECUTE ON SPECIFIC PROCEDURE CREATE_HISTORY_TABLE6 TO ROLE UTILS_HISTORY_USER!
 GRANT EXECUTE ON SPECIFIC PROCEDURE CREATE_HISTORY_TABLE1 TO ROLE UTILS_HISTORY_ADMIN WITH GRANT OPTION!
 GRANT EXECUTE ON SPECIFIC PROCEDURE CREATE_HISTORY_TABLE2 TO ROLE UTILS_HISTORY_ADMIN WITH GRANT OPTION!
 GRANT EXECUTE ON SPECIFIC PROCEDURE CREATE_HISTORY_TABLE3 TO ROLE UTILS_HISTORY_ADMIN WITH GRANT OPTION!
 GRANT EXECUTE ON SPECIFIC PROCEDURE CREATE_HISTORY_TABLE4 TO ROLE UTILS_HISTORY_ADMIN WITH GRANT OPTION!
+GRANT EXECUTE ON SPECIFIC PROCEDURE CREATE_HISTORY_TABLE5 TO ROLE UTILS_HISTORY_ADMIN WITH GRANT OPTION!
+GRANT EXECUTE ON SPECIFIC PROCEDURE CREATE_HISTORY_TABLE6 TO ROLE UTILS_HISTORY_ADMIN WITH GRANT OPTION!
 
 COMMENT ON SPECIFIC PROCEDURE CREATE_HISTORY_TABLE1
     IS 'Creates a temporal history table based on the structure of the specified table'!
@@ -998,6 +1215,10 @@ COMMENT ON SPECIFIC PROCEDURE CREATE_HISTORY_TABLE3
     IS 'Creates a temporal history table based on the structure of the specified table'!
 COMMENT ON SPECIFIC PROCEDURE CREATE_HISTORY_TABLE4
     IS 'Creates a temporal history table based on the structure of the specified table'!
+COMMENT ON SPECIFIC PROCEDURE CREATE_HISTORY_TABLE5
+    IS 'Creates a temporal history table based on the structure of the specified table'!
+COMMENT ON SPECIFIC PROCEDURE CREATE_HISTORY_TABLE6
+    IS 'Creates a temporal history table based on the structure of the specified table'!
 
 -- CREATE_HISTORY_CHANGES(SOURCE_SCHEMA, SOURCE_TABLE, DEST_SCHEMA, DEST_VIEW)
 -- CREATE_HISTORY_CHANGES(SOURCE_TABLE, DEST_VIEW)
@@ -1138,6 +1359,567 @@ COMMENT ON SPECIFIC PROCEDURE CREATE_HISTORY_CHANGES2
 COMMENT ON SPECIFIC PROCEDURE CREATE_HISTORY_CHANGES3
     IS 'Creates an "OLD vs NEW" changes view on top of the specified history table'!
 
+-- CREATE_HISTORY_CHANGES_TABLE(SOURCE_SCHEMA, SOURCE_TABLE, DEST_SCHEMA, DEST_TABLE, DEST_TBSPACE)
+-- CREATE_HISTORY_CHANGES_TABLE(SOURCE_TABLE, DEST_TABLE, DEST_TBSPACE)
+-- CREATE_HISTORY_CHANGES_TABLE(SOURCE_TABLE, DEST_TABLE)
+-- CREATE_HISTORY_CHANGES_TABLE(SOURCE_TABLE)
+-------------------------------------------------------------------------------
+-- The CREATE_HISTORY_CHANGES_TABLE procedure is an alternative to the
+-- CREATE_HISTORY_CHANGES procedure above. Instead of a view which joins the
+-- entire history table to itself every time it is queried, it creates a real
+-- table with the same structure as the changes view (plus a leading CHANGE_ID
+-- column), populates it from the existing content of the history table, and
+-- then creates triggers on the history table which maintain the changes table
+-- as the history triggers insert, expire, update and delete history rows.
+--
+-- The CHANGE_ID column is assigned from a sequence (named after DEST_TABLE
+-- with a "_SEQ" suffix) whenever a change row is inserted or altered. Hence,
+-- consumers which periodically poll the changes table can ask for only those
+-- rows with a CHANGE_ID greater than the last one they saw; the
+-- MARK_HISTORY_CHANGES procedure below keeps track of this "high-water mark"
+-- for each consumer.
+--
+-- The content of the table matches the content of the equivalent view,
+-- including the collapse of several changes within a single period of the
+-- history's resolution into one change. Consequently, a change row may be
+-- altered (and receive a new CHANGE_ID) until the period it belongs to has
+-- passed, just as the corresponding row in the view would have been.
+--
+-- There are two exceptions, both because a consumer may already have seen a
+-- change. A row inserted and deleted within a single period shows nothing in
+-- the view, but the table retains the insertion and records a compensating
+-- deletion. A row re-inserted within the period of a deletion which
+-- MARK_HISTORY_CHANGES has already handed to a consumer shows as an update in
+-- the view, but the table leaves the deletion alone and records a new
+-- insertion.
+--
+-- The DEST_TBSPACE parameter identifies the tablespace used to store the new
+-- table's data. If DEST_TBSPACE is not specified, it defaults to the
+-- tablespace of the history table. If DEST_TABLE is not specified it defaults
+-- to the value of SOURCE_TABLE with "_HISTORY" replaced with "_CHANGES". If
+-- DEST_SCHEMA and SOURCE_SCHEMA are not specified they default to the current
+-- schema.
+--
+-- All SELECT and CONTROL authorities present on the source table will be
+-- copied to the destination table.
+--
+-- If the specified table already exists, this procedure will replace it,
+-- losing its content (and resetting all CHANGE_ID values).
+-------------------------------------------------------------------------------
+
+CREATE PROCEDURE CREATE_HISTORY_CHANGES_TABLE(
+    SOURCE_SCHEMA VARCHAR(128),
+    SOURCE_TABLE VARCHAR(128),
+    DEST_SCHEMA VARCHAR(128),
+    DEST_TABLE VARCHAR(128),
+    DEST_TBSPACE VARCHAR(18)
+)
+    SPECIFIC CREATE_HISTORY_CHANGES_TABLE1
+    MODIFIES SQL DATA
+    NOT DETERMINISTIC
+    NO EXTERNAL ACTION
+    LANGUAGE SQL
+BEGIN ATOMIC
+    DECLARE DDL CLOB(64K) DEFAULT '';
+    DECLARE DEST CLOB(1K) DEFAULT '';
+    DECLARE SEQ CLOB(1K) DEFAULT '';
+    DECLARE EFFNAME VARCHAR(258);
+    DECLARE EXPNAME VARCHAR(258);
+    DECLARE EXPDEFAULT VARCHAR(254);
+    DECLARE STEP VARCHAR(13);
+    DECLARE OLD_COLS CLOB(64K) DEFAULT '';
+    DECLARE NEW_COLS CLOB(64K) DEFAULT '';
+    DECLARE ROW_VALS CLOB(64K) DEFAULT '';
+    DECLARE OLD_VALS CLOB(64K) DEFAULT '';
+    DECLARE NEW_SET CLOB(64K) DEFAULT '';
+    DECLARE NEW_NULL CLOB(64K) DEFAULT '';
+    DECLARE OLD_KEY_COLS CLOB(64K) DEFAULT '';
+    DECLARE NEW_KEY_COLS CLOB(64K) DEFAULT '';
+    DECLARE OLD_KEY_NEW CLOB(64K) DEFAULT '';
+    DECLARE NEW_KEY_NEW CLOB(64K) DEFAULT '';
+    DECLARE NEW_KEY_OLD CLOB(64K) DEFAULT '';
+    DECLARE MARKS VARCHAR(258) DEFAULT '';
+    DECLARE PUBLISHED CLOB(2K) DEFAULT '';
+
+    CALL ASSERT_TABLE_EXISTS(SOURCE_SCHEMA, SOURCE_TABLE);
+    SET DEST = QUOTE_IDENTIFIER(DEST_SCHEMA) || '.' || QUOTE_IDENTIFIER(DEST_TABLE);
+    SET SEQ = QUOTE_IDENTIFIER(DEST_SCHEMA) || '.' || QUOTE_IDENTIFIER(DEST_TABLE || '_SEQ');
+    -- HISTORY_CHANGES_MARKS is created after this procedure, in the schema of
+    -- these routines; qualify it for use in the dynamic SQL below
+    SET MARKS = (
+        SELECT QUOTE_IDENTIFIER(TABSCHEMA) || '.' || QUOTE_IDENTIFIER(TABNAME)
+        FROM SYSCAT.TABLES
+        WHERE TABNAME = 'HISTORY_CHANGES_MARKS'
+        ORDER BY COALESCE(NULLIF(LOCATE('"' || TABSCHEMA || '"', CURRENT PATH), 0), 32767)
+        FETCH FIRST 1 ROW ONLY
+    );
+    -- The highest CHANGE_ID any consumer has been handed by
+    -- MARK_HISTORY_CHANGES. Change rows at or below it have been published
+    -- and must not be rewritten by the INSERT trigger below
+    SET PUBLISHED =
+        'COALESCE(('
+        || '    SELECT MAX(M.CHANGE_ID) FROM ' || MARKS || ' AS M'
+        || '    WHERE M.TABSCHEMA = ' || QUOTE_STRING(DEST_SCHEMA)
+        || '    AND M.TABNAME = ' || QUOTE_STRING(DEST_TABLE)
+        || '), 0)';
+    SET EFFNAME = QUOTE_IDENTIFIER(X_HISTORY_EFFNAME(SOURCE_SCHEMA, SOURCE_TABLE));
+    SET EXPNAME = QUOTE_IDENTIFIER(X_HISTORY_EXPNAME(SOURCE_SCHEMA, SOURCE_TABLE));
+    SET EXPDEFAULT = X_HISTORY_EXPDEFAULT(SOURCE_SCHEMA, SOURCE_TABLE);
+    SET STEP = X_HISTORY_PERIODSTEP(SOURCE_SCHEMA, SOURCE_TABLE);
+    -- Drop any existing table and sequence with the same names as the
+    -- destination objects
+    FOR D AS
+        SELECT
+            'DROP TABLE ' || QUOTE_IDENTIFIER(TABSCHEMA) || '.' || QUOTE_IDENTIFIER(TABNAME) AS DROP_CMD
+        FROM
+            SYSCAT.TABLES
+        WHERE
+            TABSCHEMA = DEST_SCHEMA
+            AND TABNAME = DEST_TABLE
+            AND TYPE = 'T'
+        UNION ALL
+        SELECT
+            'DROP SEQUENCE ' || QUOTE_IDENTIFIER(SEQSCHEMA) || '.' || QUOTE_IDENTIFIER(SEQNAME) AS DROP_CMD
+        FROM
+            SYSCAT.SEQUENCES
+        WHERE
+            SEQSCHEMA = DEST_SCHEMA
+            AND SEQNAME = DEST_TABLE || '_SEQ'
+            AND SEQTYPE = 'S'
+    DO
+        EXECUTE IMMEDIATE D.DROP_CMD;
+    END FOR;
+    -- Forget the high-water marks of any consumers of a prior incarnation of
+    -- the table, as its CHANGE_ID values are about to restart
+    SET DDL =
+        'DELETE FROM ' || MARKS || ' '
+        || 'WHERE TABSCHEMA = ' || QUOTE_STRING(DEST_SCHEMA) || ' '
+        || 'AND TABNAME = ' || QUOTE_STRING(DEST_TABLE);
+    EXECUTE IMMEDIATE DDL;
+    -- Calculate the column lists, assignments and key predicates used by the
+    -- index and trigger definitions below
+    FOR C AS
+        SELECT COALESCE(KEYSEQ, 0) AS KEYSEQ, COLNAME
+        FROM SYSCAT.COLUMNS
+        WHERE TABSCHEMA = SOURCE_SCHEMA
+        AND TABNAME = SOURCE_TABLE
+        AND COLNO >= 2
+        ORDER BY COLNO
+    DO
+        SET OLD_COLS = OLD_COLS || ', ' || QUOTE_IDENTIFIER('OLD_' || C.COLNAME);
+        SET NEW_COLS = NEW_COLS || ', ' || QUOTE_IDENTIFIER('NEW_' || C.COLNAME);
+        SET ROW_VALS = ROW_VALS || ', NEW.' || QUOTE_IDENTIFIER(C.COLNAME);
+        SET OLD_VALS = OLD_VALS || ', OLD.' || QUOTE_IDENTIFIER(C.COLNAME);
+        SET NEW_SET = NEW_SET || ', ' || QUOTE_IDENTIFIER('NEW_' || C.COLNAME) || ' = NEW.' || QUOTE_IDENTIFIER(C.COLNAME);
+        SET NEW_NULL = NEW_NULL || ', ' || QUOTE_IDENTIFIER('NEW_' || C.COLNAME) || ' = NULL';
+        IF C.KEYSEQ > 0 THEN
+            SET OLD_KEY_COLS = OLD_KEY_COLS || QUOTE_IDENTIFIER('OLD_' || C.COLNAME) || ', ';
+            SET NEW_KEY_COLS = NEW_KEY_COLS || QUOTE_IDENTIFIER('NEW_' || C.COLNAME) || ', ';
+            SET OLD_KEY_NEW = OLD_KEY_NEW || ' AND ' || QUOTE_IDENTIFIER('OLD_' || C.COLNAME) || ' = NEW.' || QUOTE_IDENTIFIER(C.COLNAME);
+            SET NEW_KEY_NEW = NEW_KEY_NEW || ' AND ' || QUOTE_IDENTIFIER('NEW_' || C.COLNAME) || ' = NEW.' || QUOTE_IDENTIFIER(C.COLNAME);
+            SET NEW_KEY_OLD = NEW_KEY_OLD || ' AND ' || QUOTE_IDENTIFIER('NEW_' || C.COLNAME) || ' = OLD.' || QUOTE_IDENTIFIER(C.COLNAME);
+        END IF;
+    END FOR;
+    -- Create the changes table and its sequence, then populate the table from
+    -- the existing content of the history table
+    SET DDL =
+        'CREATE TABLE ' || DEST || ' AS '
+        || '('
+        || '    SELECT BIGINT(0) AS CHANGE_ID, C.*'
+        || '    FROM (' || X_HISTORY_CHANGES(SOURCE_SCHEMA, SOURCE_TABLE) || ') AS C'
+        || ') '
+        || 'WITH NO DATA IN ' || DEST_TBSPACE;
+    EXECUTE IMMEDIATE DDL;
+    SET DDL =
+        'CREATE SEQUENCE ' || SEQ || ' AS BIGINT START WITH 1 NO CYCLE ORDER';
+    EXECUTE IMMEDIATE DDL;
+    SET DDL =
+        'INSERT INTO ' || DEST || ' '
+        || 'SELECT NEXT VALUE FOR ' || SEQ || ', C.* '
+        || 'FROM (' || X_HISTORY_CHANGES(SOURCE_SCHEMA, SOURCE_TABLE) || ') AS C';
+    EXECUTE IMMEDIATE DDL;
+    -- Create a unique index on CHANGE_ID for consumers polling the table, and
+    -- indexes on the old and new keys for the maintenance triggers
+    SET DDL =
+        'CREATE UNIQUE INDEX ' || QUOTE_IDENTIFIER(DEST_SCHEMA) || '.' || QUOTE_IDENTIFIER(DEST_TABLE || '_PK') || ' '
+        || 'ON ' || DEST || '(CHANGE_ID)';
+    EXECUTE IMMEDIATE DDL;
+    SET DDL =
+        'CREATE INDEX ' || QUOTE_IDENTIFIER(DEST_SCHEMA) || '.' || QUOTE_IDENTIFIER(DEST_TABLE || '_IX1') || ' '
+        || 'ON ' || DEST || '(' || OLD_KEY_COLS || 'CHANGED)';
+    EXECUTE IMMEDIATE DDL;
+    SET DDL =
+        'CREATE INDEX ' || QUOTE_IDENTIFIER(DEST_SCHEMA) || '.' || QUOTE_IDENTIFIER(DEST_TABLE || '_IX2') || ' '
+        || 'ON ' || DEST || '(' || NEW_KEY_COLS || 'CHANGED)';
+    EXECUTE IMMEDIATE DDL;
+    -- Drop any existing triggers with the same name as the maintenance
+    -- triggers
+    FOR D AS
+        SELECT
+            'DROP TRIGGER ' || QUOTE_IDENTIFIER(TRIGSCHEMA) || '.' || QUOTE_IDENTIFIER(TRIGNAME) AS DROP_CMD
+        FROM
+            SYSCAT.TRIGGERS
+        WHERE
+            TABSCHEMA = SOURCE_SCHEMA
+            AND TABNAME = SOURCE_TABLE
+            AND TRIGSCHEMA = SOURCE_SCHEMA
+            AND TRIGNAME IN (
+                SOURCE_TABLE || '_INSERT',
+                SOURCE_TABLE || '_EXPIRE',
+                SOURCE_TABLE || '_UPDATE',
+                SOURCE_TABLE || '_DELETE'
+            )
+    DO
+        EXECUTE IMMEDIATE D.DROP_CMD;
+    END FOR;
+    -- Create the INSERT trigger. A new history row is either an insertion, or
+    -- (when the history trigger has just expired the prior row for the same
+    -- key) the second half of an update, in which case the DELETE change
+    -- recorded by the EXPIRE trigger is converted into an UPDATE. A DELETE
+    -- change which has already been published is left alone and the new row
+    -- recorded as an insertion instead, as consumers may have applied it
+    SET DDL =
+        'CREATE TRIGGER ' || QUOTE_IDENTIFIER(SOURCE_SCHEMA) || '.' || QUOTE_IDENTIFIER(SOURCE_TABLE || '_INSERT')
+        || '    AFTER INSERT ON ' || QUOTE_IDENTIFIER(SOURCE_SCHEMA) || '.' || QUOTE_IDENTIFIER(SOURCE_TABLE)
+        || '    REFERENCING NEW AS NEW'
+        || '    FOR EACH ROW '
+        || 'BEGIN ATOMIC'
+        || '    IF EXISTS ('
+        || '        SELECT 1 FROM ' || DEST
+        || '        WHERE CHANGED = NEW.' || EFFNAME
+        || '        AND CHANGE = ''DELETE''' || OLD_KEY_NEW
+        || '        AND CHANGE_ID > ' || PUBLISHED
+        || '    ) THEN'
+        || '        UPDATE ' || DEST || ' SET'
+        || '            CHANGE_ID = NEXT VALUE FOR ' || SEQ || ','
+        || '            CHANGE = ''UPDATE''' || NEW_SET
+        || '        WHERE CHANGED = NEW.' || EFFNAME
+        || '        AND CHANGE = ''DELETE''' || OLD_KEY_NEW
+        || '        AND CHANGE_ID > ' || PUBLISHED || ';'
+        || '    ELSE'
+        || '        INSERT INTO ' || DEST || ' (CHANGE_ID, CHANGED, CHANGE' || NEW_COLS || ')'
+        || '        VALUES (NEXT VALUE FOR ' || SEQ || ', NEW.' || EFFNAME || ', ''INSERT''' || ROW_VALS || ');'
+        || '    END IF; '
+        || 'END';
+    EXECUTE IMMEDIATE DDL;
+    -- Create the EXPIRE trigger which records a deletion on the day after the
+    -- new expiry date of a history row
+    SET DDL =
+        'CREATE TRIGGER ' || QUOTE_IDENTIFIER(SOURCE_SCHEMA) || '.' || QUOTE_IDENTIFIER(SOURCE_TABLE || '_EXPIRE')
+        || '    AFTER UPDATE OF ' || EXPNAME
+        || '    ON ' || QUOTE_IDENTIFIER(SOURCE_SCHEMA) || '.' || QUOTE_IDENTIFIER(SOURCE_TABLE)
+        || '    REFERENCING OLD AS OLD NEW AS NEW'
+        || '    FOR EACH ROW '
+        || 'WHEN ('
+        || '    OLD.' || EXPNAME || ' = ' || EXPDEFAULT
+        || '    AND NEW.' || EXPNAME || ' < ' || EXPDEFAULT
+        || ') '
+        || 'BEGIN ATOMIC'
+        || '    INSERT INTO ' || DEST || ' (CHANGE_ID, CHANGED, CHANGE' || OLD_COLS || ')'
+        || '    VALUES (NEXT VALUE FOR ' || SEQ || ', NEW.' || EXPNAME || ' + ' || STEP || ', ''DELETE''' || ROW_VALS || '); '
+        || 'END';
+    EXECUTE IMMEDIATE DDL;
+    -- Create the UPDATE trigger which handles the history triggers updating a
+    -- current history row in place (when several changes occur within one
+    -- period)
+    SET DDL =
+        'CREATE TRIGGER ' || QUOTE_IDENTIFIER(SOURCE_SCHEMA) || '.' || QUOTE_IDENTIFIER(SOURCE_TABLE || '_UPDATE')
+        || '    AFTER UPDATE ON ' || QUOTE_IDENTIFIER(SOURCE_SCHEMA) || '.' || QUOTE_IDENTIFIER(SOURCE_TABLE)
+        || '    REFERENCING OLD AS OLD NEW AS NEW'
+        || '    FOR EACH ROW '
+        || 'WHEN ('
+        || '    OLD.' || EXPNAME || ' = ' || EXPDEFAULT
+        || '    AND NEW.' || EXPNAME || ' = ' || EXPDEFAULT
+        || '    AND OLD.' || EFFNAME || ' = NEW.' || EFFNAME
+        || ') '
+        || 'BEGIN ATOMIC'
+        || '    UPDATE ' || DEST || ' SET'
+        || '        CHANGE_ID = NEXT VALUE FOR ' || SEQ || NEW_SET
+        || '    WHERE CHANGED = NEW.' || EFFNAME
+        || '    AND CHANGE IN (''INSERT'', ''UPDATE'')' || NEW_KEY_NEW || '; '
+        || 'END';
+    EXECUTE IMMEDIATE DDL;
+    -- Create the DELETE trigger which handles the history triggers removing a
+    -- current history row (when a row is deleted in the same period it was
+    -- inserted or updated). An insertion is compensated by a new deletion
+    -- (consumers may already have seen the insertion), while an update becomes
+    -- a deletion of the prior (expired) row
+    SET DDL =
+        'CREATE TRIGGER ' || QUOTE_IDENTIFIER(SOURCE_SCHEMA) || '.' || QUOTE_IDENTIFIER(SOURCE_TABLE || '_DELETE')
+        || '    AFTER DELETE ON ' || QUOTE_IDENTIFIER(SOURCE_SCHEMA) || '.' || QUOTE_IDENTIFIER(SOURCE_TABLE)
+        || '    REFERENCING OLD AS OLD'
+        || '    FOR EACH ROW '
+        || 'WHEN ('
+        || '    OLD.' || EXPNAME || ' = ' || EXPDEFAULT
+        || ') '
+        || 'BEGIN ATOMIC'
+        || '    IF EXISTS ('
+        || '        SELECT 1 FROM ' || DEST
+        || '        WHERE CHANGED = OLD.' || EFFNAME
+        || '        AND CHANGE = ''INSERT''' || NEW_KEY_OLD
+        || '    ) THEN'
+        || '        INSERT INTO ' || DEST || ' (CHANGE_ID, CHANGED, CHANGE' || OLD_COLS || ')'
+        || '        VALUES (NEXT VALUE FOR ' || SEQ || ', OLD.' || EFFNAME || ', ''DELETE''' || OLD_VALS || ');'
+        || '    END IF;'
+        || '    UPDATE ' || DEST || ' SET'
+        || '        CHANGE_ID = NEXT VALUE FOR ' || SEQ || ','
+        || '        CHANGE = ''DELETE''' || NEW_NULL
+        || '    WHERE CHANGED = OLD.' || EFFNAME
+        || '    AND CHANGE = ''UPDATE''' || NEW_KEY_OLD || '; '
+        || 'END';
+    EXECUTE IMMEDIATE DDL;
+    -- Store the source table's authorizations, then redirect them to the
+    -- destination table filtering out those authorizations which should be
+    -- excluded
+    CALL SAVE_AUTH(SOURCE_SCHEMA, SOURCE_TABLE);
+    UPDATE SAVED_AUTH SET
+        TABSCHEMA = DEST_SCHEMA,
+        TABNAME = DEST_TABLE,
+        DELETEAUTH = 'N',
+        INSERTAUTH = 'N',
+        UPDATEAUTH = 'N',
+        INDEXAUTH = 'N',
+        REFAUTH = 'N'
+    WHERE TABSCHEMA = SOURCE_SCHEMA
+        AND TABNAME = SOURCE_TABLE;
+    CALL RESTORE_AUTH(DEST_SCHEMA, DEST_TABLE);
+    -- Set up comments for the change fields then copy the comments for all
+    -- fields from the source table
+    SET DDL = 'COMMENT ON COLUMN '
+        || DEST || '.' || QUOTE_IDENTIFIER('CHANGE_ID')
+        || ' IS ' || QUOTE_STRING('Ascending identifier of this change, re-assigned whenever the change is altered');
+    EXECUTE IMMEDIATE DDL;
+    SET DDL = 'COMMENT ON COLUMN '
+        || DEST || '.' || QUOTE_IDENTIFIER('CHANGED')
+        || ' IS ' || QUOTE_STRING('The date/timestamp on which this row changed');
+    EXECUTE IMMEDIATE DDL;
+    SET DDL = 'COMMENT ON COLUMN '
+        || DEST || '.' || QUOTE_IDENTIFIER('CHANGE')
+        || ' IS ' || QUOTE_STRING('The type of change that occured (INSERT/UPDATE/DELETE)');
+    EXECUTE IMMEDIATE DDL;
+    SET DDL = 'COMMENT ON TABLE '
+        || DEST
+        || ' IS ' || QUOTE_STRING('Table showing the content of @' || SOURCE_SCHEMA || '.' || SOURCE_TABLE || ' as a series of changes');
+    EXECUTE IMMEDIATE DDL;
+    FOR C AS
+        SELECT
+            VARCHAR('COMMENT ON COLUMN '
+                || QUOTE_IDENTIFIER(DEST_SCHEMA) || '.' || QUOTE_IDENTIFIER(DEST_TABLE) || '.' || QUOTE_IDENTIFIER('OLD_' || COLNAME)
+                || ' IS ' || QUOTE_STRING('Value of @' || SOURCE_SCHEMA || '.' || SOURCE_TABLE || '.' || COLNAME || ' prior to change')) AS COMMENT_OLD_STMT,
+            VARCHAR('COMMENT ON COLUMN '
+                || QUOTE_IDENTIFIER(DEST_SCHEMA) || '.' || QUOTE_IDENTIFIER(DEST_TABLE) || '.' || QUOTE_IDENTIFIER('NEW_' || COLNAME)
+                || ' IS ' || QUOTE_STRING('Value of @' || SOURCE_SCHEMA || '.' || SOURCE_TABLE || '.' || COLNAME || ' after change')) AS COMMENT_NEW_STMT
+        FROM SYSCAT.COLUMNS
+        WHERE TABSCHEMA = SOURCE_SCHEMA
+        AND TABNAME = SOURCE_TABLE
+        AND REMARKS IS NOT NULL
+        AND COLNO >= 2
+    DO
+        EXECUTE IMMEDIATE C.COMMENT_OLD_STMT;
+        EXECUTE IMMEDIATE C.COMMENT_NEW_STMT;
+    END FOR;
+END!
+
+CREATE PROCEDURE CREATE_HISTORY_CHANGES_TABLE(
+    SOURCE_TABLE VARCHAR(128),
+    DEST_TABLE VARCHAR(128),
+    DEST_TBSPACE VARCHAR(18)
+)
+    SPECIFIC CREATE_HISTORY_CHANGES_TABLE2
+    MODIFIES SQL DATA
+    NOT DETERMINISTIC
+    NO EXTERNAL ACTION
+    LANGUAGE SQL
+BEGIN ATOMIC
+    CALL CREATE_HISTORY_CHANGES_TABLE(CURRENT SCHEMA, SOURCE_TABLE, CURRENT SCHEMA, DEST_TABLE, DEST_TBSPACE);
+END!
+
+CREATE PROCEDURE CREATE_HISTORY_CHANGES_TABLE(
+    SOURCE_TABLE VARCHAR(128),
+    DEST_TABLE VARCHAR(128)
+)
+    SPECIFIC CREATE_HISTORY_CHANGES_TABLE3
+    MODIFIES SQL DATA
+    NOT DETERMINISTIC
+    NO EXTERNAL ACTION
+    LANGUAGE SQL
+BEGIN ATOMIC
+    CALL CREATE_HISTORY_CHANGES_TABLE(SOURCE_TABLE, DEST_TABLE, (
+        SELECT TBSPACE
+        FROM SYSCAT.TABLES
+        WHERE TABSCHEMA = CURRENT SCHEMA
+        AND TABNAME = SOURCE_TABLE
+    ));
+END!
+
+CREATE PROCEDURE CREATE_HISTORY_CHANGES_TABLE(
+    SOURCE_TABLE VARCHAR(128)
+)
+    SPECIFIC CREATE_HISTORY_CHANGES_TABLE4
+    MODIFIES SQL DATA
+    NOT DETERMINISTIC
+    NO EXTERNAL ACTION
+    LANGUAGE SQL
+BEGIN ATOMIC
+    CALL CREATE_HISTORY_CHANGES_TABLE(SOURCE_TABLE, REPLACE(SOURCE_TABLE, '_HISTORY', '_CHANGES'));
+END!
+
+GRANT EXECUTE ON SPECIFIC PROCEDURE CREATE_HISTORY_CHANGES_TABLE1 TO ROLE UTILS_HISTORY_USER!
+GRANT EXECUTE ON SPECIFIC PROCEDURE CREATE_HISTORY_CHANGES_TABLE2 TO ROLE UTILS_HISTORY_USER!
+GRANT EXECUTE ON SPECIFIC PROCEDURE CREATE_HISTORY_CHANGES_TABLE3 TO ROLE UTILS_HISTORY_USER!
+GRANT EXECUTE ON SPECIFIC PROCEDURE CREATE_HISTORY_CHANGES_TABLE4 TO ROLE UTILS_HISTORY_USER!
+GRANT EXECUTE ON SPECIFIC PROCEDURE CREATE_HISTORY_CHANGES_TABLE1 TO ROLE UTILS_HISTORY_ADMIN WITH GRANT OPTION!
+GRANT EXECUTE ON SPECIFIC PROCEDURE CREATE_HISTORY_CHANGES_TABLE2 TO ROLE UTILS_HISTORY_ADMIN WITH GRANT OPTION!
+GRANT EXECUTE ON SPECIFIC PROCEDURE CREATE_HISTORY_CHANGES_TABLE3 TO ROLE UTILS_HISTORY_ADMIN WITH GRANT OPTION!
+GRANT EXECUTE ON SPECIFIC PROCEDURE CREATE_HISTORY_CHANGES_TABLE4 TO ROLE UTILS_HISTORY_ADMIN WITH GRANT OPTION!
+
+COMMENT ON SPECIFIC PROCEDURE CREATE_HISTORY_CHANGES_TABLE1
+    IS 'Creates an "OLD vs NEW" changes table, maintained by triggers, on top of the specified history table'!
+COMMENT ON SPECIFIC PROCEDURE CREATE_HISTORY_CHANGES_TABLE2
+    IS 'Creates an "OLD vs NEW" changes table, maintained by triggers, on top of the specified history table'!
+COMMENT ON SPECIFIC PROCEDURE CREATE_HISTORY_CHANGES_TABLE3
+    IS 'Creates an "OLD vs NEW" changes table, maintained by triggers, on top of the specified history table'!
+COMMENT ON SPECIFIC PROCEDURE CREATE_HISTORY_CHANGES_TABLE4
+    IS 'Creates an "OLD vs NEW" changes table, maintained by triggers, on top of the specified history table'!
+
+-- HISTORY_CHANGES_MARKS
+-------------------------------------------------------------------------------
+-- The HISTORY_CHANGES_MARKS table records, for each consumer of each changes
+-- table created by CREATE_HISTORY_CHANGES_TABLE, the highest CHANGE_ID that
+-- the consumer has been handed by MARK_HISTORY_CHANGES.
+-------------------------------------------------------------------------------
+
+CREATE TABLE HISTORY_CHANGES_MARKS (
+    TABSCHEMA        VARCHAR(128) NOT NULL,
+    TABNAME          VARCHAR(128) NOT NULL,
+    CONSUMER         VARCHAR(128) NOT NULL,
+    CHANGE_ID        BIGINT DEFAULT 0 NOT NULL,
+    MARKED           TIMESTAMP DEFAULT CURRENT TIMESTAMP NOT NULL
+)!
+
+CREATE UNIQUE INDEX HISTORY_CHANGES_MARKS_PK
+    ON HISTORY_CHANGES_MARKS (TABSCHEMA, TABNAME, CONSUMER)!
+
+ALTER TABLE HISTORY_CHANGES_MARKS
+    ADD CONSTRAINT PK PRIMARY KEY (TABSCHEMA, TABNAME, CONSUMER)!
+
+GRANT CONTROL ON TABLE HISTORY_CHANGES_MARKS TO ROLE UTILS_HISTORY_ADMIN WITH GRANT OPTION!
+GRANT SELECT ON TABLE HISTORY_CHANGES_MARKS TO ROLE UTILS_HISTORY_USER!
+
+COMMENT ON TABLE HISTORY_CHANGES_MARKS
+    IS 'Utility table used by MARK_HISTORY_CHANGES to store the high-water mark of each consumer of a changes table'!
+
+-- MARK_HISTORY_CHANGES(ASCHEMA, ATABLE, CONSUMER, FROM_ID, TO_ID)
+-- MARK_HISTORY_CHANGES(ATABLE, CONSUMER, FROM_ID, TO_ID)
+-------------------------------------------------------------------------------
+-- The MARK_HISTORY_CHANGES procedure is intended for consumers which poll a
+-- changes table created by CREATE_HISTORY_CHANGES_TABLE. Given the name of the
+-- changes table and an arbitrary consumer name, it returns in FROM_ID the
+-- CHANGE_ID last handed to the consumer (or 0 on the first call), and in TO_ID
+-- the highest CHANGE_ID currently present in the table, recording the latter
+-- as the consumer's new high-water mark. The consumer should then read those
+-- rows with a CHANGE_ID greater than FROM_ID and less than or equal to TO_ID.
+--
+-- CHANGE_ID values are assigned in ascending order, but a transaction may
+-- commit a change after another transaction has committed a later one. To
+-- guarantee that no change at or below TO_ID is still to be committed, the
+-- query which finds TO_ID waits for the outcome of any uncommitted changes
+-- above FROM_ID (rather than skipping them). It holds no locks on the changes
+-- table once it completes, so writers are not held up while the consumer
+-- reads its changes. If the consumer rolls back, the high-water mark is rolled
+-- back with it and the same range will be returned by the next call.
+--
+-- If ASCHEMA is not specified it defaults to the current schema.
+-------------------------------------------------------------------------------
+
+CREATE PROCEDURE MARK_HISTORY_CHANGES(
+    ASCHEMA VARCHAR(128),
+    ATABLE VARCHAR(128),
+    CONSUMER VARCHAR(128),
+    OUT FROM_ID BIGINT,
+    OUT TO_ID BIGINT
+)
+    SPECIFIC MARK_HISTORY_CHANGES1
+    MODIFIES SQL DATA
+    NOT DETERMINISTIC
+    NO EXTERNAL ACTION
+    LANGUAGE SQL
+BEGIN
+    DECLARE DDL VARCHAR(1000) DEFAULT '';
+    DECLARE ATTRS VARCHAR(100) DEFAULT 'WITH CS WAIT FOR OUTCOME';
+    DECLARE PENDING BIGINT DEFAULT 0;
+    DECLARE MAX_STMT STATEMENT;
+    DECLARE MAX_CUR CURSOR FOR MAX_STMT;
+
+    CALL ASSERT_TABLE_EXISTS(ASCHEMA, ATABLE);
+    CALL ASSERT_COLUMN_EXISTS(ASCHEMA, ATABLE, 'CHANGE_ID');
+    SET FROM_ID = COALESCE((
+        SELECT CHANGE_ID
+        FROM HISTORY_CHANGES_MARKS
+        WHERE TABSCHEMA = ASCHEMA
+        AND TABNAME = ATABLE
+        AND CONSUMER = MARK_HISTORY_CHANGES.CONSUMER
+    ), 0);
+    -- Counting the rows above FROM_ID (instead of just reading the highest
+    -- CHANGE_ID) ensures every uncommitted change in the range is visited and
+    -- waited for. If there are none, TO_ID is simply the highest CHANGE_ID
+    SET DDL =
+        'SELECT COUNT(*), COALESCE(MAX(CHANGE_ID), ('
+        || '    SELECT COALESCE(MAX(CHANGE_ID), 0)'
+        || '    FROM ' || QUOTE_IDENTIFIER(ASCHEMA) || '.' || QUOTE_IDENTIFIER(ATABLE)
+        || ')) '
+        || 'FROM ' || QUOTE_IDENTIFIER(ASCHEMA) || '.' || QUOTE_IDENTIFIER(ATABLE) || ' '
+        || 'WHERE CHANGE_ID > ?';
+    PREPARE MAX_STMT ATTRIBUTES ATTRS FROM DDL;
+    OPEN MAX_CUR USING FROM_ID;
+    FETCH MAX_CUR INTO PENDING, TO_ID;
+    CLOSE MAX_CUR;
+    -- A change table which has been re-created restarts its CHANGE_ID values,
+    -- in which case the consumer must start again from the beginning
+    IF TO_ID < FROM_ID THEN
+        SET FROM_ID = 0;
+    END IF;
+    MERGE INTO HISTORY_CHANGES_MARKS AS DEST
+        USING (
+            VALUES (ASCHEMA, ATABLE, CONSUMER, TO_ID)
+        ) AS SRC (TABSCHEMA, TABNAME, CONSUMER, CHANGE_ID)
+        ON SRC.TABSCHEMA = DEST.TABSCHEMA
+        AND SRC.TABNAME = DEST.TABNAME
+        AND SRC.CONSUMER = DEST.CONSUMER
+        WHEN MATCHED THEN
+            UPDATE SET
+                CHANGE_ID = SRC.CHANGE_ID,
+                MARKED = CURRENT TIMESTAMP
+        WHEN NOT MATCHED THEN
+            INSERT (TABSCHEMA, TABNAME, CONSUMER, CHANGE_ID)
+            VALUES (SRC.TABSCHEMA, SRC.TABNAME, SRC.CONSUMER, SRC.CHANGE_ID);
+END!
+
+CREATE PROCEDURE MARK_HISTORY_CHANGES(
+    ATABLE VARCHAR(128),
+    CONSUMER VARCHAR(128),
+    OUT FROM_ID BIGINT,
+    OUT TO_ID BIGINT
+)
+    SPECIFIC MARK_HISTORY_CHANGES2
+    MODIFIES SQL DATA
+    NOT DETERMINISTIC
+    NO EXTERNAL ACTION
+    LANGUAGE SQL
+BEGIN ATOMIC
+    CALL MARK_HISTORY_CHANGES(CURRENT SCHEMA, ATABLE, CONSUMER, FROM_ID, TO_ID);
+END!
+
+GRANT EXECUTE ON SPECIFIC PROCEDURE MARK_HISTORY_CHANGES1 TO ROLE UTILS_HISTORY_USER!
+GRANT EXECUTE ON SPECIFIC PROCEDURE MARK_HISTORY_CHANGES2 TO ROLE UTILS_HISTORY_USER!
+GRANT EXECUTE ON SPECIFIC PROCEDURE MARK_HISTORY_CHANGES1 TO ROLE UTILS_HISTORY_ADMIN WITH GRANT OPTION!
+GRANT EXECUTE ON SPECIFIC PROCEDURE MARK_HISTORY_CHANGES2 TO ROLE UTILS_HISTORY_ADMIN WITH GRANT OPTION!
+
+COMMENT ON SPECIFIC PROCEDURE MARK_HISTORY_CHANGES1
+    IS 'Returns the range of CHANGE_ID values a consumer has not yet read from a changes table, and records the new high-water mark'!
+COMMENT ON SPECIFIC PROCEDURE MARK_HISTORY_CHANGES2
+    IS 'Returns the range of CHANGE_ID values a consumer has not yet read from a changes table, and records the new high-water mark'!
+
 -- CREATE_HISTORY_SNAPSHOTS(SOURCE_SCHEMA, SOURCE_TABLE, DEST_SCHEMA, DEST_VIEW, RESOLUTION)
 -- CREATE_HISTORY_SNAPSHOTS(SOURCE_TABLE, DEST_VIEW, RESOLUTION)
 -- CREATE_HISTORY_SNAPSHOTS(SOURCE_TABLE, RESOLUTION)
@@ -1340,6 +2122,10 @@ COMMENT ON SPECIFIC PROCEDURE CREATE_HISTORY_SNAPSHOTS3
 -- effective dates of new history records. For example, if the source table is
 -- only updated a week in arrears, then OFFSET could be set to '- 7 DAYS' to
 -- cause the effective dates to be accurate.
+--
+-- The INSERT, UPDATE and DELETE triggers do nothing in a session which has set
+-- the BYPASS_TRIGGERS variable to 'Y' (the KEYCHG trigger, which prevents
+-- updates to the key of the source table, is never bypassed).
 -------------------------------------------------------------------------------
 
 CREATE PROCEDURE CREATE_HISTORY_TRIGGERS(
@@ -1402,6 +2188,7 @@ BEGIN ATOMIC
         || '    AFTER INSERT ON ' || QUOTE_IDENTIFIER(SOURCE_SCHEMA) || '.' || QUOTE_IDENTIFIER(SOURCE_TABLE)
         || '    REFERENCING NEW AS NEW'
         || '    FOR EACH ROW '
+        || 'WHEN (' || X_BYPASS_TRIGGERS_WHEN() || ') '
         || 'BEGIN ATOMIC '
         ||      X_HISTORY_INSERT(SOURCE_SCHEMA, SOURCE_TABLE, DEST_SCHEMA, DEST_TABLE, RESOLUTION, OFFSET) || ';'
         || 'END';
@@ -1415,7 +2202,9 @@ BEGIN ATOMIC
         || '    REFERENCING OLD AS OLD NEW AS NEW'
         || '    FOR EACH ROW '
         || 'WHEN ('
-        ||      X_HISTORY_UPDATE_WHEN(SOURCE_SCHEMA, SOURCE_TABLE, CHAR('N'))
+        || '    ' || X_BYPASS_TRIGGERS_WHEN() || ' AND ('
+        ||          X_HISTORY_UPDATE_WHEN(SOURCE_SCHEMA, SOURCE_TABLE, CHAR('N'))
+        || '    )'
         || ') '
         || 'BEGIN ATOMIC'
         || '    DECLARE CHK_DATE DATE;'
@@ -1436,6 +2225,7 @@ BEGIN ATOMIC
         || '    AFTER DELETE ON ' || QUOTE_IDENTIFIER(SOURCE_SCHEMA) || '.' || QUOTE_IDENTIFIER(SOURCE_TABLE)
         || '    REFERENCING OLD AS OLD'
         || '    FOR EACH ROW '
+        || 'WHEN (' || X_BYPASS_TRIGGERS_WHEN() || ') '
         || 'BEGIN ATOMIC'
         || '    DECLARE CHK_DATE DATE;'
         || '    SET CHK_DATE = ('
@@ -1510,4 +2300,389 @@ COMMENT ON SPECIFIC PROCEDURE CREATE_HISTORY_TRIGGERS3
 COMMENT ON SPECIFIC PROCEDURE CREATE_HISTORY_TRIGGERS4
     IS 'Creates the triggers to link the specified table to its corresponding history table'!
 
+-- ARCHIVE_HISTORY(SOURCE_SCHEMA, SOURCE_TABLE, RETENTION, ARCHIVE_SCHEMA)
+-- ARCHIVE_HISTORY(SOURCE_TABLE, RETENTION, ARCHIVE_SCHEMA)
+-- ARCHIVE_HISTORY(SOURCE_TABLE, RETENTION)
+-------------------------------------------------------------------------------
+-- The ARCHIVE_HISTORY procedure performs routine maintenance of a history
+-- table created by CREATE_HISTORY_TABLE with a PARTITION_RESOLUTION. Firstly,
+-- it adds partitions (each the same size as the last existing partition) until
+-- the partitions cover at least a year ahead. Secondly, if RETENTION is not
+-- NULL, it detaches all partitions which lie entirely before the current date
+-- minus RETENTION (an SQL labeled duration such as '2 YEARS') into tables
+-- within ARCHIVE_SCHEMA, named after SOURCE_TABLE with the start date of the
+-- partition as a suffix.
+--
+-- Rows which were still effective at the start of the first retained
+-- partition are never touched. A partition which contains such rows is not
+-- detached; instead its expired rows are moved to the archive table in
+-- batches, leaving the effective rows in place with their original EFFECTIVE
+-- dates. The history triggers only ever manipulate unexpired rows, and the
+-- procedure commits after each step (and each batch) so that locks held
+-- against the history table are short lived and the history triggers are not
+-- blocked. For this reason it must not be called within an atomic block.
+--
+-- If ARCHIVE_SCHEMA is not specified it defaults to SOURCE_SCHEMA. If
+-- SOURCE_SCHEMA is not specified it defaults to the current schema.
+-------------------------------------------------------------------------------
+
+CREATE PROCEDURE ARCHIVE_HISTORY(
+    SOURCE_SCHEMA VARCHAR(128),
+    SOURCE_TABLE VARCHAR(128),
+    RETENTION VARCHAR(100),
+    ARCHIVE_SCHEMA VARCHAR(128)
+)
+    SPECIFIC ARCHIVE_HISTORY1
+    MODIFIES SQL DATA
+    NOT DETERMINISTIC
+    NO EXTERNAL ACTION
+    LANGUAGE SQL
+BEGIN
+    DECLARE DDL VARCHAR(4000) DEFAULT '';
+    DECLARE EFFNAME VARCHAR(258) DEFAULT '';
+    DECLARE EXPNAME VARCHAR(258) DEFAULT '';
+    DECLARE PART_NAME VARCHAR(128) DEFAULT '';
+    DECLARE PART_LOW TIMESTAMP DEFAULT NULL;
+    DECLARE PART_HIGH TIMESTAMP DEFAULT NULL;
+    DECLARE PART_NEXT TIMESTAMP DEFAULT NULL;
+    DECLARE RETAIN_FROM TIMESTAMP DEFAULT NULL;
+    DECLARE CUTOFF TIMESTAMP DEFAULT NULL;
+    DECLARE ARCHIVE_TABLE VARCHAR(128) DEFAULT '';
+    DECLARE PART_WHERE VARCHAR(1000) DEFAULT '';
+    DECLARE PART_LIVE CHAR(1) DEFAULT 'N';
+    DECLARE BATCH_SIZE INTEGER DEFAULT 10000;
+    DECLARE MOVED INTEGER DEFAULT 0;
+    DECLARE RETAIN_STMT STATEMENT;
+    DECLARE RETAIN_CUR CURSOR FOR RETAIN_STMT;
+    DECLARE LIVE_STMT STATEMENT;
+    DECLARE LIVE_CUR CURSOR FOR LIVE_STMT;
+    DECLARE MOVE_STMT STATEMENT;
+    DECLARE MOVE_CUR CURSOR FOR MOVE_STMT;
+
+    CALL ASSERT_TABLE_EXISTS(SOURCE_SCHEMA, SOURCE_TABLE);
+    IF NOT EXISTS (
+        SELECT 1
+        FROM SYSCAT.DATAPARTITIONEXPRESSION
+        WHERE TABSCHEMA = SOURCE_SCHEMA
+        AND TABNAME = SOURCE_TABLE
+    ) THEN
+        CALL SIGNAL_STATE(HISTORY_PARTITION_STATE, 'History table is not range partitioned');
+    END IF;
+    SET EFFNAME = QUOTE_IDENTIFIER(X_HISTORY_EFFNAME(SOURCE_SCHEMA, SOURCE_TABLE));
+    SET EXPNAME = QUOTE_IDENTIFIER(X_HISTORY_EXPNAME(SOURCE_SCHEMA, SOURCE_TABLE));
+    -- Add partitions, each the same size as the last, until the partitions
+    -- cover a year ahead. The size of a partition is calculated as a timestamp
+    -- duration which ensures that, for example, monthly partitions remain
+    -- monthly regardless of the number of days in each month
+    SELECT X_HISTORY_PARTVALUE(LOWVALUE), X_HISTORY_PARTVALUE(HIGHVALUE)
+        INTO PART_LOW, PART_HIGH
+        FROM SYSCAT.DATAPARTITIONS
+        WHERE TABSCHEMA = SOURCE_SCHEMA
+        AND TABNAME = SOURCE_TABLE
+        AND STATUS = ''
+        ORDER BY SEQNO DESC
+        FETCH FIRST 1 ROW ONLY;
+    IF PART_LOW IS NOT NULL AND PART_HIGH IS NOT NULL THEN
+        WHILE PART_HIGH <= CURRENT TIMESTAMP + 1 YEAR DO
+            SET PART_NEXT = PART_HIGH + (PART_HIGH - PART_LOW);
+            SET DDL = 'ALTER TABLE ' || QUOTE_IDENTIFIER(SOURCE_SCHEMA) || '.' || QUOTE_IDENTIFIER(SOURCE_TABLE)
+                || ' ADD PARTITION'
+                || ' STARTING ' || X_HISTORY_PARTLITERAL(SOURCE_SCHEMA, SOURCE_TABLE, PART_HIGH)
+                || ' ENDING ' || X_HISTORY_PARTLITERAL(SOURCE_SCHEMA, SOURCE_TABLE, PART_NEXT) || ' EXCLUSIVE';
+            EXECUTE IMMEDIATE DDL;
+            SET PART_LOW = PART_HIGH;
+            SET PART_HIGH = PART_NEXT;
+        END WHILE;
+        COMMIT;
+    END IF;
+    IF RETENTION IS NOT NULL THEN
+        -- Find the latest partition boundary which lies before the retention
+        -- period; everything prior to this is to be archived
+        SET DDL = 'VALUES CURRENT TIMESTAMP - ' || RETENTION;
+        PREPARE RETAIN_STMT FROM DDL;
+        OPEN RETAIN_CUR;
+        FETCH RETAIN_CUR INTO RETAIN_FROM;
+        CLOSE RETAIN_CUR;
+        SET CUTOFF = (
+            SELECT MAX(X_HISTORY_PARTVALUE(HIGHVALUE))
+            FROM SYSCAT.DATAPARTITIONS
+            WHERE TABSCHEMA = SOURCE_SCHEMA
+            AND TABNAME = SOURCE_TABLE
+            AND STATUS = ''
+            AND X_HISTORY_PARTVALUE(HIGHVALUE) <= RETAIN_FROM
+        );
+        -- Archive the old partitions one at a time, oldest first. The catalog
+        -- is re-queried on each iteration (rather than using a cursor) as each
+        -- step is committed. A partition containing only rows which expired
+        -- before the cutoff is simply detached. Otherwise, the rows which were
+        -- still effective at the cutoff are left untouched (the history
+        -- triggers may yet expire or update them), and the expired rows are
+        -- moved to the archive table in committed batches
+        SET PART_HIGH = TIMESTAMP('0001-01-01', '00:00:00');
+        WHILE CUTOFF IS NOT NULL AND PART_HIGH IS NOT NULL DO
+            SET (PART_NAME, PART_LOW, PART_HIGH) = (
+                SELECT DATAPARTITIONNAME, X_HISTORY_PARTVALUE(LOWVALUE), X_HISTORY_PARTVALUE(HIGHVALUE)
+                FROM SYSCAT.DATAPARTITIONS
+                WHERE TABSCHEMA = SOURCE_SCHEMA
+                AND TABNAME = SOURCE_TABLE
+                AND STATUS = ''
+                AND X_HISTORY_PARTVALUE(HIGHVALUE) <= CUTOFF
+                AND X_HISTORY_PARTVALUE(HIGHVALUE) > PART_HIGH
+                ORDER BY SEQNO
+                FETCH FIRST 1 ROW ONLY
+            );
+            IF PART_HIGH IS NOT NULL THEN
+                SET ARCHIVE_TABLE = SOURCE_TABLE || '_' || COALESCE(VARCHAR_FORMAT(PART_LOW, 'YYYYMMDD'), 'MINVALUE');
+                SET PART_WHERE = EFFNAME || ' < ' || X_HISTORY_PARTLITERAL(SOURCE_SCHEMA, SOURCE_TABLE, PART_HIGH)
+                    || COALESCE(' AND ' || EFFNAME || ' >= ' || X_HISTORY_PARTLITERAL(SOURCE_SCHEMA, SOURCE_TABLE, PART_LOW), '');
+                SET DDL = 'VALUES CASE WHEN EXISTS ('
+                    || 'SELECT 1 FROM ' || QUOTE_IDENTIFIER(SOURCE_SCHEMA) || '.' || QUOTE_IDENTIFIER(SOURCE_TABLE)
+                    || ' WHERE ' || PART_WHERE
+                    || ' AND ' || EXPNAME || ' >= ' || X_HISTORY_PARTLITERAL(SOURCE_SCHEMA, SOURCE_TABLE, CUTOFF)
+                    || ') THEN ''Y'' ELSE ''N'' END';
+                PREPARE LIVE_STMT FROM DDL;
+                OPEN LIVE_CUR;
+                FETCH LIVE_CUR INTO PART_LIVE;
+                CLOSE LIVE_CUR;
+                IF PART_LIVE = 'N' AND NOT EXISTS (
+                    SELECT 1
+                    FROM SYSCAT.TABLES
+                    WHERE TABSCHEMA = ARCHIVE_SCHEMA
+                    AND TABNAME = ARCHIVE_TABLE
+                ) THEN
+                    SET DDL = 'ALTER TABLE ' || QUOTE_IDENTIFIER(SOURCE_SCHEMA) || '.' || QUOTE_IDENTIFIER(SOURCE_TABLE)
+                        || ' DETACH PARTITION ' || QUOTE_IDENTIFIER(PART_NAME)
+                        || ' INTO ' || QUOTE_IDENTIFIER(ARCHIVE_SCHEMA) || '.' || QUOTE_IDENTIFIER(ARCHIVE_TABLE);
+                    EXECUTE IMMEDIATE DDL;
+                    COMMIT;
+                ELSE
+                    IF NOT EXISTS (
+                        SELECT 1
+                        FROM SYSCAT.TABLES
+                        WHERE TABSCHEMA = ARCHIVE_SCHEMA
+                        AND TABNAME = ARCHIVE_TABLE
+                    ) THEN
+                        SET DDL = 'CREATE TABLE ' || QUOTE_IDENTIFIER(ARCHIVE_SCHEMA) || '.' || QUOTE_IDENTIFIER(ARCHIVE_TABLE)
+                            || ' LIKE ' || QUOTE_IDENTIFIER(SOURCE_SCHEMA) || '.' || QUOTE_IDENTIFIER(SOURCE_TABLE);
+                        EXECUTE IMMEDIATE DDL;
+                        COMMIT;
+                    END IF;
+                    -- Each batch is deleted and inserted into the archive
+                    -- table by a single statement, so an interrupted archive
+                    -- can simply be re-run
+                    SET DDL = 'WITH D AS ('
+                        || '    SELECT * FROM OLD TABLE ('
+                        || '        DELETE FROM ('
+                        || '            SELECT * FROM ' || QUOTE_IDENTIFIER(SOURCE_SCHEMA) || '.' || QUOTE_IDENTIFIER(SOURCE_TABLE)
+                        || '            WHERE ' || PART_WHERE
+                        || '            AND ' || EXPNAME || ' < ' || X_HISTORY_PARTLITERAL(SOURCE_SCHEMA, SOURCE_TABLE, CUTOFF)
+                        || '            FETCH FIRST ' || VARCHAR(BATCH_SIZE) || ' ROWS ONLY'
+                        || '        )'
+                        || '    )'
+                        || ') '
+                        || 'SELECT COUNT(*) FROM NEW TABLE ('
+                        || '    INSERT INTO ' || QUOTE_IDENTIFIER(ARCHIVE_SCHEMA) || '.' || QUOTE_IDENTIFIER(ARCHIVE_TABLE)
+                        || '    SELECT * FROM D'
+                        || ')';
+                    SET MOVED = BATCH_SIZE;
+                    WHILE MOVED >= BATCH_SIZE DO
+                        PREPARE MOVE_STMT FROM DDL;
+                        OPEN MOVE_CUR;
+                        FETCH MOVE_CUR INTO MOVED;
+                        CLOSE MOVE_CUR;
+                        COMMIT;
+                    END WHILE;
+                END IF;
+            END IF;
+        END WHILE;
+    END IF;
+END!
+
+CREATE PROCEDURE ARCHIVE_HISTORY(
+    SOURCE_TABLE VARCHAR(128),
+    RETENTION VARCHAR(100),
+    ARCHIVE_SCHEMA VARCHAR(128)
+)
+    SPECIFIC ARCHIVE_HISTORY2
+    MODIFIES SQL DATA
+    NOT DETERMINISTIC
+    NO EXTERNAL ACTION
+    LANGUAGE SQL
+BEGIN
+    CALL ARCHIVE_HISTORY(CURRENT SCHEMA, SOURCE_TABLE, RETENTION, ARCHIVE_SCHEMA);
+END!
+
+CREATE PROCEDURE ARCHIVE_HISTORY(
+    SOURCE_TABLE VARCHAR(128),
+    RETENTION VARCHAR(100)
+)
+    SPECIFIC ARCHIVE_HISTORY3
+    MODIFIES SQL DATA
+    NOT DETERMINISTIC
+    NO EXTERNAL ACTION
+    LANGUAGE SQL
+BEGIN
+    CALL ARCHIVE_HISTORY(CURRENT SCHEMA, SOURCE_TABLE, RETENTION, CURRENT SCHEMA);
+END!
+
+GRANT EXECUTE ON SPECIFIC PROCEDURE ARCHIVE_HISTORY1 TO ROLE UTILS_HISTORY_USER!
+GRANT EXECUTE ON SPECIFIC PROCEDURE ARCHIVE_HISTORY2 TO ROLE UTILS_HISTORY_USER!
+GRANT EXECUTE ON SPECIFIC PROCEDURE ARCHIVE_HISTORY3 TO ROLE UTILS_HISTORY_USER!
+GRANT EXECUTE ON SPECIFIC PROCEDURE ARCHIVE_HISTORY1 TO ROLE UTILS_HISTORY_ADMIN WITH GRANT OPTION!
+GRANT EXECUTE ON SPECIFIC PROCEDURE ARCHIVE_HISTORY2 TO ROLE UTILS_HISTORY_ADMIN WITH GRANT OPTION!
+GRANT EXECUTE ON SPECIFIC PROCEDURE ARCHIVE_HISTORY3 TO ROLE UTILS_HISTORY_ADMIN WITH GRANT OPTION!
+
+COMMENT ON SPECIFIC PROCEDURE ARCHIVE_HISTORY1
+    IS 'Adds future partitions to a partitioned history table, and detaches partitions older than the specified retention period'!
+COMMENT ON SPECIFIC PROCEDURE ARCHIVE_HISTORY2
+    IS 'Adds future partitions to a partitioned history table, and detaches partitions older than the specified retention period'!
+COMMENT ON SPECIFIC PROCEDURE ARCHIVE_HISTORY3
+    IS 'Adds future partitions to a partitioned history table, and detaches partitions older than the specified retention period'!
+
+-- COMPACT_HISTORY(SOURCE_SCHEMA, SOURCE_TABLE, RETENTION, RESOLUTION)
+-- COMPACT_HISTORY(SOURCE_TABLE, RETENTION, RESOLUTION)
+-------------------------------------------------------------------------------
+-- The COMPACT_HISTORY procedure reduces the resolution of the portion of a
+-- history table older than RETENTION (an SQL labeled duration such as
+-- '6 MONTHS') to RESOLUTION, which must be coarser than the resolution of
+-- the history table itself (see the CREATE_HISTORY_TRIGGERS documentation for
+-- the possible values). For each key, within each period of RESOLUTION, only
+-- the last version of the row is retained, with its EFFECTIVE date moved back
+-- to that of the first version within the period. In other words, the
+-- compacted history records the state of each row at the end of each period,
+-- and a row which was deleted and re-inserted within a period is treated as
+-- if it had existed throughout.
+--
+-- Only rows which expired before the start of the period containing the
+-- current date minus RETENTION are affected. As the history triggers only
+-- ever manipulate unexpired rows, and the procedure commits after compacting
+-- each period, compaction does not block the history triggers. For this
+-- reason it must not be called within an atomic block.
+--
+-- The history table does not need to be partitioned. If SOURCE_SCHEMA is not
+-- specified it defaults to the current schema.
+-------------------------------------------------------------------------------
+
+CREATE PROCEDURE COMPACT_HISTORY(
+    SOURCE_SCHEMA VARCHAR(128),
+    SOURCE_TABLE VARCHAR(128),
+    RETENTION VARCHAR(100),
+    RESOLUTION VARCHAR(11)
+)
+    SPECIFIC COMPACT_HISTORY1
+    MODIFIES SQL DATA
+    NOT DETERMINISTIC
+    NO EXTERNAL ACTION
+    LANGUAGE SQL
+BEGIN
+    DECLARE DDL CLOB(64K) DEFAULT '';
+    DECLARE EFFNAME VARCHAR(258) DEFAULT '';
+    DECLARE EXPNAME VARCHAR(258) DEFAULT '';
+    DECLARE TS_PREFIX VARCHAR(20) DEFAULT '';
+    DECLARE TS_SUFFIX VARCHAR(20) DEFAULT '';
+    DECLARE TS_PARAM VARCHAR(40) DEFAULT '';
+    DECLARE KEY_COLS CLOB(64K) DEFAULT '';
+    DECLARE KEY_JOIN CLOB(64K) DEFAULT '';
+    DECLARE PERIOD_START TIMESTAMP DEFAULT NULL;
+    DECLARE PERIOD_END TIMESTAMP DEFAULT NULL;
+    DECLARE CUTOFF TIMESTAMP DEFAULT NULL;
+    DECLARE RANGE_STMT STATEMENT;
+    DECLARE RANGE_CUR CURSOR FOR RANGE_STMT;
+    DECLARE NEXT_STMT STATEMENT;
+    DECLARE NEXT_CUR CURSOR FOR NEXT_STMT;
+    DECLARE MERGE_STMT STATEMENT;
+
+    CALL ASSERT_TABLE_EXISTS(SOURCE_SCHEMA, SOURCE_TABLE);
+    IF X_HISTORY_PERIODRANK(RESOLUTION) <= X_HISTORY_PERIODRANK(X_HISTORY_RESOLUTION(SOURCE_SCHEMA, SOURCE_TABLE)) THEN
+        CALL SIGNAL_STATE(HISTORY_PARTITION_STATE, 'RESOLUTION must be coarser than the resolution of the history table');
+    END IF;
+    SET EFFNAME = QUOTE_IDENTIFIER(X_HISTORY_EFFNAME(SOURCE_SCHEMA, SOURCE_TABLE));
+    SET EXPNAME = QUOTE_IDENTIFIER(X_HISTORY_EXPNAME(SOURCE_SCHEMA, SOURCE_TABLE));
+    -- Period boundaries are handled as TIMESTAMPs within the procedure, and
+    -- converted to the type of the EFFECTIVE column within the statements
+    IF X_HISTORY_PERIODSTEP(SOURCE_SCHEMA, SOURCE_TABLE) = '1 DAY' THEN
+        SET TS_PREFIX = 'TIMESTAMP(';
+        SET TS_SUFFIX = ', ''00:00:00'')';
+        SET TS_PARAM = 'DATE(CAST(? AS TIMESTAMP))';
+    ELSE
+        SET TS_PARAM = 'CAST(? AS TIMESTAMP)';
+    END IF;
+    FOR C AS
+        SELECT COLNAME
+        FROM SYSCAT.COLUMNS
+        WHERE TABSCHEMA = SOURCE_SCHEMA
+        AND TABNAME = SOURCE_TABLE
+        AND COLNO >= 2
+        AND COALESCE(KEYSEQ, 0) > 0
+        ORDER BY COLNO
+    DO
+        SET KEY_COLS = KEY_COLS || ', ' || QUOTE_IDENTIFIER(C.COLNAME);
+        SET KEY_JOIN = KEY_JOIN || ' AND T.' || QUOTE_IDENTIFIER(C.COLNAME) || ' = S.' || QUOTE_IDENTIFIER(C.COLNAME);
+    END FOR;
+    SET KEY_COLS = SUBSTR(KEY_COLS, 3);
+    -- Determine the first period to compact, and the cutoff
+    SET DDL =
+        'SELECT '
+        || TS_PREFIX || X_HISTORY_PERIODSTART(RESOLUTION, 'MIN(' || EFFNAME || ')') || TS_SUFFIX || ', '
+        || TS_PREFIX || X_HISTORY_PERIODSTART(RESOLUTION, X_HISTORY_EFFDEFAULT(SOURCE_SCHEMA, SOURCE_TABLE) || ' - ' || RETENTION) || TS_SUFFIX || ' '
+        || 'FROM ' || QUOTE_IDENTIFIER(SOURCE_SCHEMA) || '.' || QUOTE_IDENTIFIER(SOURCE_TABLE);
+    PREPARE RANGE_STMT FROM DDL;
+    OPEN RANGE_CUR;
+    FETCH RANGE_CUR INTO PERIOD_START, CUTOFF;
+    CLOSE RANGE_CUR;
+    -- Compact one period at a time, committing after each. Within a period,
+    -- the last version of each row (COMPACT_ROW = 1) is kept and given the
+    -- EFFECTIVE date of the first version; all prior versions are deleted
+    WHILE PERIOD_START < CUTOFF DO
+        SET DDL =
+            'VALUES ' || TS_PREFIX || X_HISTORY_PERIODSTART(RESOLUTION, TS_PARAM || ' + ' || X_HISTORY_PERIODLEN(RESOLUTION)) || TS_SUFFIX;
+        PREPARE NEXT_STMT FROM DDL;
+        OPEN NEXT_CUR USING PERIOD_START;
+        FETCH NEXT_CUR INTO PERIOD_END;
+        CLOSE NEXT_CUR;
+        SET DDL =
+            'MERGE INTO ' || QUOTE_IDENTIFIER(SOURCE_SCHEMA) || '.' || QUOTE_IDENTIFIER(SOURCE_TABLE) || ' AS T '
+            || 'USING ('
+            || '    SELECT ' || KEY_COLS || ', ' || EFFNAME || ','
+            || '        ROW_NUMBER() OVER (PARTITION BY ' || KEY_COLS || ' ORDER BY ' || EFFNAME || ' DESC) AS COMPACT_ROW,'
+            || '        MIN(' || EFFNAME || ') OVER (PARTITION BY ' || KEY_COLS || ') AS COMPACT_EFF'
+            || '    FROM ' || QUOTE_IDENTIFIER(SOURCE_SCHEMA) || '.' || QUOTE_IDENTIFIER(SOURCE_TABLE)
+            || '    WHERE ' || EFFNAME || ' >= ' || TS_PARAM
+            || '    AND ' || EFFNAME || ' < ' || TS_PARAM
+            || '    AND ' || EXPNAME || ' < ' || TS_PARAM
+            || ') AS S '
+            || 'ON T.' || EFFNAME || ' = S.' || EFFNAME || KEY_JOIN || ' '
+            || 'WHEN MATCHED AND S.COMPACT_ROW > 1 THEN DELETE '
+            || 'WHEN MATCHED AND S.COMPACT_EFF < T.' || EFFNAME || ' THEN UPDATE SET ' || EFFNAME || ' = S.COMPACT_EFF';
+        PREPARE MERGE_STMT FROM DDL;
+        EXECUTE MERGE_STMT USING PERIOD_START, PERIOD_END, CUTOFF;
+        COMMIT;
+        SET PERIOD_START = PERIOD_END;
+    END WHILE;
+END!
+
+CREATE PROCEDURE COMPACT_HISTORY(
+    SOURCE_TABLE VARCHAR(128),
+    RETENTION VARCHAR(100),
+    RESOLUTION VARCHAR(11)
+)
+    SPECIFIC COMPACT_HISTORY2
+    MODIFIES SQL DATA
+    NOT DETERMINISTIC
+    NO EXTERNAL ACTION
+    LANGUAGE SQL
+BEGIN
+    CALL COMPACT_HISTORY(CURRENT SCHEMA, SOURCE_TABLE, RETENTION, RESOLUTION);
+END!
+
+GRANT EXECUTE ON SPECIFIC PROCEDURE COMPACT_HISTORY1 TO ROLE UTILS_HISTORY_USER!
+GRANT EXECUTE ON SPECIFIC PROCEDURE COMPACT_HISTORY2 TO ROLE UTILS_HISTORY_USER!
+GRANT EXECUTE ON SPECIFIC PROCEDURE COMPACT_HISTORY1 TO ROLE UTILS_HISTORY_ADMIN WITH GRANT OPTION!
+GRANT EXECUTE ON SPECIFIC PROCEDURE COMPACT_HISTORY2 TO ROLE UTILS_HISTORY_ADMIN WITH GRANT OPTION!
+
+COMMENT ON SPECIFIC PROCEDURE COMPACT_HISTORY1
+    IS 'Reduces the resolution of the portion of a history table older than the specified retention period'!
+COMMENT ON SPECIFIC PROCEDURE COMPACT_HISTORY2
+    IS 'Reduces the resolution of the portion of a history table older than the specified retention period'!
+
 -- vim: set et sw=4 sts=4:
@@ -76,13 +76,13 @@ RETURN
                 WHEN 'GRAPHIC'    THEN ''''''''' || REPLACE(VARCHAR(TRIM(' || EXPRESSION || '), '''''''', '''''''''''') || '''''''''
                 WHEN 'VARCHAR'    THEN ''''''''' || REPLACE(' || EXPRESSION || ', '''''''', '''''''''''') || '''''''''
                 WHEN 'VARGRAPHIC' THEN ''''''''' || REPLACE(VARCHAR(' || EXPRESSION || '), '''''''', '''''''''''') || '''''''''
-                WHEN 'BIGINT'     THEN 'TRIM(CHAR(' || EXPRESSION || ')'
-                WHEN 'INTEGER'    THEN 'TRIM(CHAR(' || EXPRESSION || ')'
-                WHEN 'SMALLINT'   THEN 'TRIM(CHAR(' || EXPRESSION || ')'
-                WHEN 'DECFLOAT'   THEN 'TRIM(CHAR(' || EXPRESSION || ')'
-                WHEN 'DECIMAL'    THEN 'TRIM(CHAR(' || EXPRESSION || ')'
-                WHEN 'DOUBLE'     THEN 'TRIM(CHAR(' || EXPRESSION || ')'
-                WHEN 'REAL'       THEN 'TRIM(CHAR(' || EXPRESSION || ')'
+                WHEN 'BIGINT'     THEN 'TRIM(CHAR(' || EXPRESSION || '))'
+                WHEN 'INTEGER'    THEN 'TRIM(CHAR(' || EXPRESSION || '))'
+                WHEN 'SMALLINT'   THEN 'TRIM(CHAR(' || EXPRESSION || '))'
+                WHEN 'DECFLOAT'   THEN 'TRIM(CHAR(' || EXPRESSION || '))'
+                WHEN 'DECIMAL'    THEN 'TRIM(CHAR(' || EXPRESSION || '))'
+                WHEN 'DOUBLE'     THEN 'TRIM(CHAR(' || EXPRESSION || '))'
+                WHEN 'REAL'       THEN 'TRIM(CHAR(' || EXPRESSION || '))'
                 WHEN 'DATE'       THEN ''''''''' || VARCHAR(CHAR(' || EXPRESSION || ', ISO)) || '''''''''
                 WHEN 'TIME'       THEN ''''''''' || VARCHAR(CHAR(' || EXPRESSION || ', JIS)) || '''''''''
                 WHEN 'TIMESTAMP'  THEN ''''''''' || TO_CHAR(' || EXPRESSION || ', ''YYYY-MM-DD HH24:MI:SS.NNNNNN'') || '''''''''
@@ -140,6 +140,16 @@ GRANT EXECUTE ON SPECIFIC FUNCTION VARCHAR_EXPRESSION2 TO ROLE UTILS_LOG_ADMIN W
 -- LOG_WRITER -- Has the ability to INSERT into the table
 -- LOG_READER -- Has the ability to SELECT from the table
 -- LOG_ADMIN -- Has CONTROL of the table
+--
+-- The table is range partitioned by CREATED, one partition per month, and its
+-- indexes are partitioned likewise. Partitions are added ahead of time by
+-- PURGE_LOG below (and for the current and coming month when this module is
+-- installed), and old partitions are removed (without the cost of deleting
+-- their rows) by PURGE_LOG. Should PURGE_LOG not be called for a while,
+-- WRITE_LOG and FLUSH_LOG add the partition for a message which falls beyond
+-- the last one. The initial partition is an empty placeholder (a partitioned
+-- table must be created with at least one partition) which PURGE_LOG removes
+-- on its first call; messages created before the installation are rejected.
 -------------------------------------------------------------------------------
 
 CREATE TABLE LOG (
@@ -149,16 +159,21 @@ CREATE TABLE LOG (
     SUBJECT_SCHEMA   VARCHAR(128) DEFAULT NULL,
     SUBJECT_NAME     VARCHAR(128) DEFAULT NULL,
     TEXT             VARCHAR(1024) NOT NULL
-)!
+)
+    PARTITION BY RANGE (CREATED) (
+        PARTITION LOG_INITIAL
+            STARTING MINVALUE
+            ENDING '0001-01-01-00.00.00' INCLUSIVE
+    )!
 
 CREATE INDEX LOG_IX1
-    ON LOG (SUBJECT_SCHEMA, SUBJECT_NAME)!
+    ON LOG (SUBJECT_SCHEMA, SUBJECT_NAME) PARTITIONED!
 
 CREATE INDEX LOG_IX2
-    ON LOG (SUBJECT_TYPE, SUBJECT_SCHEMA, SUBJECT_NAME)!
+    ON LOG (SUBJECT_TYPE, SUBJECT_SCHEMA, SUBJECT_NAME) PARTITIONED!
 
 CREATE INDEX LOG_IX3
-    ON LOG (CREATED, SUBJECT_TYPE, SUBJECT_SCHEMA, SUBJECT_NAME)!
+    ON LOG (CREATED, SUBJECT_TYPE, SUBJECT_SCHEMA, SUBJECT_NAME) PARTITIONED!
 
 ALTER TABLE LOG
     ADD CONSTRAINT SEVERITY_CK CHECK (SEVERITY IN ('D', 'I', 'W', 'E'))
@@ -178,4 +193,274 @@ GRANT CONTROL ON TABLE LOG TO ROLE UTILS_LOG_ADMIN!
 GRANT SELECT ON TABLE LOG TO ROLE UTILS_LOG_READER!
 GRANT INSERT ON TABLE LOG TO ROLE UTILS_LOG_WRITER!
 
+-- LOG_BUFFER
+-- LOG_BUFFER_SIZE
+-- X_LOG_BUFFERED
+-------------------------------------------------------------------------------
+-- LOG_BUFFER is a created temporary table (so its content is private to each
+-- session) in which WRITE_LOG accumulates messages when LOG_BUFFER_SIZE is
+-- greater than zero. Once LOG_BUFFER_SIZE messages have accumulated, they are
+-- written to LOG in a single INSERT, which is considerably cheaper than
+-- inserting each individually when logging at high volume (e.g. debugging
+-- messages). X_LOG_BUFFERED is a private count of the messages in the buffer,
+-- which saves counting them on every write.
+--
+-- DB2 provides no means of running code on COMMIT, so FLUSH_LOG must be called
+-- before committing to ensure buffered messages are written; messages still
+-- buffered when a session ends are lost. The buffer is not logged, and is not
+-- affected by COMMIT or ROLLBACK. Note that LOG_BUFFER cannot be created
+-- without a user temporary tablespace; the install target of the Makefile
+-- creates one if the database has none.
+-------------------------------------------------------------------------------
+
+CREATE GLOBAL TEMPORARY TABLE LOG_BUFFER LIKE LOG
+    INCLUDING COLUMN DEFAULTS
+    ON COMMIT PRESERVE ROWS
+    NOT LOGGED ON ROLLBACK PRESERVE ROWS!
+
+CREATE VARIABLE LOG_BUFFER_SIZE INTEGER DEFAULT 0!
+CREATE VARIABLE X_LOG_BUFFERED INTEGER DEFAULT 0!
+
+GRANT CONTROL ON TABLE LOG_BUFFER TO ROLE UTILS_LOG_ADMIN!
+GRANT READ, WRITE ON VARIABLE LOG_BUFFER_SIZE TO ROLE UTILS_LOG_WRITER!
+GRANT ALL ON VARIABLE LOG_BUFFER_SIZE TO ROLE UTILS_LOG_ADMIN WITH GRANT OPTION!
+
+COMMENT ON TABLE LOG_BUFFER
+    IS 'Session-level buffer of messages written by WRITE_LOG, flushed to LOG by FLUSH_LOG'!
+
+COMMENT ON VARIABLE LOG_BUFFER_SIZE
+    IS 'When greater than zero, WRITE_LOG buffers messages and flushes them to LOG in batches of this size'!
+
+-- X_LOG_SCHEMA()
+-- X_ADD_LOG_PARTITIONS(EARLIEST, LATEST)
+-------------------------------------------------------------------------------
+-- These routines are effectively private utility subroutines for the
+-- procedures defined below. X_LOG_SCHEMA returns the schema containing the
+-- LOG table (the schema of these routines), for use in dynamic SQL.
+-- X_ADD_LOG_PARTITIONS adds a partition to the LOG table for each month from
+-- that of EARLIEST to that of LATEST, skipping those already covered. If the
+-- last partition ends before the month of EARLIEST, the months in between are
+-- left as a gap rather than bridged with a partition. Note that adding
+-- partitions requires ALTER privilege on LOG, and an exclusive lock on it
+-- which is held until the caller commits.
+-------------------------------------------------------------------------------
+
+CREATE FUNCTION X_LOG_SCHEMA()
+    RETURNS VARCHAR(128)
+    SPECIFIC X_LOG_SCHEMA
+    LANGUAGE SQL
+    NOT DETERMINISTIC
+    NO EXTERNAL ACTION
+    READS SQL DATA
+RETURN
+    SELECT ROUTINESCHEMA
+    FROM SYSCAT.ROUTINES
+    WHERE SPECIFICNAME = 'X_LOG_SCHEMA'
+    ORDER BY COALESCE(NULLIF(LOCATE('"' || ROUTINESCHEMA || '"', CURRENT PATH), 0), 32767)
+    FETCH FIRST 1 ROW ONLY!
+
+CREATE PROCEDURE X_ADD_LOG_PARTITIONS(EARLIEST TIMESTAMP, LATEST TIMESTAMP)
+    SPECIFIC X_ADD_LOG_PARTITIONS
+    MODIFIES SQL DATA
+    NOT DETERMINISTIC
+    NO EXTERNAL ACTION
+    LANGUAGE SQL
+BEGIN
+    DECLARE LOG_SCHEMA VARCHAR(128) DEFAULT NULL;
+    DECLARE HIGH TIMESTAMP DEFAULT NULL;
+    DECLARE EARLIEST_MONTH TIMESTAMP DEFAULT NULL;
+
+    SET LOG_SCHEMA = X_LOG_SCHEMA();
+    SET HIGH = (
+        SELECT TIMESTAMP(SUBSTR(HIGHVALUE, 2, 26))
+        FROM SYSCAT.DATAPARTITIONS
+        WHERE TABSCHEMA = LOG_SCHEMA
+        AND TABNAME = 'LOG'
+        AND HIGHVALUE <> 'MAXVALUE'
+        ORDER BY SEQNO DESC
+        FETCH FIRST 1 ROW ONLY
+    );
+    SET EARLIEST_MONTH = TIMESTAMP(DATE(EARLIEST) - (DAY(EARLIEST) - 1) DAYS, '00:00:00');
+    IF HIGH < EARLIEST_MONTH THEN
+        SET HIGH = EARLIEST_MONTH;
+    END IF;
+    WHILE HIGH <= LATEST DO
+        EXECUTE IMMEDIATE
+            'ALTER TABLE ' || QUOTE_IDENTIFIER(LOG_SCHEMA) || '.LOG '
+            || 'ADD PARTITION LOG_' || TO_CHAR(HIGH, 'YYYYMM') || ' '
+            || 'STARTING ''' || CHAR(HIGH) || ''' INCLUSIVE '
+            || 'ENDING ''' || CHAR(HIGH + 1 MONTH) || ''' EXCLUSIVE';
+        SET HIGH = HIGH + 1 MONTH;
+    END WHILE;
+END!
+
+CALL X_ADD_LOG_PARTITIONS(CURRENT TIMESTAMP, CURRENT TIMESTAMP + 1 MONTH)!
+
+-- WRITE_LOG(ASEVERITY, ASUBJECT_TYPE, ASUBJECT_SCHEMA, ASUBJECT_NAME, ATEXT)
+-- WRITE_LOG(ASEVERITY, ATEXT)
+-- FLUSH_LOG()
+-------------------------------------------------------------------------------
+-- WRITE_LOG writes a message to the LOG table (see above for the meaning of
+-- the parameters). If SUBJECT_TYPE, SUBJECT_SCHEMA, and SUBJECT_NAME are
+-- omitted the message concerns the database. If the LOG_BUFFER_SIZE variable
+-- is greater than zero, the message is held in LOG_BUFFER until that many
+-- messages have accumulated, or until FLUSH_LOG is called. The CREATED column
+-- of buffered messages reflects when they were written, not when they were
+-- flushed. If a message falls beyond the last partition of LOG (because
+-- PURGE_LOG hasn't been called recently, see below) the missing partition is
+-- added and the message written again. Adding a partition locks LOG
+-- exclusively until the caller commits, so PURGE_LOG should still be
+-- scheduled to add partitions ahead of time.
+-------------------------------------------------------------------------------
+
+CREATE PROCEDURE FLUSH_LOG()
+    SPECIFIC FLUSH_LOG1
+    MODIFIES SQL DATA
+    NOT DETERMINISTIC
+    NO EXTERNAL ACTION
+    LANGUAGE SQL
+BEGIN
+    DECLARE EARLIEST TIMESTAMP DEFAULT NULL;
+    DECLARE LATEST TIMESTAMP DEFAULT NULL;
+
+    IF X_LOG_BUFFERED > 0 THEN
+        BEGIN
+            DECLARE EXIT HANDLER FOR SQLSTATE '22525'
+            BEGIN
+                SELECT MIN(CREATED), MAX(CREATED)
+                    INTO EARLIEST, LATEST
+                    FROM LOG_BUFFER;
+                CALL X_ADD_LOG_PARTITIONS(EARLIEST, LATEST);
+                INSERT INTO LOG SELECT * FROM LOG_BUFFER;
+            END;
+            INSERT INTO LOG SELECT * FROM LOG_BUFFER;
+        END;
+        DELETE FROM LOG_BUFFER;
+        SET X_LOG_BUFFERED = 0;
+    END IF;
+END!
+
+CREATE PROCEDURE WRITE_LOG(
+    ASEVERITY CHAR(1),
+    ASUBJECT_TYPE CHAR(1),
+    ASUBJECT_SCHEMA VARCHAR(128),
+    ASUBJECT_NAME VARCHAR(128),
+    ATEXT VARCHAR(1024)
+)
+    SPECIFIC WRITE_LOG1
+    MODIFIES SQL DATA
+    NOT DETERMINISTIC
+    NO EXTERNAL ACTION
+    LANGUAGE SQL
+BEGIN
+    IF LOG_BUFFER_SIZE > 0 THEN
+        INSERT INTO LOG_BUFFER (SEVERITY, SUBJECT_TYPE, SUBJECT_SCHEMA, SUBJECT_NAME, TEXT)
+            VALUES (ASEVERITY, ASUBJECT_TYPE, ASUBJECT_SCHEMA, ASUBJECT_NAME, ATEXT);
+        SET X_LOG_BUFFERED = X_LOG_BUFFERED + 1;
+        IF X_LOG_BUFFERED >= LOG_BUFFER_SIZE THEN
+            CALL FLUSH_LOG();
+        END IF;
+    ELSE
+        BEGIN
+            DECLARE EXIT HANDLER FOR SQLSTATE '22525'
+            BEGIN
+                CALL X_ADD_LOG_PARTITIONS(CURRENT TIMESTAMP, CURRENT TIMESTAMP);
+                INSERT INTO LOG (SEVERITY, SUBJECT_TYPE, SUBJECT_SCHEMA, SUBJECT_NAME, TEXT)
+                    VALUES (ASEVERITY, ASUBJECT_TYPE, ASUBJECT_SCHEMA, ASUBJECT_NAME, ATEXT);
+            END;
+            INSERT INTO LOG (SEVERITY, SUBJECT_TYPE, SUBJECT_SCHEMA, SUBJECT_NAME, TEXT)
+                VALUES (ASEVERITY, ASUBJECT_TYPE, ASUBJECT_SCHEMA, ASUBJECT_NAME, ATEXT);
+        END;
+    END IF;
+END!
+
+CREATE PROCEDURE WRITE_LOG(ASEVERITY CHAR(1), ATEXT VARCHAR(1024))
+    SPECIFIC WRITE_LOG2
+    MODIFIES SQL DATA
+    NOT DETERMINISTIC
+    NO EXTERNAL ACTION
+    LANGUAGE SQL
+BEGIN
+    CALL WRITE_LOG(ASEVERITY, 'D', NULL, NULL, ATEXT);
+END!
+
+GRANT EXECUTE ON SPECIFIC PROCEDURE WRITE_LOG1 TO ROLE UTILS_LOG_WRITER!
+GRANT EXECUTE ON SPECIFIC PROCEDURE WRITE_LOG2 TO ROLE UTILS_LOG_WRITER!
+GRANT EXECUTE ON SPECIFIC PROCEDURE FLUSH_LOG1 TO ROLE UTILS_LOG_WRITER!
+GRANT EXECUTE ON SPECIFIC PROCEDURE WRITE_LOG1 TO ROLE UTILS_LOG_ADMIN WITH GRANT OPTION!
+GRANT EXECUTE ON SPECIFIC PROCEDURE WRITE_LOG2 TO ROLE UTILS_LOG_ADMIN WITH GRANT OPTION!
+GRANT EXECUTE ON SPECIFIC PROCEDURE FLUSH_LOG1 TO ROLE UTILS_LOG_ADMIN WITH GRANT OPTION!
+
+COMMENT ON SPECIFIC PROCEDURE WRITE_LOG1
+    IS 'Writes a message concerning the specified object to LOG, buffering it if LOG_BUFFER_SIZE is greater than zero'!
+COMMENT ON SPECIFIC PROCEDURE WRITE_LOG2
+    IS 'Writes a message concerning the database to LOG, buffering it if LOG_BUFFER_SIZE is greater than zero'!
+COMMENT ON SPECIFIC PROCEDURE FLUSH_LOG1
+    IS 'Writes all messages buffered by WRITE_LOG in the current session to LOG'!
+
+-- PURGE_LOG(CUTOFF)
+-------------------------------------------------------------------------------
+-- PURGE_LOG removes all messages from the LOG table created before CUTOFF by
+-- detaching (and then dropping) whole partitions, which takes a fraction of
+-- the time and log space of deleting the messages. As only whole partitions
+-- are removed, messages from the month containing CUTOFF are retained. The
+-- most recent partition is never removed. The procedure also adds partitions
+-- up to the coming month if they don't already exist; it should be called at
+-- least monthly (e.g. from the administrative task scheduler) so that
+-- WRITE_LOG rarely has to add a partition itself. The procedure commits after
+-- adding partitions, after each partition is detached, and after each is
+-- dropped.
+-------------------------------------------------------------------------------
+
+CREATE PROCEDURE PURGE_LOG(CUTOFF TIMESTAMP)
+    SPECIFIC PURGE_LOG1
+    MODIFIES SQL DATA
+    NOT DETERMINISTIC
+    NO EXTERNAL ACTION
+    LANGUAGE SQL
+BEGIN
+    DECLARE LOG_SCHEMA VARCHAR(128) DEFAULT NULL;
+    DECLARE PART_NAME VARCHAR(128) DEFAULT '';
+
+    SET LOG_SCHEMA = X_LOG_SCHEMA();
+    CALL X_ADD_LOG_PARTITIONS(CURRENT TIMESTAMP, CURRENT TIMESTAMP + 1 MONTH);
+    COMMIT;
+    -- Each iteration detaches the oldest partition which ends on or before
+    -- CUTOFF; the detached partition becomes an ordinary table once the
+    -- detach is committed, and can then be dropped
+    WHILE PART_NAME IS NOT NULL DO
+        SET PART_NAME = (
+            SELECT DATAPARTITIONNAME
+            FROM SYSCAT.DATAPARTITIONS
+            WHERE TABSCHEMA = LOG_SCHEMA
+            AND TABNAME = 'LOG'
+            AND HIGHVALUE <> 'MAXVALUE'
+            AND TIMESTAMP(SUBSTR(HIGHVALUE, 2, 26)) <= CUTOFF
+            AND SEQNO < (
+                SELECT MAX(SEQNO)
+                FROM SYSCAT.DATAPARTITIONS
+                WHERE TABSCHEMA = LOG_SCHEMA
+                AND TABNAME = 'LOG'
+            )
+            ORDER BY SEQNO
+            FETCH FIRST 1 ROW ONLY
+        );
+        IF PART_NAME IS NOT NULL THEN
+            EXECUTE IMMEDIATE
+                'ALTER TABLE ' || QUOTE_IDENTIFIER(LOG_SCHEMA) || '.LOG '
+                || 'DETACH PARTITION ' || QUOTE_IDENTIFIER(PART_NAME) || ' '
+                || 'INTO ' || QUOTE_IDENTIFIER(LOG_SCHEMA) || '.' || QUOTE_IDENTIFIER('X_' || PART_NAME);
+            COMMIT;
+            EXECUTE IMMEDIATE
+                'DROP TABLE ' || QUOTE_IDENTIFIER(LOG_SCHEMA) || '.' || QUOTE_IDENTIFIER('X_' || PART_NAME);
+            COMMIT;
+        END IF;
+    END WHILE;
+END!
+
+GRANT EXECUTE ON SPECIFIC PROCEDURE PURGE_LOG1 TO ROLE UTILS_LOG_ADMIN WITH GRANT OPTION!
+
+COMMENT ON SPECIFIC PROCEDURE PURGE_LOG1
+    IS 'Removes messages created before CUTOFF from LOG by detaching and dropping whole partitions'!
+
 -- vim: set et sw=4 sts=4:
@@ -53,6 +53,9 @@ GRANT ROLE UTILS_MERGE_ADMIN TO ROLE UTILS_ADMIN WITH ADMIN OPTION!
 CREATE VARIABLE MERGE_NO_KEY_STATE CHAR(5) CONSTANT '90010'!
 CREATE VARIABLE MERGE_PARTIAL_KEY_STATE CHAR(5) CONSTANT '90011'!
 CREATE VARIABLE MERGE_SAME_TABLE_STATE CHAR(5) CONSTANT '90012'!
+CREATE VARIABLE MERGE_CHUNK_SIZE_STATE CHAR(5) CONSTANT '90014'!
+CREATE VARIABLE MERGE_HASH_TYPE_STATE CHAR(5) CONSTANT '90015'!
+CREATE VARIABLE MERGE_CHUNK_KEY_STATE CHAR(5) CONSTANT '90019'!
 
 GRANT READ ON VARIABLE MERGE_NO_KEY_STATE TO ROLE UTILS_MERGE_USER!
 GRANT READ ON VARIABLE MERGE_NO_KEY_STATE TO ROLE UTILS_MERGE_ADMIN WITH GRANT OPTION!
@@ -60,6 +63,12 @@ GRANT READ ON VARIABLE MERGE_PARTIAL_KEY_STATE TO ROLE UTILS_MERGE_USER!
 GRANT READ ON VARIABLE MERGE_PARTIAL_KEY_STATE TO ROLE UTILS_MERGE_ADMIN WITH GRANT OPTION!
 GRANT READ ON VARIABLE MERGE_SAME_TABLE_STATE TO ROLE UTILS_MERGE_USER!
 GRANT READ ON VARIABLE MERGE_SAME_TABLE_STATE TO ROLE UTILS_MERGE_ADMIN WITH GRANT OPTION!
+GRANT READ ON VARIABLE MERGE_CHUNK_SIZE_STATE TO ROLE UTILS_MERGE_USER!
+GRANT READ ON VARIABLE MERGE_CHUNK_SIZE_STATE TO ROLE UTILS_MERGE_ADMIN WITH GRANT OPTION!
+GRANT READ ON VARIABLE MERGE_HASH_TYPE_STATE TO ROLE UTILS_MERGE_USER!
+GRANT READ ON VARIABLE MERGE_HASH_TYPE_STATE TO ROLE UTILS_MERGE_ADMIN WITH GRANT OPTION!
+GRANT READ ON VARIABLE MERGE_CHUNK_KEY_STATE TO ROLE UTILS_MERGE_USER!
+GRANT READ ON VARIABLE MERGE_CHUNK_KEY_STATE TO ROLE UTILS_MERGE_ADMIN WITH GRANT OPTION!
 
 COMMENT ON VARIABLE MERGE_NO_KEY_STATE
     IS 'The SQLSTATE raised when an attempt is made to AUTO_MERGE to a target without a unique constraint'!
@@ -70,21 +79,50 @@ COMMENT ON VARIABLE MERGE_PARTIAL_KEY_STATE
 COMMENT ON VARIABLE MERGE_SAME_TABLE_STATE
     IS 'The SQLSTATE raised when AUTO_MERGE is run with the same table as source and target'!
 
--- X_BUILD_INSERT(SOURCE_SCHEMA, SOURCE_TABLE, DEST_SCHEMA, DEST_TABLE)
--- X_BUILD_MERGE(SOURCE_SCHEMA, SOURCE_TABLE, DEST_SCHEMA, DEST_TABLE, DEST_KEY)
--- X_BUILD_DELETE(SOURCE_SCHEMA, SOURCE_TABLE, DEST_SCHEMA, DEST_TABLE, DEST_KEY)
+COMMENT ON VARIABLE MERGE_CHUNK_SIZE_STATE
+    IS 'The SQLSTATE raised when AUTO_MERGE_CHUNKED is run with a CHUNK_SIZE which is not a positive integer'!
+
+COMMENT ON VARIABLE MERGE_HASH_TYPE_STATE
+    IS 'The SQLSTATE raised when AUTO_MERGE_HASHED is run on a table containing columns which cannot be hashed, or with an invalid HASH_COLUMN'!
+
+COMMENT ON VARIABLE MERGE_CHUNK_KEY_STATE
+    IS 'The SQLSTATE raised when a chunked procedure is run with a key containing columns of unsupported types, or which is too long'!
+
+-- X_BUILD_INSERT(SOURCE_SCHEMA, SOURCE_TABLE, DEST_SCHEMA, DEST_TABLE, PREDICATE)
+-- X_BUILD_ROW_HASH(SOURCE_SCHEMA, SOURCE_TABLE, DEST_SCHEMA, DEST_TABLE, DEST_KEY, HASH_COLUMN, SIDE, PREFIX)
+-- X_BUILD_MERGE(SOURCE_SCHEMA, SOURCE_TABLE, DEST_SCHEMA, DEST_TABLE, DEST_KEY, PREDICATE, HASHED, HASH_COLUMN)
+-- X_BUILD_DELETE(SOURCE_SCHEMA, SOURCE_TABLE, DEST_SCHEMA, DEST_TABLE, DEST_KEY, PREDICATE)
+-- X_BUILD_KEY_AFTER(ASCHEMA, ATABLE, DEST_SCHEMA, DEST_TABLE, DEST_KEY)
 -- X_MERGE_CHECKS(SOURCE_SCHEMA, SOURCE_TABLE, DEST_SCHEMA, DEST_TABLE, DEST_KEY)
 -------------------------------------------------------------------------------
 -- These functions are effectively private utility subroutines for the
 -- procedures defined below. They simply generate snippets of SQL given a set
--- of input parameters.
+-- of input parameters. If PREDICATE is not NULL, the generated statement is
+-- limited to rows of the source table (or for X_BUILD_DELETE, of both tables)
+-- which satisfy it.
+--
+-- X_BUILD_ROW_HASH generates an expression calculating the ROW_HASH of the
+-- non-key columns common to the source and destination tables (excluding
+-- HASH_COLUMN) of the source (SIDE = 'S') or destination (SIDE = 'T') table,
+-- with each column name prefixed by PREFIX. Source columns are cast to the
+-- types of the destination columns, so that the hash of an unchanged row is
+-- the same on either side. If HASHED is 'Y', X_BUILD_MERGE generates a MERGE
+-- which only updates matched rows when this hash differs between source and
+-- destination (or the hash persisted in HASH_COLUMN, if that is not NULL).
+--
+-- X_BUILD_KEY_AFTER is a little different; it generates an expression which,
+-- when evaluated against a row of ATABLE aliased as B, produces the text of a
+-- predicate matching all keys (the columns of DEST_KEY) greater than the key
+-- of that row. This is used by the chunked procedures to record and resume
+-- from the boundaries between chunks.
 -------------------------------------------------------------------------------
 
 CREATE FUNCTION X_BUILD_INSERT(
     SOURCE_SCHEMA VARCHAR(128),
     SOURCE_TABLE VARCHAR(128),
     DEST_SCHEMA VARCHAR(128),
-    DEST_TABLE VARCHAR(128)
+    DEST_TABLE VARCHAR(128),
+    PREDICATE CLOB(64K)
 )
     RETURNS CLOB(64K)
     SPECIFIC X_BUILD_INSERT
@@ -118,7 +156,117 @@ BEGIN ATOMIC
         'INSERT INTO ' || QUOTE_IDENTIFIER(DEST_SCHEMA) || '.' || QUOTE_IDENTIFIER(DEST_TABLE) || ' '
         || '(' || COLS || ') '
         || 'SELECT ' || COLS || ' '
-        || 'FROM ' || QUOTE_IDENTIFIER(SOURCE_SCHEMA) || '.' || QUOTE_IDENTIFIER(SOURCE_TABLE);
+        || 'FROM ' || QUOTE_IDENTIFIER(SOURCE_SCHEMA) || '.' || QUOTE_IDENTIFIER(SOURCE_TABLE)
+        || COALESCE(' WHERE ' || PREDICATE, '');
+END!
+
+CREATE FUNCTION X_BUILD_ROW_HASH(
+    SOURCE_SCHEMA VARCHAR(128),
+    SOURCE_TABLE VARCHAR(128),
+    DEST_SCHEMA VARCHAR(128),
+    DEST_TABLE VARCHAR(128),
+    DEST_KEY VARCHAR(128),
+    HASH_COLUMN VARCHAR(128),
+    SIDE CHAR(1),
+    PREFIX VARCHAR(10)
+)
+    RETURNS CLOB(64K)
+    SPECIFIC X_BUILD_ROW_HASH
+    LANGUAGE SQL
+    NOT DETERMINISTIC
+    NO EXTERNAL ACTION
+    READS SQL DATA
+BEGIN ATOMIC
+    DECLARE RESULT CLOB(64K) DEFAULT '';
+    DECLARE VALUES_EXPR CLOB(64K) DEFAULT '';
+    DECLARE VALUES_LEN INTEGER DEFAULT 0;
+    DECLARE VALUE_EXPR VARCHAR(1000) DEFAULT '';
+    DECLARE VALUE_LEN INTEGER DEFAULT 0;
+
+    -- Each value is converted to a string and encoded such that the
+    -- concatenation of the encoded values is unambiguous: strings are prefixed
+    -- with their length, other values are terminated by a colon (which cannot
+    -- appear in their string representation), and NULL is encoded as a tilde.
+    -- The concatenated values are split into groups which will fit in a
+    -- VARCHAR, and the hash of each group seeds the hash of the next
+    FOR D AS
+        SELECT
+            T.COLNAME AS NAME,
+            T.TYPESCHEMA,
+            T.TYPENAME,
+            T.LENGTH,
+            T.SCALE
+        FROM
+            SYSCAT.COLUMNS S
+            INNER JOIN SYSCAT.COLUMNS T
+                ON S.COLNAME = T.COLNAME
+        WHERE
+            S.TABSCHEMA = SOURCE_SCHEMA
+            AND S.TABNAME = SOURCE_TABLE
+            AND T.TABSCHEMA = DEST_SCHEMA
+            AND T.TABNAME = DEST_TABLE
+            AND T.COLNAME <> COALESCE(HASH_COLUMN, '')
+            AND T.COLNAME NOT IN (
+                SELECT COLNAME
+                FROM SYSCAT.KEYCOLUSE
+                WHERE TABSCHEMA = DEST_SCHEMA
+                AND TABNAME = DEST_TABLE
+                AND CONSTNAME = DEST_KEY
+            )
+        ORDER BY
+            T.COLNO
+    DO
+        SET VALUE_EXPR = PREFIX || QUOTE_IDENTIFIER(NAME);
+        -- Source values are cast to the type of the destination column so
+        -- that, for example, a DECIMAL(10, 2) of 1.50 in the source hashes
+        -- the same as the DECIMAL(10, 3) of 1.500 it was merged into
+        IF SIDE = 'S' AND TYPESCHEMA = 'SYSIBM' THEN
+            SET VALUE_EXPR = 'CAST(' || VALUE_EXPR || ' AS ' ||
+                CASE
+                    WHEN TYPENAME IN ('CHARACTER', 'VARCHAR', 'GRAPHIC', 'VARGRAPHIC')
+                        THEN CASE TYPENAME WHEN 'CHARACTER' THEN 'CHAR' ELSE TYPENAME END
+                        || '(' || VARCHAR(LENGTH) || ')'
+                    WHEN TYPENAME = 'DECIMAL'
+                        THEN 'DECIMAL(' || VARCHAR(LENGTH) || ', ' || VARCHAR(SCALE) || ')'
+                    WHEN TYPENAME = 'TIMESTAMP' AND SCALE <> 6
+                        THEN 'TIMESTAMP(' || VARCHAR(SCALE) || ')'
+                    WHEN TYPENAME = 'DECFLOAT'
+                        THEN 'DECFLOAT(' || CASE LENGTH WHEN 8 THEN '16' ELSE '34' END || ')'
+                    ELSE TYPENAME
+                END || ')';
+        END IF;
+        SET VALUE_EXPR = 'COALESCE(' ||
+            CASE WHEN TYPESCHEMA = 'SYSIBM' AND TYPENAME IN ('CHARACTER', 'VARCHAR')
+                THEN 'TRIM(CHAR(LENGTH(' || VALUE_EXPR || '))) || '':'' || ' || VALUE_EXPR
+            WHEN TYPESCHEMA = 'SYSIBM' AND TYPENAME IN ('GRAPHIC', 'VARGRAPHIC')
+                THEN 'TRIM(CHAR(LENGTH(' || VALUE_EXPR || '))) || '':'' || VARCHAR(' || VALUE_EXPR || ')'
+            WHEN TYPESCHEMA = 'SYSIBM' AND TYPENAME IN ('SMALLINT', 'INTEGER', 'BIGINT', 'DECIMAL', 'DECFLOAT', 'REAL', 'DOUBLE', 'TIMESTAMP')
+                THEN 'TRIM(CHAR(' || VALUE_EXPR || ')) || '':'''
+            WHEN TYPESCHEMA = 'SYSIBM' AND TYPENAME IN ('DATE', 'TIME')
+                THEN 'CHAR(' || VALUE_EXPR || ', ISO) || '':'''
+            ELSE RAISE_ERROR(MERGE_HASH_TYPE_STATE, 'Cannot hash column ' || NAME || ' of type ' || TYPENAME)
+            END || ', ''~'')';
+        SET VALUE_LEN =
+            CASE WHEN TYPENAME IN ('CHARACTER', 'VARCHAR') THEN LENGTH + 6
+            WHEN TYPENAME IN ('GRAPHIC', 'VARGRAPHIC') THEN LENGTH * 3 + 6
+            ELSE 50
+            END;
+        IF VALUES_EXPR <> '' AND VALUES_LEN + VALUE_LEN > 32000 THEN
+            SET RESULT = 'ROW_HASH(' || CASE WHEN RESULT = '' THEN '' ELSE RESULT || ', ' END || VALUES_EXPR || ')';
+            SET VALUES_EXPR = '';
+            SET VALUES_LEN = 0;
+        END IF;
+        IF VALUES_EXPR <> '' THEN
+            SET VALUES_EXPR = VALUES_EXPR || ' || ';
+        END IF;
+        SET VALUES_EXPR = VALUES_EXPR || VALUE_EXPR;
+        SET VALUES_LEN = VALUES_LEN + VALUE_LEN;
+    END FOR;
+
+    IF VALUES_EXPR = '' THEN
+        SET VALUES_EXPR = '''''';
+    END IF;
+    RETURN 'ROW_HASH(' || CASE WHEN RESULT = '' THEN '' ELSE RESULT || ', ' END || VALUES_EXPR || ')';
 END!
 
 CREATE FUNCTION X_BUILD_MERGE(
@@ -126,7 +274,10 @@ CREATE FUNCTION X_BUILD_MERGE(
     SOURCE_TABLE VARCHAR(128),
     DEST_SCHEMA VARCHAR(128),
     DEST_TABLE VARCHAR(128),
-    DEST_KEY VARCHAR(128)
+    DEST_KEY VARCHAR(128),
+    PREDICATE CLOB(64K),
+    HASHED CHAR(1),
+    HASH_COLUMN VARCHAR(128)
 )
     RETURNS CLOB(64K)
     SPECIFIC X_BUILD_MERGE
@@ -135,6 +286,8 @@ CREATE FUNCTION X_BUILD_MERGE(
     NO EXTERNAL ACTION
     READS SQL DATA
 BEGIN ATOMIC
+    DECLARE SOURCE_CLAUSE CLOB(64K) DEFAULT '';
+    DECLARE MATCHED_CLAUSE CLOB(64K) DEFAULT '';
     DECLARE JOIN_CLAUSE CLOB(64K) DEFAULT '';
     DECLARE INSERT_COLS CLOB(64K) DEFAULT '';
     DECLARE INSERT_VALS CLOB(64K) DEFAULT '';
@@ -167,6 +320,7 @@ BEGIN ATOMIC
             AND T.TABNAME = DEST_TABLE
             AND C.CONSTNAME = DEST_KEY
             AND C.TYPE IN ('P', 'U')
+            AND T.COLNAME <> COALESCE(HASH_COLUMN, '')
     DO
         IF D.KEY_COL = 'Y' THEN
             IF JOIN_CLAUSE <> '' THEN
@@ -191,11 +345,39 @@ BEGIN ATOMIC
         SET INSERT_VALS = INSERT_VALS || 'S.' || QUOTE_IDENTIFIER(NAME);
     END FOR;
 
+    IF HASHED = 'Y' THEN
+        -- In hashed mode, the hash of each source row is calculated once in
+        -- the source sub-select, and compared to the hash of the target row
+        -- (or the persisted hash in HASH_COLUMN, if given); matched rows are
+        -- only updated when the two differ
+        SET SOURCE_CLAUSE = '(SELECT R.*, '
+            || X_BUILD_ROW_HASH(SOURCE_SCHEMA, SOURCE_TABLE, DEST_SCHEMA, DEST_TABLE, DEST_KEY, HASH_COLUMN, 'S', '')
+            || ' AS X_ROW_HASH '
+            || 'FROM ' || QUOTE_IDENTIFIER(SOURCE_SCHEMA) || '.' || QUOTE_IDENTIFIER(SOURCE_TABLE) || ' AS R'
+            || COALESCE(' WHERE ' || PREDICATE, '') || ')';
+        IF HASH_COLUMN IS NULL THEN
+            SET MATCHED_CLAUSE = ' AND S.X_ROW_HASH <> '
+                || X_BUILD_ROW_HASH(SOURCE_SCHEMA, SOURCE_TABLE, DEST_SCHEMA, DEST_TABLE, DEST_KEY, HASH_COLUMN, 'T', 'T.');
+        ELSE
+            SET MATCHED_CLAUSE = ' AND (T.' || QUOTE_IDENTIFIER(HASH_COLUMN) || ' IS NULL'
+                || ' OR T.' || QUOTE_IDENTIFIER(HASH_COLUMN) || ' <> S.X_ROW_HASH)';
+            SET UPDATE_COLS = UPDATE_COLS || ',' || QUOTE_IDENTIFIER(HASH_COLUMN);
+            SET UPDATE_VALS = UPDATE_VALS || ',S.X_ROW_HASH';
+            SET INSERT_COLS = INSERT_COLS || ',' || QUOTE_IDENTIFIER(HASH_COLUMN);
+            SET INSERT_VALS = INSERT_VALS || ',S.X_ROW_HASH';
+        END IF;
+    ELSEIF PREDICATE IS NULL THEN
+        SET SOURCE_CLAUSE = QUOTE_IDENTIFIER(SOURCE_SCHEMA) || '.' || QUOTE_IDENTIFIER(SOURCE_TABLE);
+    ELSE
+        SET SOURCE_CLAUSE = '(SELECT * FROM ' || QUOTE_IDENTIFIER(SOURCE_SCHEMA) || '.' || QUOTE_IDENTIFIER(SOURCE_TABLE)
+            || ' WHERE ' || PREDICATE || ')';
+    END IF;
+
     RETURN
         'MERGE INTO ' || QUOTE_IDENTIFIER(DEST_SCHEMA) || '.' || QUOTE_IDENTIFIER(DEST_TABLE) || ' AS T '
-        || 'USING ' || QUOTE_IDENTIFIER(SOURCE_SCHEMA) || '.' || QUOTE_IDENTIFIER(SOURCE_TABLE) || ' AS S '
+        || 'USING ' || SOURCE_CLAUSE || ' AS S '
         || 'ON ' || JOIN_CLAUSE || ' '
-        || 'WHEN MATCHED THEN UPDATE SET (' || UPDATE_COLS || ') = (' || UPDATE_VALS || ') '
+        || 'WHEN MATCHED' || MATCHED_CLAUSE || ' THEN UPDATE SET (' || UPDATE_COLS || ') = (' || UPDATE_VALS || ') '
         || 'WHEN NOT MATCHED THEN INSERT (' || INSERT_COLS || ') VALUES (' || INSERT_VALS || ')';
 END!
 
@@ -204,7 +386,8 @@ CREATE FUNCTION X_BUILD_DELETE(
     SOURCE_TABLE VARCHAR(128),
     DEST_SCHEMA VARCHAR(128),
     DEST_TABLE VARCHAR(128),
-    DEST_KEY VARCHAR(128)
+    DEST_KEY VARCHAR(128),
+    PREDICATE CLOB(64K)
 )
     RETURNS CLOB(64K)
     SPECIFIC X_BUILD_DELETE
@@ -253,12 +436,70 @@ BEGIN ATOMIC
         || 'WHERE (' || KEY_COLS || ') IN ('
         || 'SELECT ' || KEY_COLS || ' '
         || 'FROM ' || QUOTE_IDENTIFIER(DEST_SCHEMA) || '.' || QUOTE_IDENTIFIER(DEST_TABLE) || ' '
+        || COALESCE('WHERE ' || PREDICATE || ' ', '')
         || 'EXCEPT '
         || 'SELECT ' || KEY_COLS || ' '
         || 'FROM ' || QUOTE_IDENTIFIER(SOURCE_SCHEMA) || '.' || QUOTE_IDENTIFIER(SOURCE_TABLE)
+        || COALESCE(' WHERE ' || PREDICATE, '')
         || ')';
 END!
 
+CREATE FUNCTION X_BUILD_KEY_AFTER(
+    ASCHEMA VARCHAR(128),
+    ATABLE VARCHAR(128),
+    DEST_SCHEMA VARCHAR(128),
+    DEST_TABLE VARCHAR(128),
+    DEST_KEY VARCHAR(128)
+)
+    RETURNS CLOB(64K)
+    SPECIFIC X_BUILD_KEY_AFTER
+    LANGUAGE SQL
+    NOT DETERMINISTIC
+    NO EXTERNAL ACTION
+    READS SQL DATA
+BEGIN ATOMIC
+    DECLARE RESULT CLOB(64K) DEFAULT '';
+    DECLARE KEY_VALUE VARCHAR(300) DEFAULT '';
+
+    -- The predicate is built from the last column of the key backward,
+    -- yielding (for a key of A, B, C):
+    --
+    --   A > a OR (A = a AND (B > b OR (B = b AND (C > c))))
+    --
+    -- Row value expressions can't be used here as DB2 doesn't support them
+    -- with the greater-than operator
+    FOR D AS
+        SELECT
+            C.COLNAME AS NAME,
+            C.TYPESCHEMA,
+            C.TYPENAME
+        FROM
+            SYSCAT.KEYCOLUSE K
+            INNER JOIN SYSCAT.COLUMNS C
+                ON K.COLNAME = C.COLNAME
+        WHERE
+            K.TABSCHEMA = DEST_SCHEMA
+            AND K.TABNAME = DEST_TABLE
+            AND K.CONSTNAME = DEST_KEY
+            AND C.TABSCHEMA = ASCHEMA
+            AND C.TABNAME = ATABLE
+        ORDER BY
+            K.COLSEQ DESC
+    DO
+        SET KEY_VALUE = VARCHAR_EXPRESSION('B.' || QUOTE_IDENTIFIER(NAME), TYPESCHEMA, TYPENAME);
+        IF RESULT = '' THEN
+            SET RESULT = QUOTE_STRING(QUOTE_IDENTIFIER(NAME) || ' > ') || ' || ' || KEY_VALUE;
+        ELSE
+            SET RESULT = QUOTE_STRING(QUOTE_IDENTIFIER(NAME) || ' > ') || ' || ' || KEY_VALUE
+                || ' || ' || QUOTE_STRING(' OR (' || QUOTE_IDENTIFIER(NAME) || ' = ') || ' || ' || KEY_VALUE
+                || ' || ' || QUOTE_STRING(' AND (') || ' || ' || RESULT
+                || ' || ' || QUOTE_STRING('))');
+        END IF;
+    END FOR;
+
+    RETURN RESULT;
+END!
+
 CREATE PROCEDURE X_INSERT_CHECKS(
     SOURCE_SCHEMA VARCHAR(128),
     SOURCE_TABLE VARCHAR(128),
@@ -352,7 +593,7 @@ BEGIN ATOMIC
     DECLARE DML CLOB(64K) DEFAULT '';
 
     CALL X_INSERT_CHECKS(SOURCE_SCHEMA, SOURCE_TABLE, DEST_SCHEMA, DEST_TABLE);
-    SET DML = X_BUILD_INSERT(SOURCE_SCHEMA, SOURCE_TABLE, DEST_SCHEMA, DEST_TABLE);
+    SET DML = X_BUILD_INSERT(SOURCE_SCHEMA, SOURCE_TABLE, DEST_SCHEMA, DEST_TABLE, CAST(NULL AS CLOB(64K)));
     EXECUTE IMMEDIATE DML;
 END!
 
@@ -414,7 +655,7 @@ BEGIN ATOMIC
     DECLARE DML CLOB(64K) DEFAULT '';
 
     CALL X_MERGE_CHECKS(SOURCE_SCHEMA, SOURCE_TABLE, DEST_SCHEMA, DEST_TABLE, DEST_KEY);
-    SET DML = X_BUILD_MERGE(SOURCE_SCHEMA, SOURCE_TABLE, DEST_SCHEMA, DEST_TABLE, DEST_KEY);
+    SET DML = X_BUILD_MERGE(SOURCE_SCHEMA, SOURCE_TABLE, DEST_SCHEMA, DEST_TABLE, DEST_KEY, CAST(NULL AS CLOB(64K)), 'N', CAST(NULL AS VARCHAR(128)));
     EXECUTE IMMEDIATE DML;
 END!
 
@@ -523,7 +764,7 @@ BEGIN ATOMIC
     DECLARE DML CLOB(64K) DEFAULT '';
 
     CALL X_MERGE_CHECKS(SOURCE_SCHEMA, SOURCE_TABLE, DEST_SCHEMA, DEST_TABLE, DEST_KEY);
-    SET DML = X_BUILD_DELETE(SOURCE_SCHEMA, SOURCE_TABLE, DEST_SCHEMA, DEST_TABLE, DEST_KEY);
+    SET DML = X_BUILD_DELETE(SOURCE_SCHEMA, SOURCE_TABLE, DEST_SCHEMA, DEST_TABLE, DEST_KEY, CAST(NULL AS CLOB(64K)));
     EXECUTE IMMEDIATE DML;
 END!
 
@@ -597,4 +838,826 @@ COMMENT ON SPECIFIC PROCEDURE AUTO_DELETE3
 COMMENT ON SPECIFIC PROCEDURE AUTO_DELETE4
     IS 'Automatically removes data from DEST_TABLE that doesn''t exist in SOURCE_TABLE, based on DEST_KEY'!
 
+-- MERGE_PROGRESS
+-------------------------------------------------------------------------------
+-- The MERGE_PROGRESS table records the progress of the chunked procedures
+-- defined below (AUTO_INSERT_CHUNKED, AUTO_MERGE_CHUNKED and
+-- AUTO_DELETE_CHUNKED). There is one row for each combination of destination
+-- table, source table and OPERATION ('I' for insert, 'M' for merge, and 'D'
+-- for delete). CONSTNAME is the name of the key used to divide the operation
+-- into chunks, CHUNKS and ROWS_AFFECTED count the chunks completed so far and
+-- the rows they affected, and LAST_KEY holds a predicate matching all keys
+-- after the last completed chunk (NULL if no chunks have been completed).
+-- COMPLETED is NULL while an operation is incomplete, in which case the next
+-- call to the same procedure resumes from LAST_KEY.
+-------------------------------------------------------------------------------
+
+CREATE TABLE MERGE_PROGRESS (
+    TABSCHEMA        VARCHAR(128) NOT NULL,
+    TABNAME          VARCHAR(128) NOT NULL,
+    SOURCE_TABSCHEMA VARCHAR(128) NOT NULL,
+    SOURCE_TABNAME   VARCHAR(128) NOT NULL,
+    OPERATION        CHAR(1) NOT NULL,
+    CONSTNAME        VARCHAR(128) NOT NULL,
+    CHUNKS           INTEGER DEFAULT 0 NOT NULL,
+    ROWS_AFFECTED    BIGINT DEFAULT 0 NOT NULL,
+    LAST_KEY         CLOB(64K) DEFAULT NULL,
+    STARTED          TIMESTAMP DEFAULT CURRENT TIMESTAMP NOT NULL,
+    UPDATED          TIMESTAMP DEFAULT CURRENT TIMESTAMP NOT NULL,
+    COMPLETED        TIMESTAMP DEFAULT NULL
+)!
+
+CREATE UNIQUE INDEX MERGE_PROGRESS_PK
+    ON MERGE_PROGRESS (TABSCHEMA, TABNAME, SOURCE_TABSCHEMA, SOURCE_TABNAME, OPERATION)!
+
+ALTER TABLE MERGE_PROGRESS
+    ADD CONSTRAINT PK PRIMARY KEY (TABSCHEMA, TABNAME, SOURCE_TABSCHEMA, SOURCE_TABNAME, OPERATION)
+    ADD CONSTRAINT OPERATION_CK CHECK (OPERATION IN ('I', 'M', 'D'))!
+
+GRANT CONTROL ON TABLE MERGE_PROGRESS TO ROLE UTILS_MERGE_ADMIN WITH GRANT OPTION!
+GRANT SELECT ON TABLE MERGE_PROGRESS TO ROLE UTILS_MERGE_USER!
+
+COMMENT ON TABLE MERGE_PROGRESS
+    IS 'Utility table used by the chunked AUTO_INSERT, AUTO_MERGE, and AUTO_DELETE procedures to record their progress'!
+
+-- X_AUTO_CHUNKED(AOPERATION, SOURCE_SCHEMA, SOURCE_TABLE, DEST_SCHEMA, DEST_TABLE, DEST_KEY, CHUNK_SIZE)
+-------------------------------------------------------------------------------
+-- X_AUTO_CHUNKED is the private implementation of the chunked procedures
+-- below. AOPERATION is 'I', 'M', or 'D' for an insert, merge or delete
+-- respectively. Inserts and merges are divided into chunks of CHUNK_SIZE rows
+-- of the source table, while deletions are divided into chunks of CHUNK_SIZE
+-- rows of the destination table, in the order of the columns of DEST_KEY.
+--
+-- The boundaries between chunks are found by a single query numbering the
+-- keys after the end of the last completed chunk, walked by a cursor held
+-- open across commits (so the keys are read and sorted once, rather than once
+-- per chunk). For each boundary, the generated INSERT, MERGE or DELETE
+-- statement is executed for the range of keys between it and the prior
+-- boundary, the progress row in MERGE_PROGRESS is updated, a row is written to
+-- LOG recording the number of rows affected and the time taken, and the
+-- transaction is committed. A final chunk covers the keys after the last
+-- boundary, and marks the operation complete.
+--
+-- As boundaries are recorded as predicates containing the key values, the key
+-- must consist of built-in types with an exact textual representation
+-- (approximate numeric types like DOUBLE and REAL are rejected), and must be
+-- short enough for the predicate to fit within a VARCHAR.
+-------------------------------------------------------------------------------
+
+CREATE PROCEDURE X_AUTO_CHUNKED(
+    AOPERATION CHAR(1),
+    SOURCE_SCHEMA VARCHAR(128),
+    SOURCE_TABLE VARCHAR(128),
+    DEST_SCHEMA VARCHAR(128),
+    DEST_TABLE VARCHAR(128),
+    DEST_KEY VARCHAR(128),
+    CHUNK_SIZE INTEGER
+)
+    SPECIFIC X_AUTO_CHUNKED
+    MODIFIES SQL DATA
+    NOT DETERMINISTIC
+    NO EXTERNAL ACTION
+    LANGUAGE SQL
+BEGIN
+    DECLARE DML CLOB(64K) DEFAULT '';
+    DECLARE BOUND_SQL CLOB(64K) DEFAULT '';
+    DECLARE PREDICATE CLOB(64K) DEFAULT '';
+    DECLARE KEY_AFTER CLOB(64K) DEFAULT '';
+    DECLARE KEY_COLS VARCHAR(8000) DEFAULT '';
+    DECLARE CHUNK_SCHEMA VARCHAR(128) DEFAULT '';
+    DECLARE CHUNK_TABLE VARCHAR(128) DEFAULT '';
+    DECLARE OPERATION_NAME VARCHAR(20) DEFAULT '';
+    DECLARE PRIOR_KEY VARCHAR(128) DEFAULT NULL;
+    DECLARE PRIOR_COMPLETED TIMESTAMP DEFAULT NULL;
+    DECLARE KEY_NOT_NULL CLOB(64K) DEFAULT '';
+    DECLARE FROM_KEY CLOB(64K) DEFAULT NULL;
+    DECLARE TO_KEY CLOB(64K) DEFAULT NULL;
+    DECLARE FINAL CHAR(1) DEFAULT 'N';
+    DECLARE CHUNK INTEGER DEFAULT 0;
+    DECLARE CHUNK_ROWS BIGINT DEFAULT 0;
+    DECLARE TOTAL_ROWS BIGINT DEFAULT 0;
+    DECLARE CHUNK_START TIMESTAMP DEFAULT NULL;
+    DECLARE CHUNK_END TIMESTAMP DEFAULT NULL;
+    DECLARE ELAPSED DECIMAL(18, 6) DEFAULT 0;
+    DECLARE BOUND_STMT STATEMENT;
+    DECLARE BOUND_CUR CURSOR WITH HOLD FOR BOUND_STMT;
+
+    IF CHUNK_SIZE IS NULL OR CHUNK_SIZE < 1 THEN
+        CALL SIGNAL_STATE(MERGE_CHUNK_SIZE_STATE, 'CHUNK_SIZE must be a positive integer');
+    END IF;
+    CALL X_MERGE_CHECKS(SOURCE_SCHEMA, SOURCE_TABLE, DEST_SCHEMA, DEST_TABLE, DEST_KEY);
+    IF NOT EXISTS (
+        SELECT 1
+        FROM SYSCAT.TABCONST
+        WHERE TABSCHEMA = DEST_SCHEMA
+        AND TABNAME = DEST_TABLE
+        AND CONSTNAME = DEST_KEY
+        AND TYPE IN ('P', 'U')
+    ) THEN
+        CALL SIGNAL_STATE(MERGE_NO_KEY_STATE, 'Chunked operations require a unique key in the destination table');
+    END IF;
+    IF AOPERATION = 'D' THEN
+        SET CHUNK_SCHEMA = DEST_SCHEMA;
+        SET CHUNK_TABLE = DEST_TABLE;
+        SET OPERATION_NAME = 'AUTO_DELETE_CHUNKED';
+    ELSE
+        SET CHUNK_SCHEMA = SOURCE_SCHEMA;
+        SET CHUNK_TABLE = SOURCE_TABLE;
+        SET OPERATION_NAME = CASE AOPERATION
+            WHEN 'I' THEN 'AUTO_INSERT_CHUNKED'
+            ELSE 'AUTO_MERGE_CHUNKED'
+        END;
+    END IF;
+    -- The boundaries between chunks are stored as the text of a predicate
+    -- including the key values, hence the key must consist of built-in types
+    -- with an exact textual representation, and the predicate must fit within
+    -- a VARCHAR (allowing for each column of the key appearing twice in the
+    -- predicate, and the quotes of string values being doubled)
+    IF EXISTS (
+        SELECT 1
+        FROM
+            SYSCAT.KEYCOLUSE K
+            INNER JOIN SYSCAT.COLUMNS C
+                ON K.COLNAME = C.COLNAME
+        WHERE
+            K.TABSCHEMA = DEST_SCHEMA
+            AND K.TABNAME = DEST_TABLE
+            AND K.CONSTNAME = DEST_KEY
+            AND C.TABSCHEMA = CHUNK_SCHEMA
+            AND C.TABNAME = CHUNK_TABLE
+            AND (
+                C.TYPESCHEMA <> 'SYSIBM'
+                OR C.TYPENAME NOT IN (
+                    'CHARACTER', 'VARCHAR', 'GRAPHIC', 'VARGRAPHIC',
+                    'SMALLINT', 'INTEGER', 'BIGINT', 'DECIMAL', 'DECFLOAT',
+                    'DATE', 'TIME', 'TIMESTAMP'
+                )
+                OR (C.TYPENAME = 'TIMESTAMP' AND C.SCALE > 6)
+            )
+    ) THEN
+        CALL SIGNAL_STATE(MERGE_CHUNK_KEY_STATE, 'Chunked operations require a key consisting of exact built-in types (not ' || DEST_KEY || ')');
+    END IF;
+    IF (
+        SELECT SUM(
+            2 * LENGTH(QUOTE_IDENTIFIER(C.COLNAME)) + 20 +
+            2 * CASE
+                WHEN C.TYPENAME IN ('CHARACTER', 'VARCHAR') THEN 2 * C.LENGTH + 2
+                WHEN C.TYPENAME IN ('GRAPHIC', 'VARGRAPHIC') THEN 6 * C.LENGTH + 2
+                WHEN C.TYPENAME = 'DECIMAL' THEN C.LENGTH + 2
+                WHEN C.TYPENAME = 'DECFLOAT' THEN 42
+                ELSE 28
+            END
+        )
+        FROM
+            SYSCAT.KEYCOLUSE K
+            INNER JOIN SYSCAT.COLUMNS C
+                ON K.COLNAME = C.COLNAME
+        WHERE
+            K.TABSCHEMA = DEST_SCHEMA
+            AND K.TABNAME = DEST_TABLE
+            AND K.CONSTNAME = DEST_KEY
+            AND C.TABSCHEMA = CHUNK_SCHEMA
+            AND C.TABNAME = CHUNK_TABLE
+    ) > 32000 THEN
+        CALL SIGNAL_STATE(MERGE_CHUNK_KEY_STATE, 'Chunked operations require a key shorter than that of ' || DEST_KEY);
+    END IF;
+    FOR D AS
+        SELECT COLNAME AS NAME
+        FROM SYSCAT.KEYCOLUSE
+        WHERE TABSCHEMA = DEST_SCHEMA
+        AND TABNAME = DEST_TABLE
+        AND CONSTNAME = DEST_KEY
+        ORDER BY COLSEQ
+    DO
+        IF KEY_COLS <> '' THEN
+            SET KEY_COLS = KEY_COLS || ',';
+        END IF;
+        SET KEY_COLS = KEY_COLS || QUOTE_IDENTIFIER(NAME);
+        SET KEY_NOT_NULL = KEY_NOT_NULL || ' AND ' || QUOTE_IDENTIFIER(NAME) || ' IS NOT NULL';
+    END FOR;
+    SET KEY_NOT_NULL = SUBSTR(KEY_NOT_NULL, 6);
+    SET KEY_AFTER = X_BUILD_KEY_AFTER(CHUNK_SCHEMA, CHUNK_TABLE, DEST_SCHEMA, DEST_TABLE, DEST_KEY);
+
+    -- Resume an incomplete operation (provided it was using the same key),
+    -- otherwise start afresh
+    SET (PRIOR_KEY, PRIOR_COMPLETED, FROM_KEY, CHUNK) = (
+        SELECT CONSTNAME, COMPLETED, LAST_KEY, CHUNKS
+        FROM MERGE_PROGRESS
+        WHERE TABSCHEMA = DEST_SCHEMA
+        AND TABNAME = DEST_TABLE
+        AND SOURCE_TABSCHEMA = SOURCE_SCHEMA
+        AND SOURCE_TABNAME = SOURCE_TABLE
+        AND OPERATION = AOPERATION
+    );
+    IF PRIOR_KEY IS NULL OR PRIOR_KEY <> DEST_KEY OR PRIOR_COMPLETED IS NOT NULL THEN
+        SET FROM_KEY = NULL;
+        SET CHUNK = 0;
+        DELETE FROM MERGE_PROGRESS
+            WHERE TABSCHEMA = DEST_SCHEMA
+            AND TABNAME = DEST_TABLE
+            AND SOURCE_TABSCHEMA = SOURCE_SCHEMA
+            AND SOURCE_TABNAME = SOURCE_TABLE
+            AND OPERATION = AOPERATION;
+        INSERT INTO MERGE_PROGRESS (TABSCHEMA, TABNAME, SOURCE_TABSCHEMA, SOURCE_TABNAME, OPERATION, CONSTNAME)
+            VALUES (DEST_SCHEMA, DEST_TABLE, SOURCE_SCHEMA, SOURCE_TABLE, AOPERATION, DEST_KEY);
+    ELSE
+        CALL WRITE_LOG('I', 'T', DEST_SCHEMA, DEST_TABLE,
+            OPERATION_NAME || ' from ' || QUOTE_IDENTIFIER(SOURCE_SCHEMA) || '.' || QUOTE_IDENTIFIER(SOURCE_TABLE)
+            || ' resuming after chunk ' || VARCHAR(CHUNK));
+    END IF;
+    -- Flush any messages buffered by WRITE_LOG (see LOG_BUFFER_SIZE) before
+    -- each commit, so that the log is committed with the progress it reports
+    CALL FLUSH_LOG();
+    COMMIT;
+
+    -- Find the boundaries of all the remaining chunks with a single query
+    -- which numbers the remaining keys in order, and returns every
+    -- CHUNK_SIZE'th as the text of a predicate matching all keys after it.
+    -- The query is walked by a cursor held open across the commit of each
+    -- chunk so the keys are only read (and sorted) once. Each chunk's
+    -- predicate is built from the boundary at the end of the prior chunk and
+    -- the boundary at the end of this chunk. When the boundaries are exhausted
+    -- a final chunk covers all keys after the last boundary
+    SET BOUND_SQL = 'SELECT ' || KEY_AFTER || ' '
+        || 'FROM ('
+        ||     'SELECT ' || KEY_COLS || ', ROW_NUMBER() OVER (ORDER BY ' || KEY_COLS || ') AS CHUNK_ROW '
+        ||     'FROM ' || QUOTE_IDENTIFIER(CHUNK_SCHEMA) || '.' || QUOTE_IDENTIFIER(CHUNK_TABLE) || ' '
+        ||     'WHERE ' || COALESCE(FROM_KEY, KEY_NOT_NULL) || ' '
+        || ') AS B '
+        || 'WHERE MOD(B.CHUNK_ROW, ' || VARCHAR(CHUNK_SIZE) || ') = 0 '
+        || 'ORDER BY B.CHUNK_ROW';
+    PREPARE BOUND_STMT FROM BOUND_SQL;
+    OPEN BOUND_CUR;
+    WHILE FINAL = 'N' DO
+        SET CHUNK_START = CURRENT TIMESTAMP;
+        SET TO_KEY = NULL;
+        FETCH BOUND_CUR INTO TO_KEY;
+        SET CHUNK = CHUNK + 1;
+        IF TO_KEY IS NULL THEN
+            SET FINAL = 'Y';
+            SET PREDICATE = COALESCE(FROM_KEY, KEY_NOT_NULL);
+        ELSE
+            SET PREDICATE = COALESCE('(' || FROM_KEY || ') AND ', '') || 'NOT (' || TO_KEY || ')';
+        END IF;
+        SET DML = CASE AOPERATION
+            WHEN 'I' THEN X_BUILD_INSERT(SOURCE_SCHEMA, SOURCE_TABLE, DEST_SCHEMA, DEST_TABLE, PREDICATE)
+            WHEN 'M' THEN X_BUILD_MERGE(SOURCE_SCHEMA, SOURCE_TABLE, DEST_SCHEMA, DEST_TABLE, DEST_KEY, PREDICATE, 'N', CAST(NULL AS VARCHAR(128)))
+            WHEN 'D' THEN X_BUILD_DELETE(SOURCE_SCHEMA, SOURCE_TABLE, DEST_SCHEMA, DEST_TABLE, DEST_KEY, PREDICATE)
+        END;
+        EXECUTE IMMEDIATE DML;
+        GET DIAGNOSTICS CHUNK_ROWS = ROW_COUNT;
+        SET CHUNK_END = CURRENT TIMESTAMP;
+        SET ELAPSED = (SECONDS(CHUNK_END) - SECONDS(CHUNK_START))
+            + (MICROSECOND(CHUNK_END) - MICROSECOND(CHUNK_START)) / 1000000.0;
+        -- The final chunk marks the operation complete in the same unit of
+        -- work, so that it is never repeated by a subsequent call
+        UPDATE MERGE_PROGRESS
+            SET
+                CHUNKS = CHUNK,
+                ROWS_AFFECTED = ROWS_AFFECTED + CHUNK_ROWS,
+                LAST_KEY = COALESCE(TO_KEY, LAST_KEY),
+                UPDATED = CHUNK_END,
+                COMPLETED = CASE FINAL WHEN 'Y' THEN CHUNK_END END
+            WHERE TABSCHEMA = DEST_SCHEMA
+            AND TABNAME = DEST_TABLE
+            AND SOURCE_TABSCHEMA = SOURCE_SCHEMA
+            AND SOURCE_TABNAME = SOURCE_TABLE
+            AND OPERATION = AOPERATION;
+        CALL WRITE_LOG('I', 'T', DEST_SCHEMA, DEST_TABLE,
+            OPERATION_NAME || ' from ' || QUOTE_IDENTIFIER(SOURCE_SCHEMA) || '.' || QUOTE_IDENTIFIER(SOURCE_TABLE)
+            || ' chunk ' || VARCHAR(CHUNK) || ': ' || VARCHAR(CHUNK_ROWS) || ' rows in '
+            || VARCHAR(ELAPSED) || ' seconds');
+        CALL FLUSH_LOG();
+        COMMIT;
+        SET FROM_KEY = TO_KEY;
+    END WHILE;
+    CLOSE BOUND_CUR;
+
+    SET TOTAL_ROWS = (
+        SELECT ROWS_AFFECTED
+        FROM MERGE_PROGRESS
+        WHERE TABSCHEMA = DEST_SCHEMA
+        AND TABNAME = DEST_TABLE
+        AND SOURCE_TABSCHEMA = SOURCE_SCHEMA
+        AND SOURCE_TABNAME = SOURCE_TABLE
+        AND OPERATION = AOPERATION
+    );
+    CALL WRITE_LOG('I', 'T', DEST_SCHEMA, DEST_TABLE,
+        OPERATION_NAME || ' from ' || QUOTE_IDENTIFIER(SOURCE_SCHEMA) || '.' || QUOTE_IDENTIFIER(SOURCE_TABLE)
+        || ' completed: ' || VARCHAR(CHUNK) || ' chunks, ' || VARCHAR(TOTAL_ROWS) || ' rows');
+    CALL FLUSH_LOG();
+    COMMIT;
+END!
+
+-- AUTO_INSERT_CHUNKED(SOURCE_SCHEMA, SOURCE_TABLE, DEST_SCHEMA, DEST_TABLE, DEST_KEY, CHUNK_SIZE)
+-- AUTO_INSERT_CHUNKED(SOURCE_SCHEMA, SOURCE_TABLE, DEST_SCHEMA, DEST_TABLE, CHUNK_SIZE)
+-- AUTO_INSERT_CHUNKED(SOURCE_TABLE, DEST_TABLE, DEST_KEY, CHUNK_SIZE)
+-- AUTO_INSERT_CHUNKED(SOURCE_TABLE, DEST_TABLE, CHUNK_SIZE)
+-------------------------------------------------------------------------------
+-- The AUTO_INSERT_CHUNKED procedure is a variant of AUTO_INSERT intended for
+-- very large source tables. Like AUTO_INSERT, it inserts all data from
+-- SOURCE_TABLE into DEST_TABLE by means of an automatically generated INSERT
+-- statement covering all columns common to both tables.
+--
+-- The operation is divided into chunks of CHUNK_SIZE rows of SOURCE_TABLE,
+-- in the order of the columns of DEST_KEY, and a COMMIT is performed after
+-- each chunk. Hence, this procedure must not be called within an atomic block.
+-- The progress of the operation is recorded in the MERGE_PROGRESS table, and
+-- if the procedure fails (or is interrupted) a subsequent call with the same
+-- parameters resumes after the last completed chunk. The number of rows
+-- affected by each chunk, and the time it took, are written to the LOG table.
+--
+-- The DEST_KEY parameter specifies the name of the unique key to use for
+-- identifying rows in the destination table. If specified, it must be the name
+-- of a unique key or primary key which covers columns which exist in both the
+-- source and destination tables. If omitted, it defaults to the name of the
+-- primary key of the destination table.
+--
+-- If SOURCE_SCHEMA and DEST_SCHEMA are not specified they default to the
+-- current schema.
+-------------------------------------------------------------------------------
+
+CREATE PROCEDURE AUTO_INSERT_CHUNKED(
+    SOURCE_SCHEMA VARCHAR(128),
+    SOURCE_TABLE VARCHAR(128),
+    DEST_SCHEMA VARCHAR(128),
+    DEST_TABLE VARCHAR(128),
+    DEST_KEY VARCHAR(128),
+    CHUNK_SIZE INTEGER
+)
+    SPECIFIC AUTO_INSERT_CHUNKED1
+    MODIFIES SQL DATA
+    NOT DETERMINISTIC
+    NO EXTERNAL ACTION
+    LANGUAGE SQL
+BEGIN
+    CALL X_AUTO_CHUNKED('I', SOURCE_SCHEMA, SOURCE_TABLE, DEST_SCHEMA, DEST_TABLE, DEST_KEY, CHUNK_SIZE);
+END!
+
+CREATE PROCEDURE AUTO_INSERT_CHUNKED(
+    SOURCE_SCHEMA VARCHAR(128),
+    SOURCE_TABLE VARCHAR(128),
+    DEST_SCHEMA VARCHAR(128),
+    DEST_TABLE VARCHAR(128),
+    CHUNK_SIZE INTEGER
+)
+    SPECIFIC AUTO_INSERT_CHUNKED2
+    MODIFIES SQL DATA
+    NOT DETERMINISTIC
+    NO EXTERNAL ACTION
+    LANGUAGE SQL
+BEGIN
+    CALL AUTO_INSERT_CHUNKED(SOURCE_SCHEMA, SOURCE_TABLE, DEST_SCHEMA, DEST_TABLE, (
+        SELECT CONSTNAME
+        FROM SYSCAT.TABCONST
+        WHERE TABSCHEMA = DEST_SCHEMA
+        AND TABNAME = DEST_TABLE
+        AND TYPE = 'P'), CHUNK_SIZE);
+END!
+
+CREATE PROCEDURE AUTO_INSERT_CHUNKED(
+    SOURCE_TABLE VARCHAR(128),
+    DEST_TABLE VARCHAR(128),
+    DEST_KEY VARCHAR(128),
+    CHUNK_SIZE INTEGER
+)
+    SPECIFIC AUTO_INSERT_CHUNKED3
+    MODIFIES SQL DATA
+    NOT DETERMINISTIC
+    NO EXTERNAL ACTION
+    LANGUAGE SQL
+BEGIN
+    CALL AUTO_INSERT_CHUNKED(CURRENT SCHEMA, SOURCE_TABLE, CURRENT SCHEMA, DEST_TABLE, DEST_KEY, CHUNK_SIZE);
+END!
+
+CREATE PROCEDURE AUTO_INSERT_CHUNKED(
+    SOURCE_TABLE VARCHAR(128),
+    DEST_TABLE VARCHAR(128),
+    CHUNK_SIZE INTEGER
+)
+    SPECIFIC AUTO_INSERT_CHUNKED4
+    MODIFIES SQL DATA
+    NOT DETERMINISTIC
+    NO EXTERNAL ACTION
+    LANGUAGE SQL
+BEGIN
+    CALL AUTO_INSERT_CHUNKED(CURRENT SCHEMA, SOURCE_TABLE, CURRENT SCHEMA, DEST_TABLE, (
+        SELECT CONSTNAME
+        FROM SYSCAT.TABCONST
+        WHERE TABSCHEMA = CURRENT SCHEMA
+        AND TABNAME = DEST_TABLE
+        AND TYPE = 'P'), CHUNK_SIZE);
+END!
+
+GRANT EXECUTE ON SPECIFIC PROCEDURE AUTO_INSERT_CHUNKED1 TO ROLE UTILS_MERGE_USER!
+GRANT EXECUTE ON SPECIFIC PROCEDURE AUTO_INSERT_CHUNKED2 TO ROLE UTILS_MERGE_USER!
+GRANT EXECUTE ON SPECIFIC PROCEDURE AUTO_INSERT_CHUNKED3 TO ROLE UTILS_MERGE_USER!
+GRANT EXECUTE ON SPECIFIC PROCEDURE AUTO_INSERT_CHUNKED4 TO ROLE UTILS_MERGE_USER!
+GRANT EXECUTE ON SPECIFIC PROCEDURE AUTO_INSERT_CHUNKED1 TO ROLE UTILS_MERGE_ADMIN WITH GRANT OPTION!
+GRANT EXECUTE ON SPECIFIC PROCEDURE AUTO_INSERT_CHUNKED2 TO ROLE UTILS_MERGE_ADMIN WITH GRANT OPTION!
+GRANT EXECUTE ON SPECIFIC PROCEDURE AUTO_INSERT_CHUNKED3 TO ROLE UTILS_MERGE_ADMIN WITH GRANT OPTION!
+GRANT EXECUTE ON SPECIFIC PROCEDURE AUTO_INSERT_CHUNKED4 TO ROLE UTILS_MERGE_ADMIN WITH GRANT OPTION!
+
+COMMENT ON SPECIFIC PROCEDURE AUTO_INSERT_CHUNKED1
+    IS 'Automatically inserts data from SOURCE_TABLE into DEST_TABLE in chunks of CHUNK_SIZE rows, committing after each'!
+COMMENT ON SPECIFIC PROCEDURE AUTO_INSERT_CHUNKED2
+    IS 'Automatically inserts data from SOURCE_TABLE into DEST_TABLE in chunks of CHUNK_SIZE rows, committing after each'!
+COMMENT ON SPECIFIC PROCEDURE AUTO_INSERT_CHUNKED3
+    IS 'Automatically inserts data from SOURCE_TABLE into DEST_TABLE in chunks of CHUNK_SIZE rows, committing after each'!
+COMMENT ON SPECIFIC PROCEDURE AUTO_INSERT_CHUNKED4
+    IS 'Automatically inserts data from SOURCE_TABLE into DEST_TABLE in chunks of CHUNK_SIZE rows, committing after each'!
+
+-- AUTO_MERGE_CHUNKED(SOURCE_SCHEMA, SOURCE_TABLE, DEST_SCHEMA, DEST_TABLE, DEST_KEY, CHUNK_SIZE)
+-- AUTO_MERGE_CHUNKED(SOURCE_SCHEMA, SOURCE_TABLE, DEST_SCHEMA, DEST_TABLE, CHUNK_SIZE)
+-- AUTO_MERGE_CHUNKED(SOURCE_TABLE, DEST_TABLE, DEST_KEY, CHUNK_SIZE)
+-- AUTO_MERGE_CHUNKED(SOURCE_TABLE, DEST_TABLE, CHUNK_SIZE)
+-------------------------------------------------------------------------------
+-- The AUTO_MERGE_CHUNKED procedure is a variant of AUTO_MERGE intended for
+-- very large source tables. Like AUTO_MERGE, it performs an "upsert", or
+-- combined insert and update of all data from SOURCE_TABLE into DEST_TABLE by
+-- means of an automatically generated MERGE statement.
+--
+-- The operation is divided into chunks of CHUNK_SIZE rows of SOURCE_TABLE,
+-- in the order of the columns of DEST_KEY, and a COMMIT is performed after
+-- each chunk. Hence, this procedure must not be called within an atomic block.
+-- The progress of the operation is recorded in the MERGE_PROGRESS table, and
+-- if the procedure fails (or is interrupted) a subsequent call with the same
+-- parameters resumes after the last completed chunk. The number of rows
+-- affected by each chunk, and the time it took, are written to the LOG table.
+--
+-- The DEST_KEY parameter specifies the name of the unique key to use for
+-- identifying rows in the destination table. If specified, it must be the name
+-- of a unique key or primary key which covers columns which exist in both the
+-- source and destination tables. If omitted, it defaults to the name of the
+-- primary key of the destination table.
+--
+-- If SOURCE_SCHEMA and DEST_SCHEMA are not specified they default to the
+-- current schema.
+-------------------------------------------------------------------------------
+
+CREATE PROCEDURE AUTO_MERGE_CHUNKED(
+    SOURCE_SCHEMA VARCHAR(128),
+    SOURCE_TABLE VARCHAR(128),
+    DEST_SCHEMA VARCHAR(128),
+    DEST_TABLE VARCHAR(128),
+    DEST_KEY VARCHAR(128),
+    CHUNK_SIZE INTEGER
+)
+    SPECIFIC AUTO_MERGE_CHUNKED1
+    MODIFIES SQL DATA
+    NOT DETERMINISTIC
+    NO EXTERNAL ACTION
+    LANGUAGE SQL
+BEGIN
+    CALL X_AUTO_CHUNKED('M', SOURCE_SCHEMA, SOURCE_TABLE, DEST_SCHEMA, DEST_TABLE, DEST_KEY, CHUNK_SIZE);
+END!
+
+CREATE PROCEDURE AUTO_MERGE_CHUNKED(
+    SOURCE_SCHEMA VARCHAR(128),
+    SOURCE_TABLE VARCHAR(128),
+    DEST_SCHEMA VARCHAR(128),
+    DEST_TABLE VARCHAR(128),
+    CHUNK_SIZE INTEGER
+)
+    SPECIFIC AUTO_MERGE_CHUNKED2
+    MODIFIES SQL DATA
+    NOT DETERMINISTIC
+    NO EXTERNAL ACTION
+    LANGUAGE SQL
+BEGIN
+    CALL AUTO_MERGE_CHUNKED(SOURCE_SCHEMA, SOURCE_TABLE, DEST_SCHEMA, DEST_TABLE, (
+        SELECT CONSTNAME
+        FROM SYSCAT.TABCONST
+        WHERE TABSCHEMA = DEST_SCHEMA
+        AND TABNAME = DEST_TABLE
+        AND TYPE = 'P'), CHUNK_SIZE);
+END!
+
+CREATE PROCEDURE AUTO_MERGE_CHUNKED(
+    SOURCE_TABLE VARCHAR(128),
+    DEST_TABLE VARCHAR(128),
+    DEST_KEY VARCHAR(128),
+    CHUNK_SIZE INTEGER
+)
+    SPECIFIC AUTO_MERGE_CHUNKED3
+    MODIFIES SQL DATA
+    NOT DETERMINISTIC
+    NO EXTERNAL ACTION
+    LANGUAGE SQL
+BEGIN
+    CALL AUTO_MERGE_CHUNKED(CURRENT SCHEMA, SOURCE_TABLE, CURRENT SCHEMA, DEST_TABLE, DEST_KEY, CHUNK_SIZE);
+END!
+
+CREATE PROCEDURE AUTO_MERGE_CHUNKED(
+    SOURCE_TABLE VARCHAR(128),
+    DEST_TABLE VARCHAR(128),
+    CHUNK_SIZE INTEGER
+)
+    SPECIFIC AUTO_MERGE_CHUNKED4
+    MODIFIES SQL DATA
+    NOT DETERMINISTIC
+    NO EXTERNAL ACTION
+    LANGUAGE SQL
+BEGIN
+    CALL AUTO_MERGE_CHUNKED(CURRENT SCHEMA, SOURCE_TABLE, CURRENT SCHEMA, DEST_TABLE, (
+        SELECT CONSTNAME
+        FROM SYSCAT.TABCONST
+        WHERE TABSCHEMA = CURRENT SCHEMA
+        AND TABNAME = DEST_TABLE
+        AND TYPE = 'P'), CHUNK_SIZE);
+END!
+
+GRANT EXECUTE ON SPECIFIC PROCEDURE AUTO_MERGE_CHUNKED1 TO ROLE UTILS_MERGE_USER!
+GRANT EXECUTE ON SPECIFIC PROCEDURE AUTO_MERGE_CHUNKED2 TO ROLE UTILS_MERGE_USER!
+GRANT EXECUTE ON SPECIFIC PROCEDURE AUTO_MERGE_CHUNKED3 TO ROLE UTILS_MERGE_USER!
+GRANT EXECUTE ON SPECIFIC PROCEDURE AUTO_MERGE_CHUNKED4 TO ROLE UTILS_MERGE_USER!
+GRANT EXECUTE ON SPECIFIC PROCEDURE AUTO_MERGE_CHUNKED1 TO ROLE UTILS_MERGE_ADMIN WITH GRANT OPTION!
+GRANT EXECUTE ON SPECIFIC PROCEDURE AUTO_MERGE_CHUNKED2 TO ROLE UTILS_MERGE_ADMIN WITH GRANT OPTION!
+GRANT EXECUTE ON SPECIFIC PROCEDURE AUTO_MERGE_CHUNKED3 TO ROLE UTILS_MERGE_ADMIN WITH GRANT OPTION!
+GRANT EXECUTE ON SPECIFIC PROCEDURE AUTO_MERGE_CHUNKED4 TO ROLE UTILS_MERGE_ADMIN WITH GRANT OPTION!
+
+COMMENT ON SPECIFIC PROCEDURE AUTO_MERGE_CHUNKED1
+    IS 'Automatically upserts data from SOURCE_TABLE into DEST_TABLE in chunks of CHUNK_SIZE rows, committing after each'!
+COMMENT ON SPECIFIC PROCEDURE AUTO_MERGE_CHUNKED2
+    IS 'Automatically upserts data from SOURCE_TABLE into DEST_TABLE in chunks of CHUNK_SIZE rows, committing after each'!
+COMMENT ON SPECIFIC PROCEDURE AUTO_MERGE_CHUNKED3
+    IS 'Automatically upserts data from SOURCE_TABLE into DEST_TABLE in chunks of CHUNK_SIZE rows, committing after each'!
+COMMENT ON SPECIFIC PROCEDURE AUTO_MERGE_CHUNKED4
+    IS 'Automatically upserts data from SOURCE_TABLE into DEST_TABLE in chunks of CHUNK_SIZE rows, committing after each'!
+
+-- AUTO_DELETE_CHUNKED(SOURCE_SCHEMA, SOURCE_TABLE, DEST_SCHEMA, DEST_TABLE, DEST_KEY, CHUNK_SIZE)
+-- AUTO_DELETE_CHUNKED(SOURCE_SCHEMA, SOURCE_TABLE, DEST_SCHEMA, DEST_TABLE, CHUNK_SIZE)
+-- AUTO_DELETE_CHUNKED(SOURCE_TABLE, DEST_TABLE, DEST_KEY, CHUNK_SIZE)
+-- AUTO_DELETE_CHUNKED(SOURCE_TABLE, DEST_TABLE, CHUNK_SIZE)
+-------------------------------------------------------------------------------
+-- The AUTO_DELETE_CHUNKED procedure is a variant of AUTO_DELETE intended for
+-- very large tables. Like AUTO_DELETE, it deletes rows from DEST_TABLE that
+-- do not exist in SOURCE_TABLE.
+--
+-- The operation is divided into chunks of CHUNK_SIZE rows of DEST_TABLE,
+-- in the order of the columns of DEST_KEY, and a COMMIT is performed after
+-- each chunk. Hence, this procedure must not be called within an atomic block.
+-- The progress of the operation is recorded in the MERGE_PROGRESS table, and
+-- if the procedure fails (or is interrupted) a subsequent call with the same
+-- parameters resumes after the last completed chunk. The number of rows
+-- affected by each chunk, and the time it took, are written to the LOG table.
+--
+-- The DEST_KEY parameter specifies the name of the unique key to use for
+-- identifying rows in the destination table. If specified, it must be the name
+-- of a unique key or primary key which covers columns which exist in both the
+-- source and destination tables. If omitted, it defaults to the name of the
+-- primary key of the destination table.
+--
+-- If SOURCE_SCHEMA and DEST_SCHEMA are not specified they default to the
+-- current schema.
+-------------------------------------------------------------------------------
+
+CREATE PROCEDURE AUTO_DELETE_CHUNKED(
+    SOURCE_SCHEMA VARCHAR(128),
+    SOURCE_TABLE VARCHAR(128),
+    DEST_SCHEMA VARCHAR(128),
+    DEST_TABLE VARCHAR(128),
+    DEST_KEY VARCHAR(128),
+    CHUNK_SIZE INTEGER
+)
+    SPECIFIC AUTO_DELETE_CHUNKED1
+    MODIFIES SQL DATA
+    NOT DETERMINISTIC
+    NO EXTERNAL ACTION
+    LANGUAGE SQL
+BEGIN
+    CALL X_AUTO_CHUNKED('D', SOURCE_SCHEMA, SOURCE_TABLE, DEST_SCHEMA, DEST_TABLE, DEST_KEY, CHUNK_SIZE);
+END!
+
+CREATE PROCEDURE AUTO_DELETE_CHUNKED(
+    SOURCE_SCHEMA VARCHAR(128),
+    SOURCE_TABLE VARCHAR(128),
+    DEST_SCHEMA VARCHAR(128),
+    DEST_TABLE VARCHAR(128),
+    CHUNK_SIZE INTEGER
+)
+    SPECIFIC AUTO_DELETE_CHUNKED2
+    MODIFIES SQL DATA
+    NOT DETERMINISTIC
+    NO EXTERNAL ACTION
+    LANGUAGE SQL
+BEGIN
+    CALL AUTO_DELETE_CHUNKED(SOURCE_SCHEMA, SOURCE_TABLE, DEST_SCHEMA, DEST_TABLE, (
+        SELECT CONSTNAME
+        FROM SYSCAT.TABCONST
+        WHERE TABSCHEMA = DEST_SCHEMA
+        AND TABNAME = DEST_TABLE
+        AND TYPE = 'P'), CHUNK_SIZE);
+END!
+
+CREATE PROCEDURE AUTO_DELETE_CHUNKED(
+    SOURCE_TABLE VARCHAR(128),
+    DEST_TABLE VARCHAR(128),
+    DEST_KEY VARCHAR(128),
+    CHUNK_SIZE INTEGER
+)
+    SPECIFIC AUTO_DELETE_CHUNKED3
+    MODIFIES SQL DATA
+    NOT DETERMINISTIC
+    NO EXTERNAL ACTION
+    LANGUAGE SQL
+BEGIN
+    CALL AUTO_DELETE_CHUNKED(CURRENT SCHEMA, SOURCE_TABLE, CURRENT SCHEMA, DEST_TABLE, DEST_KEY, CHUNK_SIZE);
+END!
+
+CREATE PROCEDURE AUTO_DELETE_CHUNKED(
+    SOURCE_TABLE VARCHAR(128),
+    DEST_TABLE VARCHAR(128),
+    CHUNK_SIZE INTEGER
+)
+    SPECIFIC AUTO_DELETE_CHUNKED4
+    MODIFIES SQL DATA
+    NOT DETERMINISTIC
+    NO EXTERNAL ACTION
+    LANGUAGE SQL
+BEGIN
+    CALL AUTO_DELETE_CHUNKED(CURRENT SCHEMA, SOURCE_TABLE, CURRENT SCHEMA, DEST_TABLE, (
+        SELECT CONSTNAME
+        FROM SYSCAT.TABCONST
+        WHERE TABSCHEMA = CURRENT SCHEMA
+        AND TABNAME = DEST_TABLE
+        AND TYPE = 'P'), CHUNK_SIZE);
+END!
+
+GRANT EXECUTE ON SPECIFIC PROCEDURE AUTO_DELETE_CHUNKED1 TO ROLE UTILS_MERGE_USER!
+GRANT EXECUTE ON SPECIFIC PROCEDURE AUTO_DELETE_CHUNKED2 TO ROLE UTILS_MERGE_USER!
+GRANT EXECUTE ON SPECIFIC PROCEDURE AUTO_DELETE_CHUNKED3 TO ROLE UTILS_MERGE_USER!
+GRANT EXECUTE ON SPECIFIC PROCEDURE AUTO_DELETE_CHUNKED4 TO ROLE UTILS_MERGE_USER!
+GRANT EXECUTE ON SPECIFIC PROCEDURE AUTO_DELETE_CHUNKED1 TO ROLE UTILS_MERGE_ADMIN WITH GRANT OPTION!
+GRANT EXECUTE ON SPECIFIC PROCEDURE AUTO_DELETE_CHUNKED2 TO ROLE UTILS_MERGE_ADMIN WITH GRANT OPTION!
+GRANT EXECUTE ON SPECIFIC PROCEDURE AUTO_DELETE_CHUNKED3 TO ROLE UTILS_MERGE_ADMIN WITH GRANT OPTION!
+GRANT EXECUTE ON SPECIFIC PROCEDURE AUTO_DELETE_CHUNKED4 TO ROLE UTILS_MERGE_ADMIN WITH GRANT OPTION!
+
+COMMENT ON SPECIFIC PROCEDURE AUTO_DELETE_CHUNKED1
+    IS 'Automatically removes data from DEST_TABLE that doesn''t exist in SOURCE_TABLE in chunks of CHUNK_SIZE rows, committing after each'!
+COMMENT ON SPECIFIC PROCEDURE AUTO_DELETE_CHUNKED2
+    IS 'Automatically removes data from DEST_TABLE that doesn''t exist in SOURCE_TABLE in chunks of CHUNK_SIZE rows, committing after each'!
+COMMENT ON SPECIFIC PROCEDURE AUTO_DELETE_CHUNKED3
+    IS 'Automatically removes data from DEST_TABLE that doesn''t exist in SOURCE_TABLE in chunks of CHUNK_SIZE rows, committing after each'!
+COMMENT ON SPECIFIC PROCEDURE AUTO_DELETE_CHUNKED4
+    IS 'Automatically removes data from DEST_TABLE that doesn''t exist in SOURCE_TABLE in chunks of CHUNK_SIZE rows, committing after each'!
+
+-- AUTO_MERGE_HASHED(SOURCE_SCHEMA, SOURCE_TABLE, DEST_SCHEMA, DEST_TABLE, DEST_KEY, HASH_COLUMN)
+-- AUTO_MERGE_HASHED(SOURCE_SCHEMA, SOURCE_TABLE, DEST_SCHEMA, DEST_TABLE, DEST_KEY)
+-- AUTO_MERGE_HASHED(SOURCE_TABLE, DEST_TABLE, DEST_KEY, HASH_COLUMN)
+-- AUTO_MERGE_HASHED(SOURCE_TABLE, DEST_TABLE, DEST_KEY)
+-- AUTO_MERGE_HASHED(SOURCE_TABLE, DEST_TABLE)
+-------------------------------------------------------------------------------
+-- The AUTO_MERGE_HASHED procedure is a variant of AUTO_MERGE which only
+-- updates rows of DEST_TABLE whose non-key columns actually differ from the
+-- corresponding row of SOURCE_TABLE. This is determined by comparing the
+-- ROW_HASH of the non-key columns of each row, rather than each column
+-- individually, which avoids rewriting (and logging, and firing triggers for)
+-- unchanged rows when merging a large, mostly unchanged source.
+--
+-- If HASH_COLUMN is specified, it must name a BIGINT column of DEST_TABLE in
+-- which the hash of each row will be persisted by the MERGE. Subsequent merges
+-- then compare the source hash to this column, instead of recalculating the
+-- hash of every target row. HASH_COLUMN is excluded from the hash, and must
+-- not be maintained by anything other than this procedure.
+--
+-- The DEST_KEY parameter specifies the name of the unique key to use for
+-- identifying rows in the destination table. If it is omitted or NULL, it
+-- defaults to the name of the primary key of the destination table. If
+-- SOURCE_SCHEMA and DEST_SCHEMA are not specified they default to the current
+-- schema.
+-------------------------------------------------------------------------------
+
+CREATE PROCEDURE AUTO_MERGE_HASHED(
+    SOURCE_SCHEMA VARCHAR(128),
+    SOURCE_TABLE VARCHAR(128),
+    DEST_SCHEMA VARCHAR(128),
+    DEST_TABLE VARCHAR(128),
+    DEST_KEY VARCHAR(128),
+    HASH_COLUMN VARCHAR(128)
+)
+    SPECIFIC AUTO_MERGE_HASHED1
+    MODIFIES SQL DATA
+    NOT DETERMINISTIC
+    NO EXTERNAL ACTION
+    LANGUAGE SQL
+BEGIN ATOMIC
+    DECLARE KEY_NAME VARCHAR(128) DEFAULT NULL;
+    DECLARE DML CLOB(64K) DEFAULT '';
+
+    SET KEY_NAME = COALESCE(DEST_KEY, (
+        SELECT CONSTNAME
+        FROM SYSCAT.TABCONST
+        WHERE TABSCHEMA = DEST_SCHEMA
+        AND TABNAME = DEST_TABLE
+        AND TYPE = 'P'));
+    CALL X_MERGE_CHECKS(SOURCE_SCHEMA, SOURCE_TABLE, DEST_SCHEMA, DEST_TABLE, KEY_NAME);
+    IF HASH_COLUMN IS NOT NULL THEN
+        CALL ASSERT_COLUMN_EXISTS(DEST_SCHEMA, DEST_TABLE, HASH_COLUMN);
+        IF NOT EXISTS (
+            SELECT 1
+            FROM SYSCAT.COLUMNS
+            WHERE TABSCHEMA = DEST_SCHEMA
+            AND TABNAME = DEST_TABLE
+            AND COLNAME = HASH_COLUMN
+            AND TYPESCHEMA = 'SYSIBM'
+            AND TYPENAME = 'BIGINT'
+        ) THEN
+            CALL SIGNAL_STATE(MERGE_HASH_TYPE_STATE, 'HASH_COLUMN must be a BIGINT column');
+        END IF;
+        IF EXISTS (
+            SELECT 1
+            FROM SYSCAT.KEYCOLUSE
+            WHERE TABSCHEMA = DEST_SCHEMA
+            AND TABNAME = DEST_TABLE
+            AND CONSTNAME = KEY_NAME
+            AND COLNAME = HASH_COLUMN
+        ) THEN
+            CALL SIGNAL_STATE(MERGE_HASH_TYPE_STATE, 'HASH_COLUMN must not be part of DEST_KEY');
+        END IF;
+    END IF;
+    SET DML = X_BUILD_MERGE(SOURCE_SCHEMA, SOURCE_TABLE, DEST_SCHEMA, DEST_TABLE, KEY_NAME, CAST(NULL AS CLOB(64K)), 'Y', HASH_COLUMN);
+    EXECUTE IMMEDIATE DML;
+END!
+
+CREATE PROCEDURE AUTO_MERGE_HASHED(
+    SOURCE_SCHEMA VARCHAR(128),
+    SOURCE_TABLE VARCHAR(128),
+    DEST_SCHEMA VARCHAR(128),
+    DEST_TABLE VARCHAR(128),
+    DEST_KEY VARCHAR(128)
+)
+    SPECIFIC AUTO_MERGE_HASHED2
+    MODIFIES SQL DATA
+    NOT DETERMINISTIC
+    NO EXTERNAL ACTION
+    LANGUAGE SQL
+BEGIN ATOMIC
+    CALL AUTO_MERGE_HASHED(SOURCE_SCHEMA, SOURCE_TABLE, DEST_SCHEMA, DEST_TABLE, DEST_KEY, CAST(NULL AS VARCHAR(128)));
+END!
+
+CREATE PROCEDURE AUTO_MERGE_HASHED(
+    SOURCE_TABLE VARCHAR(128),
+    DEST_TABLE VARCHAR(128),
+    DEST_KEY VARCHAR(128),
+    HASH_COLUMN VARCHAR(128)
+)
+    SPECIFIC AUTO_MERGE_HASHED3
+    MODIFIES SQL DATA
+    NOT DETERMINISTIC
+    NO EXTERNAL ACTION
+    LANGUAGE SQL
+BEGIN ATOMIC
+    CALL AUTO_MERGE_HASHED(CURRENT SCHEMA, SOURCE_TABLE, CURRENT SCHEMA, DEST_TABLE, DEST_KEY, HASH_COLUMN);
+END!
+
+CREATE PROCEDURE AUTO_MERGE_HASHED(
+    SOURCE_TABLE VARCHAR(128),
+    DEST_TABLE VARCHAR(128),
+    DEST_KEY VARCHAR(128)
+)
+    SPECIFIC AUTO_MERGE_HASHED4
+    MODIFIES SQL DATA
+    NOT DETERMINISTIC
+    NO EXTERNAL ACTION
+    LANGUAGE SQL
+BEGIN ATOMIC
+    CALL AUTO_MERGE_HASHED(CURRENT SCHEMA, SOURCE_TABLE, CURRENT SCHEMA, DEST_TABLE, DEST_KEY, CAST(NULL AS VARCHAR(128)));
+END!
+
+CREATE PROCEDURE AUTO_MERGE_HASHED(
+    SOURCE_TABLE VARCHAR(128),
+    DEST_TABLE VARCHAR(128)
+)
+    SPECIFIC AUTO_MERGE_HASHED5
+    MODIFIES SQL DATA
+    NOT DETERMINISTIC
+    NO EXTERNAL ACTION
+    LANGUAGE SQL
+BEGIN ATOMIC
+    CALL AUTO_MERGE_HASHED(CURRENT SCHEMA, SOURCE_TABLE, CURRENT SCHEMA, DEST_TABLE, CAST(NULL AS VARCHAR(128)), CAST(NULL AS VARCHAR(128)));
+END!
+
+GRANT EXECUTE ON SPECIFIC PROCEDURE AUTO_MERGE_HASHED1 TO ROLE UTILS_MERGE_USER!
+GRANT EXECUTE ON SPECIFIC PROCEDURE AUTO_MERGE_HASHED2 TO ROLE UTILS_MERGE_USER!
+GRANT EXECUTE ON SPECIFIC PROCEDURE AUTO_MERGE_HASHED3 TO ROLE UTILS_MERGE_USER!
+GRANT EXECUTE ON SPECIFIC PROCEDURE AUTO_MERGE_HASHED4 TO ROLE UTILS_MERGE_USER!
+GRANT EXECUTE ON SPECIFIC PROCEDURE AUTO_MERGE_HASHED5 TO ROLE UTILS_MERGE_USER!
+GRANT EXECUTE ON SPECIFIC PROCEDURE AUTO_MERGE_HASHED1 TO ROLE UTILS_MERGE_ADMIN WITH GRANT OPTION!
+GRANT EXECUTE ON SPECIFIC PROCEDURE AUTO_MERGE_HASHED2 TO ROLE UTILS_MERGE_ADMIN WITH GRANT OPTION!
+GRANT EXECUTE ON SPECIFIC PROCEDURE AUTO_MERGE_HASHED3 TO ROLE UTILS_MERGE_ADMIN WITH GRANT OPTION!
+GRANT EXECUTE ON SPECIFIC PROCEDURE AUTO_MERGE_HASHED4 TO ROLE UTILS_MERGE_ADMIN WITH GRANT OPTION!
+GRANT EXECUTE ON SPECIFIC PROCEDURE AUTO_MERGE_HASHED5 TO ROLE UTILS_MERGE_ADMIN WITH GRANT OPTION!
+
+COMMENT ON SPECIFIC PROCEDURE AUTO_MERGE_HASHED1
+    IS 'Automatically inserts/updates ("upserts") data from SOURCE_TABLE into DEST_TABLE based on DEST_KEY, only updating rows whose hash differs'!
+COMMENT ON SPECIFIC PROCEDURE AUTO_MERGE_HASHED2
+    IS 'Automatically inserts/updates ("upserts") data from SOURCE_TABLE into DEST_TABLE based on DEST_KEY, only updating rows whose hash differs'!
+COMMENT ON SPECIFIC PROCEDURE AUTO_MERGE_HASHED3
+    IS 'Automatically inserts/updates ("upserts") data from SOURCE_TABLE into DEST_TABLE based on DEST_KEY, only updating rows whose hash differs'!
+COMMENT ON SPECIFIC PROCEDURE AUTO_MERGE_HASHED4
+    IS 'Automatically inserts/updates ("upserts") data from SOURCE_TABLE into DEST_TABLE based on DEST_KEY, only updating rows whose hash differs'!
+COMMENT ON SPECIFIC PROCEDURE AUTO_MERGE_HASHED5
+    IS 'Automatically inserts/updates ("upserts") data from SOURCE_TABLE into DEST_TABLE based on DEST_KEY, only updating rows whose hash differs'!
+
 -- vim: set et sw=4 sts=4:
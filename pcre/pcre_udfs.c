@@ -28,6 +28,14 @@
  *
  * Use the provided Makefile to build and install this library, and to register
  * the contained functions with the database (see also pcre_udfs.sql).
+ *
+ * The library must remain thread-safe as the functions may be registered
+ * either NOT FENCED or FENCED THREADSAFE (see fenced.sql), in which case
+ * several threads will call them at once. Hence, there are no global or static
+ * variables: anything which must persist between calls (like the compiled
+ * pattern) lives in the scratchpad which DB2 allocates for each reference to a
+ * function, and errors are formatted straight into the buffers passed with
+ * each call.
  */
 
 #include <stdlib.h>
@@ -90,7 +98,8 @@ struct split_scratch_pad {
  * generic_scratch_pad structure, it compiles the provided pattern and stores
  * the result in the "re" element. It also copies the pattern into the
  * "pattern" element of the scratch pad and on subsequent calls will check
- * whether the pattern has changed and recompile if necessary.
+ * whether the pattern has changed and recompile if necessary (freeing the
+ * prior compilation).
  *
  * If the initialization is successful, the function returns zero.  If an error
  * occurs, the SQLSTATE and error message is set accordingly and the function
@@ -99,7 +108,7 @@ struct split_scratch_pad {
  * and the function returns a non-zero value. In the event of non-zero return
  * from this function, the caller should immediately return.
  */
-int pcre_udf_init_generic(
+static int pcre_udf_init_generic(
     SQLUDF_VARCHAR *pattern,
     SQLUDF_TRAIL_ARGS_ALL)
 {
@@ -111,11 +120,15 @@ int pcre_udf_init_generic(
         //case SQLUDF_TF_FETCH:
             // If this isn't the first call, check whether the provided pattern
             // matches the last one we compiled. If it's changed, then free the
-            // current copy of the pattern, and fall through to the first call
-            // case to compile the new pattern
+            // current copy of the pattern along with its compiled form, and
+            // fall through to the first call case to compile the new pattern
             if (strcmp(sp->pattern, pattern) == 0) break;
-            free(sp->pattern);
+            (*pcre_free)(sp->pattern);
             sp->pattern = NULL;
+            (*pcre_free)(sp->re);
+            sp->re = NULL;
+            (*pcre_free)(sp->extra);
+            sp->extra = NULL;
         case SQLUDF_FIRST_CALL:
         //case SQLUDF_TF_OPEN:
             // If the pattern's changed since the last call, or if this is the
@@ -128,17 +141,19 @@ int pcre_udf_init_generic(
                 snprintf(SQLUDF_MSGTX, SQLUDF_MSGTX_LEN, PCRE_MSGTX_MALLOC_ERROR);
                 strcpy(SQLUDF_STATE, PCRE_SQLSTATE_PREFIX PCRE_SQLSTATE_MALLOC_ERROR);
             }
-            strcpy(sp->pattern, pattern);
-            sp->re = pcre_compile(pattern, PCRE_UTF8, &sp->error, &sp->error_offset, NULL);
-            if (sp->re == NULL) {
-                snprintf(SQLUDF_MSGTX, SQLUDF_MSGTX_LEN, PCRE_MSGTX_COMPILE_ERROR, sp->error, sp->error_offset + 1);
-                strcpy(SQLUDF_STATE, PCRE_SQLSTATE_PREFIX PCRE_SQLSTATE_COMPILE_ERROR);
-            }
             else {
-                sp->extra = pcre_study(sp->re, 0, &sp->error);
-                if (sp->error == NULL) break;
-                snprintf(SQLUDF_MSGTX, SQLUDF_MSGTX_LEN, PCRE_MSGTX_STUDY_ERROR, sp->error);
-                strcpy(SQLUDF_STATE, PCRE_SQLSTATE_PREFIX PCRE_SQLSTATE_STUDY_ERROR);
+                strcpy(sp->pattern, pattern);
+                sp->re = pcre_compile(pattern, PCRE_UTF8, &sp->error, &sp->error_offset, NULL);
+                if (sp->re == NULL) {
+                    snprintf(SQLUDF_MSGTX, SQLUDF_MSGTX_LEN, PCRE_MSGTX_COMPILE_ERROR, sp->error, sp->error_offset + 1);
+                    strcpy(SQLUDF_STATE, PCRE_SQLSTATE_PREFIX PCRE_SQLSTATE_COMPILE_ERROR);
+                }
+                else {
+                    sp->extra = pcre_study(sp->re, 0, &sp->error);
+                    if (sp->error == NULL) break;
+                    snprintf(SQLUDF_MSGTX, SQLUDF_MSGTX_LEN, PCRE_MSGTX_STUDY_ERROR, sp->error);
+                    strcpy(SQLUDF_STATE, PCRE_SQLSTATE_PREFIX PCRE_SQLSTATE_STUDY_ERROR);
+                }
             }
         case SQLUDF_FINAL_CALL:
         //case SQLUDF_TF_CLOSE:
@@ -168,10 +183,14 @@ int pcre_udf_init_generic(
  * involving several PCRE functions).  The substring parameter indicates which
  * substring was requested (used in the case of the PCRE_ERROR_NOSUBSTRING
  * error - can be ignored otherwise).
+ *
+ * The message is formatted directly into the caller's message buffer (never
+ * via a shared or static buffer) so this routine is safe to call from several
+ * threads at once.
  */
-void pcre_udf_error(
+static void pcre_udf_error(
     int err_code,
-    char *source,
+    const char *source,
     int substring,
     SQLUDF_TRAIL_ARGS_ALL)
 {
@@ -537,10 +556,10 @@ pcre_udf_split(
             pcre_udf_init_generic(pattern, SQLUDF_TRAIL_ARGS_ALL_PASSTHRU);
             break;
         case SQLUDF_TF_FETCH:
-            element_ind = 0;
-            separator_ind = 0;
-            position_ind = 0;
-            content_ind = 0;
+            *element_ind = 0;
+            *separator_ind = 0;
+            *position_ind = 0;
+            *content_ind = 0;
             *element = sp->element + 1;
             *separator = sp->separator;
             if (sp->separator) {
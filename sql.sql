@@ -22,7 +22,9 @@
 -- IN THE SOFTWARE.
 -------------------------------------------------------------------------------
 -- The following functions are used fairly extensively in the other modules for
--- constructing SQL with SQL, including the appropriate escaping.
+-- constructing SQL with SQL, including the appropriate escaping. They are
+-- implemented in C (see the sql/ sub-directory) as they are called for every
+-- identifier and literal in generated SQL, often within large queries.
 -------------------------------------------------------------------------------
 
 
@@ -44,52 +46,22 @@ GRANT ROLE UTILS_SQL_ADMIN TO ROLE UTILS_ADMIN WITH ADMIN OPTION!
 -- Returns ASTRING surrounded by single quotes and performs any necessary
 -- escaping within the string to make it valid SQL. For example, single quotes
 -- within ASTRING are doubled, and control characters like CR or LF are
--- returned as concatenated hex-strings
+-- returned as concatenated hex-strings. ASTRING is treated as a sequence of
+-- bytes; any byte outside the printable ASCII range is hex-encoded
 -------------------------------------------------------------------------------
 
-CREATE FUNCTION QUOTE_STRING(ASTRING VARCHAR(4000))
+CREATE FUNCTION QUOTE_STRING(ASTRING VARCHAR(4000) FOR BIT DATA)
     RETURNS VARCHAR(4000)
     SPECIFIC QUOTE_STRING1
-    LANGUAGE SQL
+    EXTERNAL NAME 'sql_udfs!sql_udf_quote_string'
+    LANGUAGE C
+    PARAMETER STYLE SQL
     DETERMINISTIC
+    NOT FENCED
+    RETURNS NULL ON NULL INPUT
+    NO SQL
     NO EXTERNAL ACTION
-    CONTAINS SQL
-BEGIN ATOMIC
-    DECLARE I SMALLINT DEFAULT 1;
-    DECLARE RESULT VARCHAR(4000) DEFAULT '';
-    DECLARE IN_HEX CHAR(1);
-    IF ASTRING IS NULL THEN
-        RETURN NULL;
-    END IF;
-    SET IN_HEX = CASE
-        WHEN ASCII(SUBSTR(ASTRING, I, 1)) BETWEEN 32 AND 127 THEN 'N'
-        ELSE 'Y'
-    END;
-    SET RESULT = CASE IN_HEX
-        WHEN 'Y' THEN 'X'''
-        ELSE ''''
-    END;
-    WHILE I <= LENGTH(ASTRING) DO
-        IF ASCII(SUBSTR(ASTRING, I, 1)) BETWEEN 32 AND 127 THEN
-            IF IN_HEX = 'Y' THEN
-                SET RESULT = RESULT || ''' || ''';
-                SET IN_HEX = 'N';
-            END IF;
-        ELSE
-            IF IN_HEX = 'N' THEN
-                SET RESULT = RESULT || ''' || X''';
-                SET IN_HEX = 'Y';
-            END IF;
-        END IF;
-        SET RESULT = RESULT ||
-            CASE IN_HEX
-                WHEN 'Y' THEN HEX(SUBSTR(ASTRING, I, 1))
-                ELSE REPLACE(SUBSTR(ASTRING, I, 1), '''', '''''')
-            END;
-        SET I = I + 1;
-    END WHILE;
-    RETURN RESULT || '''';
-END!
+    ALLOW PARALLEL!
 
 GRANT EXECUTE ON SPECIFIC FUNCTION QUOTE_STRING1 TO ROLE UTILS_SQL_USER!
 GRANT EXECUTE ON SPECIFIC FUNCTION QUOTE_STRING1 TO ROLE UTILS_SQL_ADMIN WITH GRANT OPTION!
@@ -110,26 +82,15 @@ COMMENT ON SPECIFIC FUNCTION QUOTE_STRING1
 CREATE FUNCTION QUOTE_IDENTIFIER(AIDENT VARCHAR(128))
     RETURNS VARCHAR(258)
     SPECIFIC QUOTE_IDENTIFIER1
-    LANGUAGE SQL
+    EXTERNAL NAME 'sql_udfs!sql_udf_quote_identifier'
+    LANGUAGE C
+    PARAMETER STYLE SQL
     DETERMINISTIC
+    NOT FENCED
+    RETURNS NULL ON NULL INPUT
+    NO SQL
     NO EXTERNAL ACTION
-    CONTAINS SQL
-RETURN
-    CASE
-        WHEN AIDENT IS NULL THEN NULL
-        WHEN
-            TRANSLATE(SUBSTR(AIDENT, 1, 1),
-                'XXXXXXXXXXXXXXXXXXXXXXXXXXXXX',
-                'ABCDEFGHIJKLMNOPQRSTUVWXYZ#$@') ||
-            TRANSLATE(SUBSTR(AIDENT, 2),
-                'XXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXX',
-                'ABCDEFGHIJKLMNOPQRSTUVWXYZ#$@_0123456789') =
-            REPEAT('X', LENGTH(RTRIM(AIDENT)))
-        THEN
-            RTRIM(AIDENT)
-        ELSE
-            '"' || REPLACE(RTRIM(AIDENT), '"', '""') || '"'
-    END!
+    ALLOW PARALLEL!
 
 GRANT EXECUTE ON SPECIFIC FUNCTION QUOTE_IDENTIFIER1 TO ROLE UTILS_SQL_USER!
 GRANT EXECUTE ON SPECIFIC FUNCTION QUOTE_IDENTIFIER1 TO ROLE UTILS_SQL_ADMIN WITH GRANT OPTION!
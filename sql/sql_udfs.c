@@ -0,0 +1,290 @@
+/**
+ * SQL quoting UDFs for IBM DB2 for Linux
+ *
+ * Copyright (c) 2015 Dave Hughes <dave@waveform.org.uk>
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * Use the provided Makefile to build and install this library, and to register
+ * the contained functions with the database (see also sql.sql). The quoting
+ * functions classify their input eight bytes at a time using the portable
+ * "word-at-a-time" techniques described at:
+ *
+ * <https://graphics.stanford.edu/~seander/bithacks.html#ZeroInWord>
+ *
+ */
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <sqludf.h>
+#include <sqlsystm.h>
+#include <sqlstate.h>
+
+#include "sql_udfs.h"
+
+// Macros for passing thru TRAIL_ARGS[_ALL] to another function
+#define SQLUDF_TRAIL_ARGS_PASSTHRU sqludf_sqlstate, \
+    sqludf_fname, \
+    sqludf_fspecname, \
+    sqludf_msgtext
+#define SQLUDF_TRAIL_ARGS_ALL_PASSTHRU sqludf_sqlstate, \
+    sqludf_fname, \
+    sqludf_fspecname, \
+    sqludf_msgtext, \
+    sqludf_scratchpad, \
+    sqludf_call_type
+
+static const char hex_digits[] = "0123456789ABCDEF";
+
+/**
+ * This is a utility routine used by the other routines in the unit to handle
+ * reporting errors. Note that *any* code passed as err_code to this function
+ * will be treated as an error (even positive codes which are, by definition,
+ * not errors). In other words, don't pass something unless you really mean it
+ * as an error.
+ *
+ * The source parameter specifies a short human-readable name for the caller to
+ * include in the error message (which may aid users in debugging statements
+ * involving several functions).
+ */
+static void sql_udf_error(
+    int err_code,
+    const char *source,
+    SQLUDF_TRAIL_ARGS)
+{
+    switch (err_code) {
+        case SQL_TRUNC_ERROR:
+            snprintf(SQLUDF_MSGTX, SQLUDF_MSGTX_LEN, "%s error: %s", source, SQL_TRUNC_MSG);
+            break;
+        default:
+            snprintf(SQLUDF_MSGTX, SQLUDF_MSGTX_LEN, "%s error: unknown error (%d)", source, err_code);
+            break;
+    }
+    snprintf(SQLUDF_STATE, SQLUDF_SQLSTATE_LEN + 1, SQL_SQLSTATE_PREFIX "%02d", err_code);
+
+    return;
+}
+
+/**
+ * Returns non-zero if the byte c may appear verbatim within a quoted string
+ * literal produced by QUOTE_STRING (the apostrophe is included, although it
+ * must be doubled). All other bytes are emitted as hex-string literals.
+ */
+static inline int
+sql_is_literal(unsigned char c)
+{
+    return c >= 0x20 && c < 0x80;
+}
+
+/**
+ * Returns non-zero if all eight bytes packed into w may be copied verbatim
+ * into a quoted string literal. That is, none of the bytes are less than 0x20
+ * (control characters), none have the high bit set (which covers 0x80 and
+ * above), and none are apostrophes. As the three tests only determine whether
+ * *any* byte matches, the byte order of w is irrelevant.
+ */
+static inline int
+sql_is_plain_word(uint64_t w)
+{
+    uint64_t q = w ^ SQL_QUOTES;
+
+    return !(
+        ((w - SQL_SPACES) & ~w & SQL_HIGHS) |
+        (w & SQL_HIGHS) |
+        ((q - SQL_ONES) & ~q & SQL_HIGHS));
+}
+
+/**
+ * Returns non-zero if the byte c may start an unquoted identifier.
+ */
+static inline int
+sql_is_ident_start(unsigned char c)
+{
+    return (c >= 'A' && c <= 'Z') || c == '#' || c == '$' || c == '@';
+}
+
+/**
+ * Returns non-zero if the byte c may appear after the start of an unquoted
+ * identifier.
+ */
+static inline int
+sql_is_ident_char(unsigned char c)
+{
+    return sql_is_ident_start(c) || (c >= '0' && c <= '9') || c == '_';
+}
+
+// A little macro for checking for overflow before copying to result
+#define CHECK_AND_COPY(S, N, SOURCE) \
+        if ((r + (N)) > result_end) { \
+            sql_udf_error(SQL_TRUNC_ERROR, (SOURCE), SQLUDF_TRAIL_ARGS_PASSTHRU); \
+            return; \
+        } \
+        memcpy(r, (S), (N)); \
+        r += (N);
+
+/**
+ * This is the implementation for the QUOTE_STRING function. See the sql.sql
+ * script for a full description of this function's purpose and parameters.
+ *
+ * The source is scanned a word at a time; words consisting entirely of
+ * printable ASCII characters other than the apostrophe are copied straight to
+ * the result while in a literal run. Any other word is handled a byte at a
+ * time, switching between literal and hex-string runs as required. Hence the
+ * result is produced in a single linear pass over the source.
+ */
+SQL_API_RC SQL_API_FN
+sql_udf_quote_string(
+    // input parameters
+    SQLUDF_VARCHAR_FBD *source,
+    // output parameters
+    SQLUDF_VARCHAR *result,
+    // null indicators
+    SQLUDF_NULLIND *source_ind,
+    SQLUDF_NULLIND *result_ind,
+    SQLUDF_TRAIL_ARGS)
+{
+    const unsigned char *s; // current position in source
+    const unsigned char *source_end;
+    char *r = result; // current position in result
+    char *result_end = result + SQL_QUOTE_STRING_LEN;
+    char hex[2];
+    uint64_t w;
+    int in_hex, n;
+
+    // Return NULL on NULL input
+    if (*source_ind == -1) {
+        *result_ind = -1;
+        return;
+    }
+    s = (const unsigned char *)source->data;
+    source_end = s + source->length;
+
+    // The initial run is a hex-string if the first byte isn't printable (or
+    // if the source is empty, in which case the result is X'')
+    in_hex = (s == source_end) || !sql_is_literal(*s);
+    if (in_hex) {
+        CHECK_AND_COPY("X'", 2, "quote_string");
+    }
+    else {
+        CHECK_AND_COPY("'", 1, "quote_string");
+    }
+    while (s < source_end) {
+        n = (source_end - s < 8) ? (int)(source_end - s) : 8;
+        if (!in_hex && n == 8) {
+            memcpy(&w, s, sizeof(w));
+            if (sql_is_plain_word(w)) {
+                CHECK_AND_COPY(s, 8, "quote_string");
+                s += 8;
+                continue;
+            }
+        }
+        for (; n; --n, ++s) {
+            if (sql_is_literal(*s)) {
+                if (in_hex) {
+                    CHECK_AND_COPY("' || '", 6, "quote_string");
+                    in_hex = 0;
+                }
+                if (*s == '\'') {
+                    CHECK_AND_COPY("''", 2, "quote_string");
+                }
+                else {
+                    CHECK_AND_COPY(s, 1, "quote_string");
+                }
+            }
+            else {
+                if (!in_hex) {
+                    CHECK_AND_COPY("' || X'", 7, "quote_string");
+                    in_hex = 1;
+                }
+                hex[0] = hex_digits[*s >> 4];
+                hex[1] = hex_digits[*s & 0x0F];
+                CHECK_AND_COPY(hex, 2, "quote_string");
+            }
+        }
+    }
+    CHECK_AND_COPY("'", 1, "quote_string");
+    *r = '\0';
+    *result_ind = 0;
+
+    return;
+}
+
+/**
+ * This is the implementation for the QUOTE_IDENTIFIER function. See the
+ * sql.sql script for a full description of this function's purpose and
+ * parameters. As in the SQL dialect, trailing blanks are not significant and
+ * are removed from the result.
+ */
+SQL_API_RC SQL_API_FN
+sql_udf_quote_identifier(
+    // input parameters
+    SQLUDF_VARCHAR *source,
+    // output parameters
+    SQLUDF_VARCHAR *result,
+    // null indicators
+    SQLUDF_NULLIND *source_ind,
+    SQLUDF_NULLIND *result_ind,
+    SQLUDF_TRAIL_ARGS)
+{
+    const unsigned char *s; // current position in source
+    const unsigned char *source_end;
+    const unsigned char *c; // start of the current run in source
+    char *r = result; // current position in result
+    char *result_end = result + SQL_QUOTE_IDENTIFIER_LEN;
+
+    // Return NULL on NULL input
+    if (*source_ind == -1) {
+        *result_ind = -1;
+        return;
+    }
+    s = (const unsigned char *)source;
+    source_end = s + strlen(source);
+
+    // Strip trailing blanks, then determine whether quoting is required
+    while (source_end > s && source_end[-1] == ' ')
+        --source_end;
+    if (s < source_end && sql_is_ident_start(*s))
+        for (c = s + 1; c < source_end && sql_is_ident_char(*c); ++c);
+    else
+        c = s;
+    if (c == source_end) {
+        CHECK_AND_COPY(s, source_end - s, "quote_identifier");
+    }
+    else {
+        // Copy the identifier between double-quotes, doubling any embedded
+        // double-quotes
+        CHECK_AND_COPY("\"", 1, "quote_identifier");
+        for (c = s; s < source_end; ++s) {
+            if (*s == '"') {
+                CHECK_AND_COPY(c, s - c + 1, "quote_identifier");
+                c = s;
+            }
+        }
+        CHECK_AND_COPY(c, s - c, "quote_identifier");
+        CHECK_AND_COPY("\"", 1, "quote_identifier");
+    }
+    *r = '\0';
+    *result_ind = 0;
+
+    return;
+}
+
+/* vim: set et sw=4 sts=4: */
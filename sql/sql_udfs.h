@@ -0,0 +1,57 @@
+/**
+ * SQL quoting UDFs for IBM DB2 for Linux
+ *
+ * Copyright (c) 2015 Dave Hughes <dave@waveform.org.uk>
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ *
+ * Use the provided Makefile to build and install this library, and to register
+ * the contained functions with the database (see also sql.sql).
+ */
+
+// This is the prefix for any SQLSTATEs used to indicate an error in this
+// library. The first two characters must be "38", the third character may not
+// be "0" through "5" (these are reserved by DB2)
+#define SQL_SQLSTATE_PREFIX "388"
+
+// These are the suffixes for SQLSTATEs and the corresponding error messages
+// used to indicate an error in this library
+#define SQL_TRUNC_ERROR                1
+
+#define SQL_TRUNC_MSG                  "out of space in result string"
+
+// Maximum length of the result of QUOTE_STRING and QUOTE_IDENTIFIER. Must
+// match the function definitions in sql.sql
+#define SQL_QUOTE_STRING_LEN (4000)
+#define SQL_QUOTE_IDENTIFIER_LEN (258)
+
+// Constants for the word-at-a-time byte classifier. SQL_ONES has the low bit
+// of every byte set and SQL_HIGHS has the high bit of every byte set; the
+// other two are the bytes which QUOTE_STRING must treat specially
+#define SQL_ONES   0x0101010101010101ULL
+#define SQL_HIGHS  0x8080808080808080ULL
+#define SQL_SPACES (SQL_ONES * 0x20)
+#define SQL_QUOTES (SQL_ONES * 0x27)
+
+// The maximum length of the buffer provided for error messages. Do not alter
+// this value
+#define SQLUDF_MSGTX_LEN (70)
+
+/* vim: set et sw=4 sts=4: */
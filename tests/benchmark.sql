@@ -0,0 +1,64 @@
+-- Benchmarks of the more expensive functions and procedures in the package,
+-- run against generated data. This script is not part of the test suite (it
+-- takes a while, and its results are committed rather than rolled back); run
+-- it with "make benchmark" against each release to be compared, then compare
+-- the results in BENCHMARK_RESULTS by NAME, e.g.:
+--
+--   SELECT NAME, STARTED, ELAPSED / ITERATIONS AS AVERAGE, CPU_TIME
+--   FROM BENCHMARK_RESULTS
+--   ORDER BY NAME, STARTED
+
+CREATE TABLE BENCH_TEXT (
+    ID INTEGER NOT NULL,
+    TEXT VARCHAR(200) NOT NULL
+)!
+ALTER TABLE BENCH_TEXT ADD CONSTRAINT PK PRIMARY KEY (ID)!
+
+INSERT INTO BENCH_TEXT
+    WITH N (ID) AS (
+        VALUES 1
+        UNION ALL
+        SELECT ID + 1 FROM N WHERE ID < 10000
+    )
+    SELECT
+        ID,
+        'Row ' || VARCHAR(ID) || ': foo' || VARCHAR(MOD(ID, 97))
+        || '@example.com, ' || U&'caf\00e9 na\00efve r\00e9sum\00e9'
+    FROM N!
+
+CALL BENCHMARK('PCRE_SEARCH',
+    'SELECT ID FROM BENCH_TEXT WHERE PCRE_SEARCH(''foo([0-9]+)@'', TEXT) > 0', 5)!
+CALL BENCHMARK('PCRE_SUB',
+    'SELECT ID FROM BENCH_TEXT WHERE PCRE_SUB(''([a-z]+)@'', ''\1 at '', TEXT) <> TEXT', 5)!
+CALL BENCHMARK('PCRE_GROUPS',
+    'SELECT T.ID FROM BENCH_TEXT T, TABLE(PCRE_GROUPS(''foo([0-9]+)@([a-z.]+)'', T.TEXT)) AS G', 5)!
+CALL BENCHMARK('PCRE_SPLIT',
+    'SELECT T.ID FROM BENCH_TEXT T, TABLE(PCRE_SPLIT(''[ ,:]+'', T.TEXT)) AS S', 5)!
+CALL BENCHMARK('UNICODE_REPLACE_BAD',
+    'SELECT ID FROM BENCH_TEXT WHERE UNICODE_REPLACE_BAD(TEXT) = TEXT', 5)!
+CALL BENCHMARK('DATE_RANGE',
+    'SELECT D FROM TABLE(DATE_RANGE(DATE(''1900-01-01''), DATE(''2099-12-31''))) AS T', 5)!
+CALL BENCHMARK('WORKINGDAY',
+    'SELECT ID FROM BENCH_TEXT WHERE WORKINGDAY(DATE(''2000-01-01'') + ID DAYS) > 0', 5)!
+
+CREATE TABLE BENCH_SOURCE (
+    ID INTEGER NOT NULL,
+    VALUE VARCHAR(200) NOT NULL
+)!
+CREATE TABLE BENCH_DEST LIKE BENCH_SOURCE!
+ALTER TABLE BENCH_DEST ADD CONSTRAINT PK PRIMARY KEY (ID)!
+INSERT INTO BENCH_SOURCE SELECT ID, TEXT FROM BENCH_TEXT!
+
+CALL BENCHMARK('AUTO_MERGE inserts',
+    'CALL AUTO_MERGE(''BENCH_SOURCE'', ''BENCH_DEST'')', 1)!
+UPDATE BENCH_SOURCE SET VALUE = UPPER(VALUE) WHERE MOD(ID, 10) = 0!
+CALL BENCHMARK('AUTO_MERGE updates',
+    'CALL AUTO_MERGE(''BENCH_SOURCE'', ''BENCH_DEST'')', 1)!
+CALL BENCHMARK('AUTO_MERGE unchanged',
+    'CALL AUTO_MERGE(''BENCH_SOURCE'', ''BENCH_DEST'')', 5)!
+
+DROP TABLE BENCH_DEST!
+DROP TABLE BENCH_SOURCE!
+DROP TABLE BENCH_TEXT!
+
+-- vim: set et sw=4 sts=4:
@@ -0,0 +1,16 @@
+-- Summarizes the results of "make concurrency". For each function, number of
+-- sessions, and mode, reports the number of sessions which completed, the
+-- combined throughput of all sessions (in executions of the benchmark query
+-- per second, assuming the sessions ran concurrently), the average time of a
+-- single execution, and the slowest execution in any session.
+
+SELECT
+    LEFT(NAME, LOCATE(' #', NAME) - 1) AS BENCHMARK,
+    COUNT(*) AS SESSIONS,
+    DEC(SUM(ITERATIONS) / NULLIF(MAX(ELAPSED), 0), 12, 3) AS PER_SECOND,
+    DEC(AVG(ELAPSED / ITERATIONS), 12, 6) AS AVERAGE,
+    MAX(MAX_ELAPSED) AS SLOWEST
+FROM BENCHMARK_RESULTS
+WHERE NAME LIKE 'CONCURRENT %'
+GROUP BY LEFT(NAME, LOCATE(' #', NAME) - 1)
+ORDER BY BENCHMARK!
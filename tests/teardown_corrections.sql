@@ -0,0 +1,5 @@
+CALL DROP_SCHEMA('QUUX')!
+DELETE FROM CREATED_CORRECTION_TRIGGERS WHERE TABSCHEMA = 'QUUX'!
+DELETE FROM LOG WHERE SUBJECT_SCHEMA = 'QUUX'!
+
+-- vim: set et sw=4 sts=4:
@@ -0,0 +1,4 @@
+CALL DROP_SCHEMA('QUUX')!
+DELETE FROM CREATED_EXCEPTION_OBJECTS WHERE TABSCHEMA = 'QUUX'!
+
+-- vim: set et sw=4 sts=4:
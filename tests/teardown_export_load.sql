@@ -0,0 +1,4 @@
+CALL DROP_SCHEMA('QUUX')!
+DELETE FROM EXPORT_LOAD_JOBS WHERE TABSCHEMA = 'QUUX'!
+
+-- vim: set et sw=4 sts=4:
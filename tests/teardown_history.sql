@@ -0,0 +1,5 @@
+DROP TABLE FOO_HISTORY_MINVALUE!
+DROP TABLE FOO_HISTORY!
+DROP TABLE FOO!
+
+-- vim: set et sw=4 sts=4:
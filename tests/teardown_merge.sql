@@ -0,0 +1,5 @@
+DROP TABLE FOO!
+DROP TABLE BAR!
+DELETE FROM MERGE_PROGRESS WHERE TABNAME = 'BAR'!
+
+-- vim: set et sw=4 sts=4:
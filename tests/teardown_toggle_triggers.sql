@@ -0,0 +1,5 @@
+CALL DROP_SCHEMA('QUUX')!
+DELETE FROM DISABLED_TRIGGERS WHERE TABSCHEMA = 'QUUX'!
+DELETE FROM TOGGLED_TRIGGERS WHERE TABSCHEMA = 'QUUX'!
+
+-- vim: set et sw=4 sts=4:
@@ -125,6 +125,26 @@ CALL ASSERT_ROUTINE_EXISTS('FOO_INSERT')!
 CALL ASSERT_ROUTINE_EXISTS(CURRENT SCHEMA, 'FOO_INSERT')!
 CALL ASSERT_SIGNALS(ASSERT_FAILED_STATE, 'CALL ASSERT_ROUTINE_EXISTS(''BAR'')')!
 
+CALL ASSERT_RUNS_WITHIN('VALUES 1', 60000)!
+CALL ASSERT_RUNS_WITHIN('  select *' || CHR(9) || 'FROM SYSIBM.SYSDUMMY1', 60000)!
+CALL ASSERT_RUNS_WITHIN('WITH T (N) AS (VALUES 1, 2) SELECT N FROM T', 60000)!
+CALL ASSERT_RUNS_WITHIN('DELETE FROM FOO WHERE I < 0', 60000)!
+CALL ASSERT_SIGNALS(ASSERT_FAILED_STATE, 'CALL ASSERT_RUNS_WITHIN(''VALUES 1'', -1)')!
+
+CALL BENCHMARK('TEST_ASSERT', 'SELECT * FROM SYSIBM.SYSDUMMY1', 3)!
+VALUES ASSERT_EQUALS((
+    SELECT ROW_COUNT
+    FROM BENCHMARK_RESULTS
+    WHERE NAME = 'TEST_ASSERT'
+    AND ITERATIONS = 3
+    AND MIN_ELAPSED <= MAX_ELAPSED), 1)!
+CALL BENCHMARK('TEST_ASSERT_WITH', 'WITH T (N) AS (VALUES 1, 2) SELECT N FROM T', 1)!
+VALUES ASSERT_EQUALS((
+    SELECT INTEGER(ROW_COUNT)
+    FROM BENCHMARK_RESULTS
+    WHERE NAME = 'TEST_ASSERT_WITH'), 2)!
+CALL ASSERT_SIGNALS(BENCHMARK_ITERATIONS_STATE, 'CALL BENCHMARK(''VALUES 1'', 0)')!
+
 DROP TABLE FOO!
 DROP SPECIFIC PROCEDURE TEST_VALUES!
 DROP SPECIFIC PROCEDURE TEST_ASSERT!
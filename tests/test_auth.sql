@@ -103,6 +103,59 @@ VALUES ASSERT_EQUALS((
     WHERE OBJECT_ID = QUOTE_IDENTIFIER(CURRENT SCHEMA) || '.FOO'
     AND AUTH = 'CONTROL'), 1)!
 
+-- Check that REFRESH_AUTH_CACHE picks up a grant, and the role closure of a
+-- user holding a role granted to another role, and that AUTHS_HELD reads from
+-- the cache when USE_AUTH_CACHE is set
+CALL REMOVE_AUTH('BAZ')!
+CREATE ROLE FOO_READER!
+CREATE ROLE FOO_USER!
+GRANT SELECT ON TABLE FOO TO ROLE FOO_READER!
+GRANT ROLE FOO_READER TO ROLE FOO_USER!
+GRANT ROLE FOO_USER TO USER BAR!
+CALL REFRESH_AUTH_CACHE()!
+
+VALUES ASSERT_EQUALS((
+    SELECT DEPTH
+    FROM AUTH_CACHE_ROLES
+    WHERE GRANTEE = 'BAR'
+    AND GRANTEETYPE = 'U'
+    AND ROLENAME = 'FOO_READER'), 2)!
+
+VALUES ASSERT_EQUALS((
+    SELECT COUNT(*)
+    FROM EFFECTIVE_AUTHS
+    WHERE GRANTEE = 'BAR'
+    AND OBJECT_ID = QUOTE_IDENTIFIER(CURRENT SCHEMA) || '.FOO'
+    AND AUTH = 'SELECT'), 1)!
+
+GRANT SELECT ON TABLE FOO TO USER BAZ!
+CALL REFRESH_AUTH_CACHE()!
+SET USE_AUTH_CACHE = 'Y'!
+
+VALUES ASSERT_EQUALS((
+    SELECT COUNT(*)
+    FROM TABLE(AUTHS_HELD('BAZ')) AS T
+    WHERE OBJECT_ID = QUOTE_IDENTIFIER(CURRENT SCHEMA) || '.FOO'), 1)!
+
+REVOKE SELECT ON TABLE FOO FROM USER BAZ!
+
+VALUES ASSERT_EQUALS((
+    SELECT COUNT(*)
+    FROM TABLE(AUTHS_HELD('BAZ')) AS T
+    WHERE OBJECT_ID = QUOTE_IDENTIFIER(CURRENT SCHEMA) || '.FOO'), 1)!
+
+CALL REFRESH_AUTH_CACHE()!
+
+VALUES ASSERT_EQUALS((
+    SELECT COUNT(*)
+    FROM TABLE(AUTHS_HELD('BAZ')) AS T
+    WHERE OBJECT_ID = QUOTE_IDENTIFIER(CURRENT SCHEMA) || '.FOO'), 0)!
+
+SET USE_AUTH_CACHE = 'N'!
+DROP ROLE FOO_USER!
+DROP ROLE FOO_READER!
+CALL REFRESH_AUTH_CACHE('Y')!
+
 DROP TABLE FOO!
 
 -- vim: set et sw=4 sts=4:
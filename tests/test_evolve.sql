@@ -0,0 +1,124 @@
+-- Check that RESTORE_VIEWS restores views in order of their dependencies,
+-- rather than the order of their names
+CREATE TABLE FOO (I INTEGER NOT NULL)!
+CREATE VIEW FOO_C AS SELECT I FROM FOO!
+CREATE VIEW FOO_B AS SELECT I FROM FOO_C!
+CREATE VIEW FOO_A AS SELECT I FROM FOO_B!
+
+CALL SAVE_VIEW('FOO_A')!
+CALL SAVE_VIEW('FOO_B')!
+CALL SAVE_VIEW('FOO_C')!
+
+VALUES ASSERT_EQUALS((
+    SELECT COUNT(*)
+    FROM SAVED_VIEWDEP
+    WHERE VIEWSCHEMA = CURRENT SCHEMA
+    AND VIEWNAME IN ('FOO_A', 'FOO_B', 'FOO_C')), 2)!
+
+DROP VIEW FOO_A!
+DROP VIEW FOO_B!
+DROP VIEW FOO_C!
+CALL RESTORE_VIEWS!
+
+VALUES ASSERT_EQUALS((
+    SELECT COUNT(*)
+    FROM SYSCAT.VIEWS
+    WHERE VIEWSCHEMA = CURRENT SCHEMA
+    AND VIEWNAME IN ('FOO_A', 'FOO_B', 'FOO_C')
+    AND VALID = 'Y'), 3)!
+
+VALUES ASSERT_EQUALS((
+    SELECT COUNT(*)
+    FROM SAVED_VIEWS
+    WHERE VIEWSCHEMA = CURRENT SCHEMA), 0)!
+
+DROP VIEW FOO_A!
+DROP VIEW FOO_B!
+DROP VIEW FOO_C!
+DROP TABLE FOO!
+
+-- Check that RESTORE_VIEWS replaces saved views which have been left
+-- inoperative, rather than skipping them because they still exist, and that
+-- it keeps the saved definitions of views it didn't need to restore
+CREATE TABLE FOO (I INTEGER NOT NULL)!
+CREATE VIEW FOO_B AS SELECT I FROM FOO!
+CREATE VIEW FOO_A AS SELECT I FROM FOO_B!
+CREATE VIEW FOO_E AS SELECT 1 AS I FROM SYSIBM.SYSDUMMY1!
+
+CALL SAVE_VIEW('FOO_A')!
+CALL SAVE_VIEW('FOO_B')!
+CALL SAVE_VIEW('FOO_E')!
+
+DROP TABLE FOO!
+VALUES ASSERT_EQUALS((
+    SELECT COUNT(*)
+    FROM SYSCAT.VIEWS
+    WHERE VIEWSCHEMA = CURRENT SCHEMA
+    AND VIEWNAME IN ('FOO_A', 'FOO_B')
+    AND VALID = 'X'), 2)!
+
+CREATE TABLE FOO (I INTEGER NOT NULL)!
+CALL RESTORE_VIEWS!
+
+VALUES ASSERT_EQUALS((
+    SELECT COUNT(*)
+    FROM SYSCAT.VIEWS
+    WHERE VIEWSCHEMA = CURRENT SCHEMA
+    AND VIEWNAME IN ('FOO_A', 'FOO_B', 'FOO_E')
+    AND VALID = 'Y'), 3)!
+
+VALUES ASSERT_EQUALS((
+    SELECT COUNT(*)
+    FROM SAVED_VIEWS
+    WHERE VIEWSCHEMA = CURRENT SCHEMA
+    AND VIEWNAME IN ('FOO_A', 'FOO_B')), 0)!
+
+VALUES ASSERT_EQUALS((
+    SELECT COUNT(*)
+    FROM SAVED_VIEWS
+    WHERE VIEWSCHEMA = CURRENT SCHEMA
+    AND VIEWNAME = 'FOO_E'), 1)!
+
+DELETE FROM SAVED_VIEWS WHERE VIEWSCHEMA = CURRENT SCHEMA AND VIEWNAME = 'FOO_E'!
+DELETE FROM SAVED_VIEWDEP WHERE VIEWSCHEMA = CURRENT SCHEMA AND VIEWNAME = 'FOO_E'!
+DROP VIEW FOO_E!
+DROP VIEW FOO_A!
+DROP VIEW FOO_B!
+DROP TABLE FOO!
+
+-- Check that RECREATE_VIEWS recreates views in order of their dependencies
+-- rather than their creation order. Replacing FOO_C after the others were
+-- created makes it the newest view, though the others depend upon it, and
+-- FOO_D depends on FOO_C both directly and via FOO_B and FOO_A
+CREATE TABLE FOO (I INTEGER NOT NULL)!
+CREATE VIEW FOO_C AS SELECT I FROM FOO!
+CREATE VIEW FOO_B AS SELECT I FROM FOO_C!
+CREATE VIEW FOO_A AS SELECT I FROM FOO_B!
+CREATE VIEW FOO_D AS SELECT A.I FROM FOO_A A, FOO_C C WHERE A.I = C.I!
+CREATE OR REPLACE VIEW FOO_C AS SELECT I FROM FOO!
+
+DROP TABLE FOO!
+VALUES ASSERT_EQUALS((
+    SELECT COUNT(*)
+    FROM SYSCAT.VIEWS
+    WHERE VIEWSCHEMA = CURRENT SCHEMA
+    AND VIEWNAME IN ('FOO_A', 'FOO_B', 'FOO_C', 'FOO_D')
+    AND VALID = 'X'), 4)!
+
+CREATE TABLE FOO (I INTEGER NOT NULL)!
+CALL RECREATE_VIEWS!
+
+VALUES ASSERT_EQUALS((
+    SELECT COUNT(*)
+    FROM SYSCAT.VIEWS
+    WHERE VIEWSCHEMA = CURRENT SCHEMA
+    AND VIEWNAME IN ('FOO_A', 'FOO_B', 'FOO_C', 'FOO_D')
+    AND VALID = 'Y'), 4)!
+
+DROP VIEW FOO_D!
+DROP VIEW FOO_A!
+DROP VIEW FOO_B!
+DROP VIEW FOO_C!
+DROP TABLE FOO!
+
+-- vim: set et sw=4 sts=4:
@@ -0,0 +1,111 @@
+CALL ASSERT_SIGNALS(LOAD_INCREMENTAL_STATE, 'CALL RUN_EXPORT_SCHEMA(CURRENT SCHEMA, ''/tmp'', ''Y'', ''Y'', ''X'')')!
+
+-- Check that EXPORT_SCHEMA_CHANGES only includes tables which have changed
+-- since they were marked as exported
+CREATE TABLE FOO (I INTEGER NOT NULL, J VARCHAR(10))!
+INSERT INTO FOO VALUES (1, 'A'), (2, 'B')!
+
+CALL REFRESH_EXPORT_MANIFEST!
+VALUES ASSERT_EQUALS((
+    SELECT ROW_COUNT
+    FROM EXPORT_MANIFEST
+    WHERE TABSCHEMA = CURRENT SCHEMA
+    AND TABNAME = 'FOO'), 2)!
+VALUES ASSERT_EQUALS((
+    SELECT COUNT(*)
+    FROM TABLE(EXPORT_SCHEMA_CHANGES()) AS T
+    WHERE TABNAME = 'FOO'), 1)!
+
+CALL MARK_EXPORTED('FOO')!
+VALUES ASSERT_EQUALS((
+    SELECT COUNT(*)
+    FROM TABLE(EXPORT_SCHEMA_CHANGES()) AS T
+    WHERE TABNAME = 'FOO'), 0)!
+
+-- An update which doesn't change the row count must still be detected by
+-- the checksum
+UPDATE FOO SET J = 'C' WHERE I = 2!
+CALL REFRESH_EXPORT_MANIFEST!
+VALUES ASSERT_EQUALS((
+    SELECT COUNT(*)
+    FROM TABLE(EXPORT_SCHEMA_CHANGES()) AS T
+    WHERE TABNAME = 'FOO'), 1)!
+
+-- An empty table must be hashed (to zero) so that it isn't exported again
+-- and again
+DELETE FROM FOO!
+CALL REFRESH_EXPORT_MANIFEST!
+CALL MARK_EXPORTED('FOO')!
+CALL REFRESH_EXPORT_MANIFEST!
+VALUES ASSERT_EQUALS((
+    SELECT COUNT(*)
+    FROM TABLE(EXPORT_SCHEMA_CHANGES()) AS T
+    WHERE TABNAME = 'FOO'), 0)!
+
+DROP TABLE FOO!
+CALL REFRESH_EXPORT_MANIFEST!
+VALUES ASSERT_EQUALS((
+    SELECT COUNT(*)
+    FROM EXPORT_MANIFEST
+    WHERE TABSCHEMA = CURRENT SCHEMA
+    AND TABNAME = 'FOO'), 0)!
+
+-- Check that the delta of a history table includes rows updated and deleted
+-- within the same period as the last change recorded at its last export;
+-- such rows expire at the end of the prior period, hence before that change
+CREATE TABLE BAR (ID INTEGER NOT NULL PRIMARY KEY, VALUE INTEGER NOT NULL)!
+CALL CREATE_HISTORY_TABLE('BAR', 'DAY')!
+CALL CREATE_HISTORY_TRIGGERS('BAR', 'DAY')!
+INSERT INTO BAR VALUES (1, 1), (2, 2), (3, 3)!
+UPDATE BAR_HISTORY SET EFFECTIVE_DAY = CURRENT DATE - 5 DAYS WHERE ID IN (1, 2)!
+
+CALL REFRESH_EXPORT_MANIFEST!
+CALL MARK_EXPORTED('BAR_HISTORY')!
+VALUES ASSERT_EQUALS((
+    SELECT EXPORTED_CHANGED
+    FROM EXPORT_MANIFEST
+    WHERE TABSCHEMA = CURRENT SCHEMA
+    AND TABNAME = 'BAR_HISTORY'), TIMESTAMP(CURRENT DATE, '00:00:00'))!
+
+UPDATE BAR SET VALUE = 10 WHERE ID = 1!
+DELETE FROM BAR WHERE ID = 2!
+CALL REFRESH_EXPORT_MANIFEST!
+VALUES ASSERT_EQUALS((
+    SELECT COUNT(*)
+    FROM TABLE(EXPORT_SCHEMA_CHANGES(CURRENT SCHEMA, 'Y', 'Y', 'Y')) AS T
+    WHERE TABNAME = 'BAR_HISTORY'
+    AND SQL LIKE '%.DELTA.IXF%'), 1)!
+
+CREATE PROCEDURE TEST_EXPORT_DELTA(ATABLE VARCHAR(128))
+    SPECIFIC TEST_EXPORT_DELTA
+    MODIFIES SQL DATA
+    LANGUAGE SQL
+BEGIN ATOMIC
+    DECLARE SINCE TIMESTAMP;
+    SET SINCE = (
+        SELECT EXPORTED_CHANGED
+        FROM EXPORT_MANIFEST
+        WHERE TABSCHEMA = CURRENT SCHEMA
+        AND TABNAME = ATABLE);
+    EXECUTE IMMEDIATE
+        'CREATE VIEW ' || QUOTE_IDENTIFIER(ATABLE || '_DELTA') || ' AS '
+        || 'SELECT * FROM ' || QUOTE_IDENTIFIER(ATABLE) || ' '
+        || 'WHERE ' || X_EXPORT_SINCE(CURRENT SCHEMA, ATABLE, SINCE);
+END!
+
+CALL TEST_EXPORT_DELTA('BAR_HISTORY')!
+VALUES ASSERT_EQUALS((SELECT COUNT(*) FROM BAR_HISTORY_DELTA), 4)!
+VALUES ASSERT_EQUALS((
+    SELECT COUNT(*)
+    FROM BAR_HISTORY_DELTA
+    WHERE ID IN (1, 2)
+    AND EXPIRY_DAY = CURRENT DATE - 1 DAY), 2)!
+VALUES ASSERT_EQUALS((SELECT COUNT(*) FROM BAR_HISTORY_DELTA WHERE ID = 3), 1)!
+
+DROP VIEW BAR_HISTORY_DELTA!
+DROP SPECIFIC PROCEDURE TEST_EXPORT_DELTA!
+DROP TABLE BAR_HISTORY!
+DROP TABLE BAR!
+CALL REFRESH_EXPORT_MANIFEST!
+
+-- vim: set et sw=4 sts=4:
@@ -0,0 +1,9 @@
+VALUES ASSERT_EQUALS(ROW_HASH('FOO'), ROW_HASH(0, 'FOO'))!
+VALUES ASSERT_EQUALS(ROW_HASH(CAST(NULL AS BIGINT), 'FOO'), ROW_HASH(0, 'FOO'))!
+VALUES ASSERT_IS_NOT_NULL(ROW_HASH(CAST(NULL AS VARCHAR(10))))!
+VALUES ASSERT_NOT_EQUALS(ROW_HASH(''), ROW_HASH(CAST(NULL AS VARCHAR(10))))!
+VALUES ASSERT_NOT_EQUALS(ROW_HASH('FOO'), ROW_HASH('BAR'))!
+VALUES ASSERT_NOT_EQUALS(ROW_HASH(ROW_HASH('FOO'), 'BAR'), ROW_HASH(ROW_HASH('BAR'), 'FOO'))!
+VALUES ASSERT_NOT_EQUALS(ROW_HASH(ROW_HASH('FOO'), ''), ROW_HASH(ROW_HASH(''), 'FOO'))!
+
+-- vim: set et sw=4 sts=4:
@@ -113,6 +113,14 @@ END!
 
 CALL ASSERT_SIGNALS(HISTORY_UPDATE_PK_STATE, 'UPDATE FOO SET ID = 4 WHERE ID = 2')!
 
+-- Check that the triggers do nothing when BYPASS_TRIGGERS is set
+SET BYPASS_TRIGGERS = 'Y'!
+INSERT INTO FOO (ID, VALUE) VALUES (3, 1)!
+UPDATE FOO SET VALUE = 3 WHERE ID = 2!
+VALUES ASSERT_EQUALS(0, (SELECT COUNT(*) FROM FOO_HISTORY WHERE ID = 3))!
+VALUES ASSERT_EQUALS(0, (SELECT COUNT(*) FROM FOO_HISTORY WHERE VALUE = 3))!
+SET BYPASS_TRIGGERS = 'N'!
+
 DROP VIEW FOO_CHANGES!
 DROP TABLE FOO_HISTORY!
 DROP TRIGGER FOO_DELETE!
@@ -163,6 +171,30 @@ VALUES ASSERT_EQUALS(6, (SELECT COUNT(*) FROM (
         (5, 'NEW_VALUE')
     ) AS T))!
 
+CALL CREATE_HISTORY_CHANGES_TABLE('FOO_HISTORY', 'FOO_CHANGELOG')!
+CALL ASSERT_TABLE_EXISTS('FOO_CHANGELOG')!
+CALL ASSERT_TRIGGER_EXISTS('FOO_HISTORY_INSERT')!
+CALL ASSERT_TRIGGER_EXISTS('FOO_HISTORY_EXPIRE')!
+CALL ASSERT_TRIGGER_EXISTS('FOO_HISTORY_UPDATE')!
+CALL ASSERT_TRIGGER_EXISTS('FOO_HISTORY_DELETE')!
+VALUES ASSERT_EQUALS(7, (SELECT COUNT(*) FROM (
+    SELECT COLNO, COLNAME
+    FROM SYSCAT.COLUMNS
+    WHERE TABSCHEMA = CURRENT SCHEMA
+    AND TABNAME = 'FOO_CHANGELOG'
+
+    INTERSECT
+
+    VALUES
+        (0, 'CHANGE_ID'),
+        (1, 'CHANGED'),
+        (2, 'CHANGE'),
+        (3, 'OLD_ID'),
+        (4, 'NEW_ID'),
+        (5, 'OLD_VALUE'),
+        (6, 'NEW_VALUE')
+    ) AS T))!
+
 -- XXX The following test *might* fail if the machine running the test is fast
 -- enough to run two consecutive manipulations of the base FOO table including
 -- all dependent triggers within a single microsecond ... but I don't think
@@ -240,8 +272,101 @@ BEGIN ATOMIC
         ) AS T));
 END!
 
+-- The trigger maintained changes table must match the changes view exactly
+VALUES ASSERT_EQUALS(4, (SELECT COUNT(*) FROM FOO_CHANGELOG))!
+VALUES ASSERT_EQUALS(0, (SELECT COUNT(*) FROM (
+    SELECT CHANGED, CHANGE, OLD_ID, NEW_ID, OLD_VALUE, NEW_VALUE FROM FOO_CHANGELOG
+    EXCEPT
+    SELECT * FROM FOO_CHANGES
+    ) AS T))!
+VALUES ASSERT_EQUALS(0, (SELECT COUNT(*) FROM (
+    SELECT * FROM FOO_CHANGES
+    EXCEPT
+    SELECT CHANGED, CHANGE, OLD_ID, NEW_ID, OLD_VALUE, NEW_VALUE FROM FOO_CHANGELOG
+    ) AS T))!
+
+BEGIN ATOMIC
+    DECLARE FROM_ID BIGINT DEFAULT NULL;
+    DECLARE TO_ID BIGINT DEFAULT NULL;
+
+    CALL MARK_HISTORY_CHANGES('FOO_CHANGELOG', 'TEST', FROM_ID, TO_ID);
+    VALUES ASSERT_EQUALS(0, FROM_ID);
+    VALUES ASSERT_EQUALS((SELECT MAX(CHANGE_ID) FROM FOO_CHANGELOG), TO_ID);
+    INSERT INTO FOO VALUES (3, 1);
+    CALL MARK_HISTORY_CHANGES('FOO_CHANGELOG', 'TEST', FROM_ID, TO_ID);
+    VALUES ASSERT_EQUALS(1, (
+        SELECT COUNT(*)
+        FROM FOO_CHANGELOG
+        WHERE CHANGE_ID > FROM_ID
+        AND CHANGE_ID <= TO_ID
+        AND CHANGE = 'INSERT'
+        AND NEW_ID = 3));
+END!
+
+-- A row inserted and deleted within one period must leave its insertion in
+-- place and be compensated by a deletion, as consumers may have seen the former
+BEGIN ATOMIC
+    DECLARE FROM_ID BIGINT DEFAULT NULL;
+    DECLARE TO_ID BIGINT DEFAULT NULL;
+
+    CALL MARK_HISTORY_CHANGES('FOO_CHANGELOG', 'TEST', FROM_ID, TO_ID);
+    INSERT INTO FOO VALUES (4, 1);
+    CALL MARK_HISTORY_CHANGES('FOO_CHANGELOG', 'TEST', FROM_ID, TO_ID);
+    DELETE FROM FOO WHERE ID = 4;
+    VALUES ASSERT_EQUALS(0, (SELECT COUNT(*) FROM FOO_HISTORY WHERE ID = 4));
+    VALUES ASSERT_EQUALS(1, (
+        SELECT COUNT(*)
+        FROM FOO_CHANGELOG
+        WHERE CHANGE_ID <= TO_ID
+        AND CHANGE = 'INSERT'
+        AND NEW_ID = 4));
+    VALUES ASSERT_EQUALS(1, (
+        SELECT COUNT(*)
+        FROM FOO_CHANGELOG
+        WHERE CHANGE_ID > TO_ID
+        AND CHANGE = 'DELETE'
+        AND OLD_ID = 4
+        AND OLD_VALUE = 1
+        AND NEW_ID IS NULL));
+END!
+
+-- A row re-inserted within the period of a deletion which a consumer has
+-- already been handed must leave the deletion alone and record an insertion
+BEGIN ATOMIC
+    DECLARE FROM_ID BIGINT DEFAULT NULL;
+    DECLARE TO_ID BIGINT DEFAULT NULL;
+
+    INSERT INTO FOO VALUES (5, 1);
+    DELETE FROM FOO WHERE ID = 5;
+    CALL MARK_HISTORY_CHANGES('FOO_CHANGELOG', 'TEST', FROM_ID, TO_ID);
+    INSERT INTO FOO VALUES (5, 2);
+    VALUES ASSERT_EQUALS(1, (
+        SELECT COUNT(*)
+        FROM FOO_CHANGELOG
+        WHERE CHANGE_ID <= TO_ID
+        AND CHANGE = 'DELETE'
+        AND OLD_ID = 5
+        AND NEW_ID IS NULL));
+    VALUES ASSERT_EQUALS(1, (
+        SELECT COUNT(*)
+        FROM FOO_CHANGELOG
+        WHERE CHANGE_ID > TO_ID
+        AND CHANGE = 'INSERT'
+        AND OLD_ID IS NULL
+        AND NEW_ID = 5
+        AND NEW_VALUE = 2));
+    VALUES ASSERT_EQUALS(0, (
+        SELECT COUNT(*)
+        FROM FOO_CHANGELOG
+        WHERE CHANGE = 'UPDATE'
+        AND NEW_ID = 5));
+END!
+
 DROP VIEW FOO_CHANGES!
 DROP TABLE FOO_HISTORY!
+DROP TABLE FOO_CHANGELOG!
+DROP SEQUENCE FOO_CHANGELOG_SEQ!
+DELETE FROM HISTORY_CHANGES_MARKS!
 DROP TRIGGER FOO_INSERT!
 DROP TRIGGER FOO_UPDATE!
 DROP TRIGGER FOO_DELETE!
@@ -287,6 +412,38 @@ BEGIN ATOMIC
         AND EXPIRY_WEEK_ISO = '9999-12-31'));
 END!
 
+CALL ASSERT_SIGNALS(HISTORY_PARTITION_STATE, 'CALL ARCHIVE_HISTORY(''FOO_HISTORY'', ''1 YEAR'')')!
+
+DROP TABLE FOO_HISTORY!
+
+BEGIN ATOMIC
+    DECLARE TBSPACE VARCHAR(18) DEFAULT NULL;
+
+    SET TBSPACE = (
+        SELECT TBSPACE
+        FROM SYSCAT.TABLES
+        WHERE TABSCHEMA = CURRENT SCHEMA
+        AND TABNAME = 'FOO');
+    CALL CREATE_HISTORY_TABLE('FOO', 'FOO_HISTORY', TBSPACE, 'DAY', 'MONTH');
+END!
+CALL ASSERT_TABLE_EXISTS('FOO_HISTORY')!
+VALUES ASSERT_EQUALS('EFFECTIVE_DAY', (
+    SELECT VARCHAR(DATAPARTITIONEXPRESSION)
+    FROM SYSCAT.DATAPARTITIONEXPRESSION
+    WHERE TABSCHEMA = CURRENT SCHEMA
+    AND TABNAME = 'FOO_HISTORY'))!
+VALUES ASSERT_EQUALS(13, (
+    SELECT COUNT(*)
+    FROM SYSCAT.DATAPARTITIONS
+    WHERE TABSCHEMA = CURRENT SCHEMA
+    AND TABNAME = 'FOO_HISTORY'))!
+VALUES ASSERT_EQUALS(CHAR(MONTHSTART(CURRENT DATE + 1 YEAR), ISO), (
+    SELECT TRIM(BOTH '''' FROM HIGHVALUE)
+    FROM SYSCAT.DATAPARTITIONS
+    WHERE TABSCHEMA = CURRENT SCHEMA
+    AND TABNAME = 'FOO_HISTORY'
+    AND SEQNO = 12))!
+
 DROP TABLE FOO_HISTORY!
 DROP TABLE FOO!
 
@@ -0,0 +1,38 @@
+-- Check that WRITE_LOG writes immediately when unbuffered, and holds messages
+-- until the buffer is full or flushed otherwise
+CALL WRITE_LOG('D', 'TEST_LOG unbuffered')!
+VALUES ASSERT_EQUALS((SELECT COUNT(*) FROM LOG WHERE TEXT = 'TEST_LOG unbuffered'), 1)!
+
+SET LOG_BUFFER_SIZE = 3!
+CALL WRITE_LOG('D', 'T', CURRENT SCHEMA, 'LOG', 'TEST_LOG buffered')!
+CALL WRITE_LOG('D', 'T', CURRENT SCHEMA, 'LOG', 'TEST_LOG buffered')!
+VALUES ASSERT_EQUALS((SELECT COUNT(*) FROM LOG WHERE TEXT = 'TEST_LOG buffered'), 0)!
+CALL WRITE_LOG('D', 'T', CURRENT SCHEMA, 'LOG', 'TEST_LOG buffered')!
+VALUES ASSERT_EQUALS((SELECT COUNT(*) FROM LOG WHERE TEXT = 'TEST_LOG buffered'), 3)!
+
+CALL WRITE_LOG('D', 'TEST_LOG flushed')!
+VALUES ASSERT_EQUALS((SELECT COUNT(*) FROM LOG WHERE TEXT = 'TEST_LOG flushed'), 0)!
+CALL FLUSH_LOG!
+VALUES ASSERT_EQUALS((SELECT COUNT(*) FROM LOG WHERE TEXT = 'TEST_LOG flushed'), 1)!
+VALUES ASSERT_EQUALS((SELECT COUNT(*) FROM LOG_BUFFER), 0)!
+SET LOG_BUFFER_SIZE = 0!
+
+-- Check that X_ADD_LOG_PARTITIONS adds a partition for a month beyond the
+-- last partition without bridging the gap before it
+CALL ASSERT_SIGNALS('22525', 'INSERT INTO LOG (CREATED, TEXT) VALUES (CURRENT TIMESTAMP + 3 MONTHS, ''TEST_LOG future'')')!
+CALL X_ADD_LOG_PARTITIONS(CURRENT TIMESTAMP + 3 MONTHS, CURRENT TIMESTAMP + 3 MONTHS)!
+VALUES ASSERT_EQUALS((
+    SELECT COUNT(*)
+    FROM SYSCAT.DATAPARTITIONS
+    WHERE TABSCHEMA = CURRENT SCHEMA
+    AND TABNAME = 'LOG'
+    AND DATAPARTITIONNAME IN (
+        'LOG_' || TO_CHAR(CURRENT TIMESTAMP + 2 MONTHS, 'YYYYMM'),
+        'LOG_' || TO_CHAR(CURRENT TIMESTAMP + 3 MONTHS, 'YYYYMM')
+    )), 1)!
+INSERT INTO LOG (CREATED, TEXT) VALUES (CURRENT TIMESTAMP + 3 MONTHS, 'TEST_LOG future')!
+VALUES ASSERT_EQUALS((SELECT COUNT(*) FROM LOG WHERE TEXT = 'TEST_LOG future'), 1)!
+
+DELETE FROM LOG WHERE TEXT LIKE 'TEST_LOG %'!
+
+-- vim: set et sw=4 sts=4:
@@ -74,9 +74,85 @@ VALUES ASSERT_EQUALS(6, (SELECT COUNT(*) FROM (
         SELECT COUNTRY, ID, GIVENNAME, SURNAME FROM EMP
     ) AS T))!
 
+UPDATE BAZ SET SURNAME = 'Slaghoople' WHERE ID = 3!
+
+CALL AUTO_MERGE_HASHED('BAZ', 'EMP')!
+VALUES ASSERT_EQUALS(6, (SELECT COUNT(*) FROM (
+        SELECT COUNTRY, ID, GIVENNAME, SURNAME FROM BAZ
+        INTERSECT
+        SELECT COUNTRY, ID, GIVENNAME, SURNAME FROM EMP
+    ) AS T))!
+
+ALTER TABLE EMP ADD COLUMN CHANGE_HASH BIGINT!
+UPDATE BAZ SET GIVENNAME = 'Frederick' WHERE ID = 1!
+
+CALL AUTO_MERGE_HASHED('BAZ', 'EMP', 'PK', 'CHANGE_HASH')!
+VALUES ASSERT_EQUALS(0, (SELECT COUNT(*) FROM EMP WHERE CHANGE_HASH IS NULL))!
+VALUES ASSERT_EQUALS('Frederick Flintstone', (SELECT NAME FROM EMP WHERE ID = 1))!
+
+CREATE TABLE QUX (
+    ID DOUBLE NOT NULL,
+    VALUE INTEGER NOT NULL
+)!
+
+CREATE TABLE QUUX LIKE QUX!
+ALTER TABLE QUUX ADD CONSTRAINT PK PRIMARY KEY (ID)!
+
+CALL ASSERT_SIGNALS(MERGE_CHUNK_KEY_STATE, 'CALL AUTO_INSERT_CHUNKED(''QUX'', ''QUUX'', 10)')!
+CREATE TABLE CORGE (
+    ID INTEGER NOT NULL,
+    NAME VARCHAR(20) NOT NULL,
+    AMOUNT DECIMAL(10, 2) NOT NULL
+)!
+
+CREATE TABLE GRAULT (
+    ID INTEGER NOT NULL,
+    NAME CHAR(20) NOT NULL,
+    AMOUNT DECIMAL(12, 4) NOT NULL,
+    CONSTRAINT PK PRIMARY KEY (ID)
+)!
+
+CREATE TABLE GARPLY (
+    ID INTEGER NOT NULL
+)!
+
+CREATE TRIGGER GRAULT_UPDATE
+    AFTER UPDATE ON GRAULT
+    REFERENCING NEW AS NEW
+    FOR EACH ROW
+    INSERT INTO GARPLY VALUES (NEW.ID)!
+
+INSERT INTO CORGE VALUES
+    (1, 'Fred', 1.5),
+    (2, 'Barney', 2.25),
+    (3, 'Wilma', 3)!
+
+-- Unchanged rows must not be updated even though the types of the source
+-- and destination columns differ
+CALL AUTO_MERGE_HASHED('CORGE', 'GRAULT')!
+CALL AUTO_MERGE_HASHED('CORGE', 'GRAULT')!
+VALUES ASSERT_EQUALS(0, (SELECT COUNT(*) FROM GARPLY))!
+
+UPDATE CORGE SET AMOUNT = AMOUNT + 1 WHERE ID = 2!
+
+CALL AUTO_MERGE_HASHED('CORGE', 'GRAULT')!
+VALUES ASSERT_EQUALS(1, (SELECT COUNT(*) FROM GARPLY))!
+VALUES ASSERT_EQUALS(2, (SELECT ID FROM GARPLY))!
+VALUES ASSERT_EQUALS(3, (SELECT COUNT(*) FROM CORGE C JOIN GRAULT G ON C.ID = G.ID AND C.NAME = G.NAME AND C.AMOUNT = G.AMOUNT))!
+
+CALL ASSERT_SIGNALS(MERGE_HASH_TYPE_STATE, 'CALL AUTO_MERGE_HASHED(''BAZ'', ''EMP'', ''PK'', ''GIVENNAME'')')!
+CALL ASSERT_SIGNALS(MERGE_CHUNK_SIZE_STATE, 'CALL AUTO_MERGE_CHUNKED(''BAZ'', ''EMP'', 0)')!
+CALL ASSERT_SIGNALS(MERGE_NO_KEY_STATE, 'CALL AUTO_INSERT_CHUNKED(''BAZ'', ''EMP'', ''NO_SUCH_KEY'', 10)')!
+CALL ASSERT_SIGNALS(MERGE_SAME_TABLE_STATE, 'CALL AUTO_DELETE_CHUNKED(''EMP'', ''EMP'', 10)')!
+
 DROP TABLE FOO!
 DROP TABLE BAR!
 DROP TABLE BAZ!
 DROP TABLE EMP!
+DROP TABLE QUX!
+DROP TABLE QUUX!
+DROP TABLE CORGE!
+DROP TABLE GRAULT!
+DROP TABLE GARPLY!
 
 -- vim: set et sw=4 sts=4:
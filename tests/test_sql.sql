@@ -2,10 +2,14 @@ VALUES ASSERT_IS_NULL(QUOTE_STRING(NULL))!
 VALUES ASSERT_EQUALS(QUOTE_STRING('A string'), '''A string''')!
 VALUES ASSERT_EQUALS(QUOTE_STRING('Frank''s string'), '''Frank''''s string''')!
 VALUES ASSERT_EQUALS(QUOTE_STRING('A multi' || X'0A' || 'line string'), '''A multi'' || X''0A'' || ''line string''')!
+VALUES ASSERT_EQUALS(QUOTE_STRING(''), 'X''''')!
+VALUES ASSERT_EQUALS(QUOTE_STRING(X'00' || 'A string with a NUL'), 'X''00'' || ''A string with a NUL''')!
 
 VALUES ASSERT_IS_NULL(QUOTE_IDENTIFIER(NULL))!
 VALUES ASSERT_EQUALS(QUOTE_IDENTIFIER('MY_TABLE'), 'MY_TABLE')!
 VALUES ASSERT_EQUALS(QUOTE_IDENTIFIER('MY#TABLE'), 'MY#TABLE')!
+VALUES ASSERT_EQUALS(QUOTE_IDENTIFIER('MY_TABLE   '), 'MY_TABLE')!
+VALUES ASSERT_EQUALS(QUOTE_IDENTIFIER('_MY_TABLE'), '"_MY_TABLE"')!
 VALUES ASSERT_EQUALS(QUOTE_IDENTIFIER('MyTable'), '"MyTable"')!
 VALUES ASSERT_EQUALS(QUOTE_IDENTIFIER('My "Table"'), '"My ""Table"""')!
 
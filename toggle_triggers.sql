@@ -27,8 +27,11 @@
 --
 -- http://www-128.ibm.com/developerworks/db2/library/techarticle/0211swart/0211swart.html
 --
--- Routines are provided to disable and enable individual triggers or all
--- triggers on a specified table.
+-- Routines are provided to disable and enable individual triggers, all
+-- triggers on a specified table, or all triggers on a list of tables (or an
+-- entire schema). A session variable is also provided which the triggers
+-- generated by the history and corrections modules check before doing any
+-- work.
 -------------------------------------------------------------------------------
 
 
@@ -71,6 +74,46 @@ COMMENT ON VARIABLE TRIGGER_NOT_DISABLED_STATE
 COMMENT ON VARIABLE TRIGGER_NOT_ENABLED_STATE
     IS 'The SQLSTATE raised when an attempt to enable a trigger fails'!
 
+-- BYPASS_TRIGGERS
+-------------------------------------------------------------------------------
+-- When this variable is 'Y', the triggers generated by CREATE_HISTORY_TRIGGERS
+-- and CREATE_CORRECTION_TRIGGERS do nothing. As the variable is specific to a
+-- session, this permits a bulk load in one session to skip the work of those
+-- triggers without dropping them (which invalidates packages) and without
+-- affecting any other session.
+-------------------------------------------------------------------------------
+
+CREATE VARIABLE BYPASS_TRIGGERS CHAR(1) DEFAULT 'N'!
+
+GRANT READ, WRITE ON VARIABLE BYPASS_TRIGGERS TO ROLE UTILS_TOGGLE_TRIGGERS_USER!
+GRANT ALL ON VARIABLE BYPASS_TRIGGERS TO ROLE UTILS_TOGGLE_TRIGGERS_ADMIN WITH GRANT OPTION!
+
+COMMENT ON VARIABLE BYPASS_TRIGGERS
+    IS 'When ''Y'', triggers generated by the history and corrections modules do nothing in the current session'!
+
+-- X_BYPASS_TRIGGERS_WHEN()
+-------------------------------------------------------------------------------
+-- This function is effectively a private utility subroutine for the history
+-- and corrections modules. It returns the search condition that generated
+-- triggers include in their WHEN clause to honour BYPASS_TRIGGERS. The
+-- variable is qualified with its schema (so the trigger does not depend on
+-- the function path it is created under), and a NULL value is treated as 'N'.
+-------------------------------------------------------------------------------
+
+CREATE FUNCTION X_BYPASS_TRIGGERS_WHEN()
+    RETURNS VARCHAR(300)
+    SPECIFIC X_BYPASS_TRIGGERS_WHEN
+    LANGUAGE SQL
+    NOT DETERMINISTIC
+    NO EXTERNAL ACTION
+    READS SQL DATA
+RETURN
+    SELECT 'COALESCE(' || QUOTE_IDENTIFIER(VARSCHEMA) || '.BYPASS_TRIGGERS, ''N'') <> ''Y'''
+    FROM SYSCAT.VARIABLES
+    WHERE VARNAME = 'BYPASS_TRIGGERS'
+    ORDER BY COALESCE(NULLIF(LOCATE('"' || VARSCHEMA || '"', CURRENT PATH), 0), 32767)
+    FETCH FIRST 1 ROW ONLY!
+
 -- DISABLED_TRIGGERS
 -------------------------------------------------------------------------------
 -- The DISABLED_TRIGGERS table holds all the details necessary to recreate
@@ -86,6 +129,7 @@ CREATE TABLE DISABLED_TRIGGERS AS (
         TABNAME,
         QUALIFIER,
         FUNC_PATH,
+        CREATE_TIME,
         TEXT
     FROM
         SYSCAT.TRIGGERS
@@ -95,9 +139,41 @@ WITH NO DATA!
 CREATE UNIQUE INDEX DISABLED_TRIGGERS_PK
     ON DISABLED_TRIGGERS (TRIGSCHEMA, TRIGNAME)!
 
+CREATE INDEX DISABLED_TRIGGERS_X1
+    ON DISABLED_TRIGGERS (TABSCHEMA, TABNAME, CREATE_TIME)!
+
 ALTER TABLE DISABLED_TRIGGERS
     ADD CONSTRAINT PK PRIMARY KEY (TRIGSCHEMA, TRIGNAME)!
 
+-- TOGGLED_TRIGGERS
+-------------------------------------------------------------------------------
+-- The TOGGLED_TRIGGERS table records, for each table processed by the last
+-- call to DISABLE_SCHEMA_TRIGGERS or ENABLE_SCHEMA_TRIGGERS, the number of
+-- triggers disabled or enabled and the time taken to do so.
+-------------------------------------------------------------------------------
+
+CREATE TABLE TOGGLED_TRIGGERS (
+    TABSCHEMA   VARCHAR(128) NOT NULL,
+    TABNAME     VARCHAR(128) NOT NULL,
+    OPERATION   CHAR(1) NOT NULL,
+    TRIGGERS    INTEGER NOT NULL,
+    STARTED     TIMESTAMP NOT NULL,
+    ELAPSED     DECIMAL(18, 6) NOT NULL
+)!
+
+CREATE UNIQUE INDEX TOGGLED_TRIGGERS_PK
+    ON TOGGLED_TRIGGERS (TABSCHEMA, TABNAME)!
+
+ALTER TABLE TOGGLED_TRIGGERS
+    ADD CONSTRAINT PK PRIMARY KEY (TABSCHEMA, TABNAME)
+    ADD CONSTRAINT OPERATION_CK CHECK (OPERATION IN ('D', 'E'))!
+
+GRANT CONTROL ON TABLE TOGGLED_TRIGGERS TO ROLE UTILS_TOGGLE_TRIGGERS_ADMIN WITH GRANT OPTION!
+GRANT SELECT ON TABLE TOGGLED_TRIGGERS TO ROLE UTILS_TOGGLE_TRIGGERS_USER!
+
+COMMENT ON TABLE TOGGLED_TRIGGERS
+    IS 'Per table trigger counts and timings of the last DISABLE_SCHEMA_TRIGGERS or ENABLE_SCHEMA_TRIGGERS call'!
+
 -- DISABLE_TRIGGER(ASCHEMA, ATRIGGER)
 -- DISABLE_TRIGGER(ATRIGGER)
 -------------------------------------------------------------------------------
@@ -128,6 +204,7 @@ BEGIN ATOMIC
             TABNAME,
             QUALIFIER,
             FUNC_PATH,
+            CREATE_TIME,
             TEXT
         FROM
             SYSCAT.TRIGGERS
@@ -194,6 +271,7 @@ BEGIN ATOMIC
             TABNAME,
             QUALIFIER,
             FUNC_PATH,
+            CREATE_TIME,
             TEXT
         FROM
             SYSCAT.TRIGGERS
@@ -312,6 +390,8 @@ COMMENT ON SPECIFIC PROCEDURE ENABLE_TRIGGER2
 -- affect inactive triggers which are still attached to the table, just those
 -- triggers that have been disabled with DISABLE_TRIGGER or DISABLE_TRIGGERS.
 -- To reactivate inactive triggers, see RECREATE_TRIGGER and RECREATE_TRIGGERS.
+-- Triggers are recreated in the order they were originally created in, which
+-- preserves their order of activation.
 -------------------------------------------------------------------------------
 
 CREATE PROCEDURE ENABLE_TRIGGERS(ASCHEMA VARCHAR(128), ATABLE VARCHAR(128))
@@ -344,6 +424,8 @@ BEGIN ATOMIC
         WHERE
             TABSCHEMA = ASCHEMA
             AND TABNAME = ATABLE
+        ORDER BY
+            CREATE_TIME
     DO
         EXECUTE IMMEDIATE D.SET_PATH;
         EXECUTE IMMEDIATE D.SET_QUALIFIER;
@@ -376,4 +458,349 @@ COMMENT ON SPECIFIC PROCEDURE ENABLE_TRIGGERS1
 COMMENT ON SPECIFIC PROCEDURE ENABLE_TRIGGERS2
     IS 'Enables all disabled triggers associated with a specified table'!
 
+-- DISABLE_SCHEMA_TRIGGERS(ASCHEMA, ATABLES)
+-- DISABLE_SCHEMA_TRIGGERS(ASCHEMA)
+-- DISABLE_SCHEMA_TRIGGERS()
+-------------------------------------------------------------------------------
+-- Disables all the active triggers associated with the tables in ATABLES (a
+-- comma-separated list of unquoted table names) in the schema ASCHEMA. If
+-- ATABLES is omitted, blank or NULL, all active triggers in the schema are
+-- disabled. If ASCHEMA is omitted it defaults to the current schema.
+--
+-- The triggers are read from SYSCAT.TRIGGERS in a single pass, and saved and
+-- dropped table by table. The number of triggers disabled and the time taken
+-- for each table are recorded in TOGGLED_TRIGGERS. The procedure commits after
+-- every 10 tables (and at the end), never part way through a table, so an
+-- interrupted run keeps the triggers disabled so far and may simply be run
+-- again.
+--
+-- X_TRIGGER_TABLES is effectively a private subroutine which splits a
+-- comma-separated list of table names into a table. X_TOGGLED_TRIGGERS is
+-- another which records the timing of a table in TOGGLED_TRIGGERS.
+-------------------------------------------------------------------------------
+
+CREATE FUNCTION X_TRIGGER_TABLES(ATABLES VARCHAR(4000))
+    RETURNS TABLE (
+        TABNAME VARCHAR(128)
+    )
+    SPECIFIC X_TRIGGER_TABLES
+    DETERMINISTIC
+    NO EXTERNAL ACTION
+    CONTAINS SQL
+    LANGUAGE SQL
+RETURN
+    WITH SPLIT(N, ITEM, REST) AS (
+        SELECT 0, VARCHAR('', 4001), VARCHAR(ATABLES || ',', 4001)
+        FROM SYSIBM.SYSDUMMY1
+        UNION ALL
+        SELECT
+            N + 1,
+            LEFT(REST, LOCATE(',', REST) - 1),
+            SUBSTR(REST, LOCATE(',', REST) + 1)
+        FROM SPLIT
+        WHERE N < 4001
+            AND REST <> ''
+    )
+    SELECT DISTINCT VARCHAR(TRIM(ITEM), 128)
+    FROM SPLIT
+    WHERE N > 0
+        AND TRIM(ITEM) <> ''!
+
+CREATE PROCEDURE X_TOGGLED_TRIGGERS(
+    ASCHEMA VARCHAR(128),
+    ATABLE VARCHAR(128),
+    AOPERATION CHAR(1),
+    ATRIGGERS INTEGER,
+    ASTARTED TIMESTAMP
+)
+    SPECIFIC X_TOGGLED_TRIGGERS
+    MODIFIES SQL DATA
+    NOT DETERMINISTIC
+    NO EXTERNAL ACTION
+    LANGUAGE SQL
+BEGIN ATOMIC
+    DECLARE FINISHED TIMESTAMP;
+    SET FINISHED = CURRENT TIMESTAMP;
+    DELETE FROM TOGGLED_TRIGGERS
+        WHERE TABSCHEMA = ASCHEMA
+        AND TABNAME = ATABLE;
+    INSERT INTO TOGGLED_TRIGGERS
+        (TABSCHEMA, TABNAME, OPERATION, TRIGGERS, STARTED, ELAPSED)
+        VALUES (
+            ASCHEMA,
+            ATABLE,
+            AOPERATION,
+            ATRIGGERS,
+            ASTARTED,
+            (SECONDS(FINISHED) - SECONDS(ASTARTED))
+                + (MICROSECOND(FINISHED) - MICROSECOND(ASTARTED)) / 1000000.0
+        );
+END!
+
+CREATE PROCEDURE DISABLE_SCHEMA_TRIGGERS(ASCHEMA VARCHAR(128), ATABLES VARCHAR(4000))
+    SPECIFIC DISABLE_SCHEMA_TRIGGERS1
+    MODIFIES SQL DATA
+    NOT DETERMINISTIC
+    NO EXTERNAL ACTION
+    LANGUAGE SQL
+BEGIN
+    DECLARE SQLCODE INTEGER DEFAULT 0;
+    DECLARE COMMIT_TABLES INTEGER DEFAULT 10;
+    DECLARE DONE_TABLES INTEGER DEFAULT 0;
+    DECLARE LAST_TABLE VARCHAR(128) DEFAULT NULL;
+    DECLARE TABLE_STARTED TIMESTAMP DEFAULT NULL;
+    DECLARE TABLE_TRIGGERS INTEGER DEFAULT 0;
+    DECLARE T_TRIGSCHEMA VARCHAR(128) DEFAULT NULL;
+    DECLARE T_TRIGNAME VARCHAR(128) DEFAULT NULL;
+    DECLARE T_TABNAME VARCHAR(128) DEFAULT NULL;
+    DECLARE T_QUALIFIER VARCHAR(128) DEFAULT NULL;
+    DECLARE T_FUNC_PATH CLOB(2K) DEFAULT NULL;
+    DECLARE T_CREATE_TIME TIMESTAMP DEFAULT NULL;
+    DECLARE T_TEXT CLOB(2M) DEFAULT NULL;
+    DECLARE T_DDL VARCHAR(1000) DEFAULT NULL;
+    -- Read all the active triggers of the selected tables in one pass, ordered
+    -- by table so that each table's triggers are saved and dropped together
+    DECLARE TRIGGERS_CUR CURSOR WITH HOLD FOR
+        SELECT
+            TRIGSCHEMA,
+            TRIGNAME,
+            TABNAME,
+            QUALIFIER,
+            FUNC_PATH,
+            CREATE_TIME,
+            TEXT,
+            'DROP TRIGGER ' || QUOTE_IDENTIFIER(TRIGSCHEMA) || '.' || QUOTE_IDENTIFIER(TRIGNAME) AS DDL
+        FROM
+            SYSCAT.TRIGGERS
+        WHERE
+            TABSCHEMA = ASCHEMA
+            AND VALID = 'Y'
+            AND (
+                COALESCE(ATABLES, '') = ''
+                OR TABNAME IN (SELECT TABNAME FROM TABLE(X_TRIGGER_TABLES(ATABLES)) AS T)
+            )
+        ORDER BY
+            TABNAME,
+            CREATE_TIME;
+    DECLARE EXIT HANDLER FOR SQLWARNING
+        CALL SIGNAL_STATE(TRIGGER_NOT_DISABLED_STATE, 'Unable to disable trigger');
+
+    DELETE FROM TOGGLED_TRIGGERS
+        WHERE TABSCHEMA = ASCHEMA;
+    COMMIT;
+    -- The cursor is held open across the commit after every COMMIT_TABLES
+    -- tables. A table is finished (and the commit considered) once the next
+    -- trigger fetched belongs to another table, or there are no more
+    OPEN TRIGGERS_CUR;
+    FETCH TRIGGERS_CUR INTO T_TRIGSCHEMA, T_TRIGNAME, T_TABNAME, T_QUALIFIER, T_FUNC_PATH, T_CREATE_TIME, T_TEXT, T_DDL;
+    WHILE T_TABNAME IS NOT NULL DO
+        IF LAST_TABLE IS NULL OR T_TABNAME <> LAST_TABLE THEN
+            SET LAST_TABLE = T_TABNAME;
+            SET TABLE_STARTED = CURRENT TIMESTAMP;
+            SET TABLE_TRIGGERS = 0;
+        END IF;
+        INSERT INTO DISABLED_TRIGGERS
+            VALUES (
+                T_TRIGSCHEMA,
+                T_TRIGNAME,
+                ASCHEMA,
+                T_TABNAME,
+                T_QUALIFIER,
+                T_FUNC_PATH,
+                T_CREATE_TIME,
+                T_TEXT
+            );
+        EXECUTE IMMEDIATE T_DDL;
+        SET TABLE_TRIGGERS = TABLE_TRIGGERS + 1;
+        SET T_TABNAME = NULL;
+        FETCH TRIGGERS_CUR INTO T_TRIGSCHEMA, T_TRIGNAME, T_TABNAME, T_QUALIFIER, T_FUNC_PATH, T_CREATE_TIME, T_TEXT, T_DDL;
+        IF T_TABNAME IS NULL OR T_TABNAME <> LAST_TABLE THEN
+            CALL X_TOGGLED_TRIGGERS(ASCHEMA, LAST_TABLE, 'D', TABLE_TRIGGERS, TABLE_STARTED);
+            SET DONE_TABLES = DONE_TABLES + 1;
+            IF MOD(DONE_TABLES, COMMIT_TABLES) = 0 THEN
+                COMMIT;
+            END IF;
+        END IF;
+    END WHILE;
+    CLOSE TRIGGERS_CUR;
+    COMMIT;
+END!
+
+CREATE PROCEDURE DISABLE_SCHEMA_TRIGGERS(ASCHEMA VARCHAR(128))
+    SPECIFIC DISABLE_SCHEMA_TRIGGERS2
+    MODIFIES SQL DATA
+    NOT DETERMINISTIC
+    NO EXTERNAL ACTION
+    LANGUAGE SQL
+BEGIN
+    CALL DISABLE_SCHEMA_TRIGGERS(ASCHEMA, '');
+END!
+
+CREATE PROCEDURE DISABLE_SCHEMA_TRIGGERS()
+    SPECIFIC DISABLE_SCHEMA_TRIGGERS3
+    MODIFIES SQL DATA
+    NOT DETERMINISTIC
+    NO EXTERNAL ACTION
+    LANGUAGE SQL
+BEGIN
+    CALL DISABLE_SCHEMA_TRIGGERS(CURRENT SCHEMA, '');
+END!
+
+GRANT EXECUTE ON SPECIFIC PROCEDURE DISABLE_SCHEMA_TRIGGERS1 TO ROLE UTILS_TOGGLE_TRIGGERS_USER!
+GRANT EXECUTE ON SPECIFIC PROCEDURE DISABLE_SCHEMA_TRIGGERS2 TO ROLE UTILS_TOGGLE_TRIGGERS_USER!
+GRANT EXECUTE ON SPECIFIC PROCEDURE DISABLE_SCHEMA_TRIGGERS3 TO ROLE UTILS_TOGGLE_TRIGGERS_USER!
+GRANT EXECUTE ON SPECIFIC PROCEDURE DISABLE_SCHEMA_TRIGGERS1 TO ROLE UTILS_TOGGLE_TRIGGERS_ADMIN WITH GRANT OPTION!
+GRANT EXECUTE ON SPECIFIC PROCEDURE DISABLE_SCHEMA_TRIGGERS2 TO ROLE UTILS_TOGGLE_TRIGGERS_ADMIN WITH GRANT OPTION!
+GRANT EXECUTE ON SPECIFIC PROCEDURE DISABLE_SCHEMA_TRIGGERS3 TO ROLE UTILS_TOGGLE_TRIGGERS_ADMIN WITH GRANT OPTION!
+
+COMMENT ON SPECIFIC PROCEDURE DISABLE_SCHEMA_TRIGGERS1
+    IS 'Disables all triggers associated with the specified tables in a schema by saving their definitions to a table and dropping them'!
+COMMENT ON SPECIFIC PROCEDURE DISABLE_SCHEMA_TRIGGERS2
+    IS 'Disables all triggers in the specified schema by saving their definitions to a table and dropping them'!
+COMMENT ON SPECIFIC PROCEDURE DISABLE_SCHEMA_TRIGGERS3
+    IS 'Disables all triggers in the current schema by saving their definitions to a table and dropping them'!
+
+-- ENABLE_SCHEMA_TRIGGERS(ASCHEMA, ATABLES)
+-- ENABLE_SCHEMA_TRIGGERS(ASCHEMA)
+-- ENABLE_SCHEMA_TRIGGERS()
+-------------------------------------------------------------------------------
+-- Enables all the disabled triggers for the tables in ATABLES (a
+-- comma-separated list of unquoted table names) in the schema ASCHEMA. If
+-- ATABLES is omitted, blank or NULL, all disabled triggers in the schema are
+-- enabled. If ASCHEMA is omitted it defaults to the current schema.
+--
+-- Triggers are recreated table by table, in the order they were originally
+-- created in (which preserves their order of activation). The SET SCHEMA and
+-- SET PATH statements required by each trigger are only executed when the
+-- qualifier or path differs from that of the prior trigger. The number of
+-- triggers enabled and the time taken for each table are recorded in
+-- TOGGLED_TRIGGERS. Each table's entries are removed from DISABLED_TRIGGERS
+-- once its triggers have been recreated, and the procedure commits after
+-- every 10 tables (and at the end), so an interrupted run keeps the triggers
+-- enabled so far and may simply be run again.
+-------------------------------------------------------------------------------
+
+CREATE PROCEDURE ENABLE_SCHEMA_TRIGGERS(ASCHEMA VARCHAR(128), ATABLES VARCHAR(4000))
+    SPECIFIC ENABLE_SCHEMA_TRIGGERS1
+    MODIFIES SQL DATA
+    NOT DETERMINISTIC
+    NO EXTERNAL ACTION
+    LANGUAGE SQL
+BEGIN
+    DECLARE SQLCODE INTEGER DEFAULT 0;
+    DECLARE COMMIT_TABLES INTEGER DEFAULT 10;
+    DECLARE DONE_TABLES INTEGER DEFAULT 0;
+    DECLARE SAVE_PATH VARCHAR(254);
+    DECLARE SAVE_SCHEMA VARCHAR(128);
+    DECLARE LAST_QUALIFIER VARCHAR(200) DEFAULT '';
+    DECLARE LAST_PATH VARCHAR(2100) DEFAULT '';
+    DECLARE LAST_TABLE VARCHAR(128) DEFAULT NULL;
+    DECLARE TABLE_STARTED TIMESTAMP DEFAULT NULL;
+    DECLARE TABLE_TRIGGERS INTEGER DEFAULT 0;
+    DECLARE T_TABNAME VARCHAR(128) DEFAULT NULL;
+    DECLARE T_SET_QUALIFIER VARCHAR(200) DEFAULT NULL;
+    DECLARE T_SET_PATH VARCHAR(2100) DEFAULT NULL;
+    DECLARE T_TEXT CLOB(2M) DEFAULT NULL;
+    DECLARE TRIGGERS_CUR CURSOR WITH HOLD FOR
+        SELECT
+            TABNAME,
+            'SET SCHEMA ' || QUOTE_IDENTIFIER(QUALIFIER) AS SET_QUALIFIER,
+            'SET PATH '   || VARCHAR(FUNC_PATH, 2048)    AS SET_PATH,
+            TEXT                                         AS TEXT
+        FROM
+            DISABLED_TRIGGERS
+        WHERE
+            TABSCHEMA = ASCHEMA
+            AND (
+                COALESCE(ATABLES, '') = ''
+                OR TABNAME IN (SELECT TABNAME FROM TABLE(X_TRIGGER_TABLES(ATABLES)) AS T)
+            )
+        ORDER BY
+            TABNAME,
+            CREATE_TIME;
+    DECLARE EXIT HANDLER FOR SQLWARNING
+        CALL SIGNAL_STATE(TRIGGER_NOT_ENABLED_STATE, 'Unable to enable trigger');
+
+    SET SAVE_PATH = CURRENT PATH;
+    SET SAVE_SCHEMA = CURRENT SCHEMA;
+    DELETE FROM TOGGLED_TRIGGERS
+        WHERE TABSCHEMA = ASCHEMA;
+    COMMIT;
+    -- The cursor is held open across the commit after every COMMIT_TABLES
+    -- tables. A table is finished (its entries removed from DISABLED_TRIGGERS
+    -- and the commit considered) once the next trigger fetched belongs to
+    -- another table, or there are no more
+    OPEN TRIGGERS_CUR;
+    FETCH TRIGGERS_CUR INTO T_TABNAME, T_SET_QUALIFIER, T_SET_PATH, T_TEXT;
+    WHILE T_TABNAME IS NOT NULL DO
+        IF LAST_TABLE IS NULL OR T_TABNAME <> LAST_TABLE THEN
+            SET LAST_TABLE = T_TABNAME;
+            SET TABLE_STARTED = CURRENT TIMESTAMP;
+            SET TABLE_TRIGGERS = 0;
+        END IF;
+        IF T_SET_PATH <> LAST_PATH THEN
+            EXECUTE IMMEDIATE T_SET_PATH;
+            SET LAST_PATH = T_SET_PATH;
+        END IF;
+        IF T_SET_QUALIFIER <> LAST_QUALIFIER THEN
+            EXECUTE IMMEDIATE T_SET_QUALIFIER;
+            SET LAST_QUALIFIER = T_SET_QUALIFIER;
+        END IF;
+        EXECUTE IMMEDIATE T_TEXT;
+        SET TABLE_TRIGGERS = TABLE_TRIGGERS + 1;
+        SET T_TABNAME = NULL;
+        FETCH TRIGGERS_CUR INTO T_TABNAME, T_SET_QUALIFIER, T_SET_PATH, T_TEXT;
+        IF T_TABNAME IS NULL OR T_TABNAME <> LAST_TABLE THEN
+            DELETE FROM DISABLED_TRIGGERS
+                WHERE TABSCHEMA = ASCHEMA
+                AND TABNAME = LAST_TABLE;
+            CALL X_TOGGLED_TRIGGERS(ASCHEMA, LAST_TABLE, 'E', TABLE_TRIGGERS, TABLE_STARTED);
+            SET DONE_TABLES = DONE_TABLES + 1;
+            IF MOD(DONE_TABLES, COMMIT_TABLES) = 0 THEN
+                COMMIT;
+            END IF;
+        END IF;
+    END WHILE;
+    CLOSE TRIGGERS_CUR;
+    IF LAST_TABLE IS NOT NULL THEN
+        EXECUTE IMMEDIATE 'SET SCHEMA ' || QUOTE_IDENTIFIER(SAVE_SCHEMA);
+        EXECUTE IMMEDIATE 'SET PATH ' || SAVE_PATH;
+    END IF;
+    COMMIT;
+END!
+
+CREATE PROCEDURE ENABLE_SCHEMA_TRIGGERS(ASCHEMA VARCHAR(128))
+    SPECIFIC ENABLE_SCHEMA_TRIGGERS2
+    MODIFIES SQL DATA
+    NOT DETERMINISTIC
+    NO EXTERNAL ACTION
+    LANGUAGE SQL
+BEGIN
+    CALL ENABLE_SCHEMA_TRIGGERS(ASCHEMA, '');
+END!
+
+CREATE PROCEDURE ENABLE_SCHEMA_TRIGGERS()
+    SPECIFIC ENABLE_SCHEMA_TRIGGERS3
+    MODIFIES SQL DATA
+    NOT DETERMINISTIC
+    NO EXTERNAL ACTION
+    LANGUAGE SQL
+BEGIN
+    CALL ENABLE_SCHEMA_TRIGGERS(CURRENT SCHEMA, '');
+END!
+
+GRANT EXECUTE ON SPECIFIC PROCEDURE ENABLE_SCHEMA_TRIGGERS1 TO ROLE UTILS_TOGGLE_TRIGGERS_USER!
+GRANT EXECUTE ON SPECIFIC PROCEDURE ENABLE_SCHEMA_TRIGGERS2 TO ROLE UTILS_TOGGLE_TRIGGERS_USER!
+GRANT EXECUTE ON SPECIFIC PROCEDURE ENABLE_SCHEMA_TRIGGERS3 TO ROLE UTILS_TOGGLE_TRIGGERS_USER!
+GRANT EXECUTE ON SPECIFIC PROCEDURE ENABLE_SCHEMA_TRIGGERS1 TO ROLE UTILS_TOGGLE_TRIGGERS_ADMIN WITH GRANT OPTION!
+GRANT EXECUTE ON SPECIFIC PROCEDURE ENABLE_SCHEMA_TRIGGERS2 TO ROLE UTILS_TOGGLE_TRIGGERS_ADMIN WITH GRANT OPTION!
+GRANT EXECUTE ON SPECIFIC PROCEDURE ENABLE_SCHEMA_TRIGGERS3 TO ROLE UTILS_TOGGLE_TRIGGERS_ADMIN WITH GRANT OPTION!
+
+COMMENT ON SPECIFIC PROCEDURE ENABLE_SCHEMA_TRIGGERS1
+    IS 'Enables all disabled triggers associated with the specified tables in a schema'!
+COMMENT ON SPECIFIC PROCEDURE ENABLE_SCHEMA_TRIGGERS2
+    IS 'Enables all disabled triggers in the specified schema'!
+COMMENT ON SPECIFIC PROCEDURE ENABLE_SCHEMA_TRIGGERS3
+    IS 'Enables all disabled triggers in the current schema'!
+
 -- vim: set et sw=4 sts=4:
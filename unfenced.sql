@@ -0,0 +1,43 @@
+-------------------------------------------------------------------------------
+-- NOT FENCED REGISTRATION OF EXTERNAL FUNCTIONS
+-------------------------------------------------------------------------------
+-- Copyright (c) 2005-2013 Dave Hughes <dave@waveform.org.uk>
+--
+-- Permission is hereby granted, free of charge, to any person obtaining a copy
+-- of this software and associated documentation files (the "Software"), to
+-- deal in the Software without restriction, including without limitation the
+-- rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+-- sell copies of the Software, and to permit persons to whom the Software is
+-- furnished to do so, subject to the following conditions:
+--
+-- The above copyright notice and this permission notice shall be included in
+-- all copies or substantial portions of the Software.
+--
+-- THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+-- IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+-- FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+-- AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+-- LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+-- FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+-- IN THE SOFTWARE.
+-------------------------------------------------------------------------------
+-- This script reverses fenced.sql, altering the external (C) functions in the
+-- sql, hash, pcre and unicode modules to run NOT FENCED (the default
+-- registration) for the best performance.
+--
+-- Do not run this script directly. Rather, use the "unfenced" target of the
+-- Makefile after installation.
+-------------------------------------------------------------------------------
+
+ALTER SPECIFIC FUNCTION QUOTE_STRING1 NOT FENCED!
+ALTER SPECIFIC FUNCTION QUOTE_IDENTIFIER1 NOT FENCED!
+ALTER SPECIFIC FUNCTION ROW_HASH1 NOT FENCED!
+ALTER SPECIFIC FUNCTION PCRE_SEARCH1 NOT FENCED!
+ALTER SPECIFIC FUNCTION PCRE_SUB1 NOT FENCED!
+ALTER SPECIFIC FUNCTION PCRE_GROUPS1 NOT FENCED!
+ALTER SPECIFIC FUNCTION PCRE_SPLIT1 NOT FENCED!
+ALTER SPECIFIC FUNCTION UNICODE_REPLACE_BAD1 NOT FENCED!
+
+COMMIT!
+
+-- vim: set et sw=4 sts=4:
@@ -29,6 +29,10 @@
  *
  * <http://bjoern.hoehrmann.de/utf-8/decoder/dfa/>
  *
+ * The library must remain thread-safe as the functions may be registered
+ * either NOT FENCED or FENCED THREADSAFE (see fenced.sql). The only data
+ * shared between calls is the constant decoder table below; all other state
+ * lives on the stack of each call.
  */
 
 #include <stdlib.h>
@@ -75,7 +79,7 @@ static const uint8_t utf8d[] = {
   1,3,1,1,1,1,1,3,1,3,1,1,1,1,1,1,1,3,1,1,1,1,1,1,1,1,1,1,1,1,1,1, // s7..s8
 };
 
-uint8_t inline
+static inline uint8_t
 decode_utf8(uint8_t* state, uint32_t* codep, uint8_t byte) {
   uint8_t type = utf8d[byte];
 
@@ -96,11 +100,13 @@ decode_utf8(uint8_t* state, uint32_t* codep, uint8_t byte) {
  *
  * The source parameter specifies a short human-readable name for the caller to
  * include in the error message (which may aid users in debugging statements
- * involving several functions).
+ * involving several functions). The message is formatted directly into the
+ * caller's message buffer so this routine is safe to call from several
+ * threads at once.
  */
-void unicode_udf_error(
+static void unicode_udf_error(
     int err_code,
-    char *source,
+    const char *source,
     SQLUDF_TRAIL_ARGS)
 {
     switch (err_code) {
@@ -136,7 +142,7 @@ unicode_udf_replace_bad(
     unsigned char *c = source; // start of current char in source
     unsigned char *r = result; // current position in result
     unsigned char *result_end = result + UNICODE_MAX_STR_LEN;
-    uint32_t codepoint, repl_len = strlen(repl);
+    uint32_t codepoint, repl_len;
     uint8_t prev, current;
 
     // Return NULL on NULL input
@@ -144,6 +150,7 @@ unicode_udf_replace_bad(
         *result_ind = -1;
         return;
     }
+    repl_len = strlen(repl);
 
     // A little macro for checking for overflow before copying to result
 #define CHECK_AND_COPY(S, N) \
@@ -13,3 +13,8 @@
 /^CREATE +(ALIAS|TABLE|VIEW|ROLE|TRIGGER|VARIABLE) +([A-Za-z0-9_#$@]+)\>/ {
 	print "DROP " $2 " " gensub("!$$", "", 1, $3) "!";
 }
+
+# Created temporary tables have a couple of extra words before the name
+/^CREATE +GLOBAL +TEMPORARY +TABLE +([A-Za-z0-9_#$@]+)\>/ {
+	print "DROP TABLE " gensub("!$$", "", 1, $5) "!";
+}